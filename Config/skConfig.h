@@ -154,6 +154,14 @@
 #define SK_ARCH SK_ARCH_32
 #endif
 
+// Assumed size of a cache line, used to pad and size data structures.
+#define SK_CACHE_LINE 64
+
+// SSE2 is part of every x86-64 target, so it needs no runtime check.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SK_SSE2 1
+#endif
+
 #if SK_PLATFORM == SK_PLATFORM_WIN32
 #if defined(__MINGW32__) || \
     defined(__CYGWIN__) ||  \
@@ -0,0 +1,331 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <type_traits>
+#include <utility>
+#include "Benchmark.h"
+#include "Utils/skBTreeMap.h"
+#include "Utils/skBinarySearchTree.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+typedef skBTreeMap<int, int> IntMap;
+
+static void checkOrder(IntMap& map, const bool* present, int range)
+{
+    int              expected = 0;
+    SKsize           count    = 0;
+    IntMap::Iterator it       = map.iterator();
+    while (it.hasMoreElements())
+    {
+        while (expected < range && !present[expected])
+            ++expected;
+
+        REQUIRE(it.peekNextKey() == expected);
+        REQUIRE(it.peekNextValue() == expected * 3);
+        ++expected;
+        ++count;
+        it.next();
+    }
+    REQUIRE(count == map.size());
+}
+
+TEST_CASE("BTreeMap_InsertRemove")
+{
+    const int range = 20000;
+    skRandInit();
+
+    IntMap map;
+    bool*  present = new bool[range]();
+
+    REQUIRE(map.empty());
+    REQUIRE(map.get(1) == nullptr);
+    REQUIRE(!map.iterator().hasMoreElements());
+
+    SKsize size = 0;
+    for (int i = 0; i < 60000; ++i)
+    {
+        const int key = (int)skRandomUnsignedInt(range);
+        if (skRandomUnsignedInt(3) < 2)
+        {
+            REQUIRE(map.insert(key, key * 3) == !present[key]);
+            size += present[key] ? 0 : 1;
+            present[key] = true;
+        }
+        else
+        {
+            REQUIRE(map.remove(key) == present[key]);
+            size -= present[key] ? 1 : 0;
+            present[key] = false;
+        }
+        REQUIRE(map.size() == size);
+    }
+
+    checkOrder(map, present, range);
+
+    for (int i = 0; i < range; ++i)
+    {
+        REQUIRE(map.contains(i) == present[i]);
+        if (present[i])
+            REQUIRE(*map.get(i) == i * 3);
+    }
+
+    // drain completely, collapsing the tree back to nothing
+    for (int i = 0; i < range; ++i)
+        map.erase(i);
+    REQUIRE(map.empty());
+    REQUIRE(map.height() == 0);
+
+    // ascending and descending input exercise the edge nodes
+    for (int i = 0; i < range; ++i)
+        map.insert(i, i * 3);
+    for (int i = range - 1; i >= range / 2; --i)
+        map.erase(i);
+
+    for (int i = 0; i < range; ++i)
+        present[i] = i < range / 2;
+    checkOrder(map, present, range);
+
+    delete[] present;
+}
+
+TEST_CASE("BTreeMap_Bounds")
+{
+    IntMap map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i * 2, i * 6);
+
+    REQUIRE(map.lowerBound(10).peekNextKey() == 10);
+    REQUIRE(map.lowerBound(11).peekNextKey() == 12);
+    REQUIRE(map.upperBound(10).peekNextKey() == 12);
+    REQUIRE(map.lowerBound(-5).peekNextKey() == 0);
+    REQUIRE(!map.lowerBound(1999).hasMoreElements());
+    REQUIRE(!map.upperBound(1998).hasMoreElements());
+    REQUIRE(map.find(12).peekNextValue() == 36);
+    REQUIRE(!map.find(13).hasMoreElements());
+
+    int              expected = 100;
+    IntMap::Iterator it       = map.rangeIterator(99, 301);
+    while (it.hasMoreElements())
+    {
+        REQUIRE(it.peekNextKey() == expected);
+        expected += 2;
+        it.next();
+    }
+    REQUIRE(expected == 302);
+
+    REQUIRE(!map.rangeIterator(5, 5).hasMoreElements());
+    REQUIRE(!map.rangeIterator(7, 3).hasMoreElements());
+    REQUIRE(!map.rangeIterator(2001, 3000).hasMoreElements());
+
+    SKsize count = 0;
+    it           = map.rangeIterator(-10, 5000);
+    while (it.hasMoreElements())
+    {
+        ++count;
+        it.next();
+    }
+    REQUIRE(count == map.size());
+}
+
+TEST_CASE("BTreeMap_ConstIteration")
+{
+    typedef decltype(std::declval<IntMap::Iterator&>().peekNextKey()) KeyReference;
+    static_assert(std::is_const<std::remove_reference<KeyReference>::type>::value,
+                  "keys must not be writable through an iterator");
+    static_assert(std::is_const<decltype(std::declval<const IntMap&>().find(0))>::value,
+                  "a const map hands out const iterators");
+
+    IntMap map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(i, i);
+
+    // Values stay writable through a mutable map.
+    IntMap::Iterator it = map.find(40);
+    it.peekNextValue()  = 400;
+
+    const IntMap&         cmap = map;
+    IntMap::ConstIterator cit  = cmap.find(40);
+    REQUIRE(cit.peekNextKey() == 40);
+    REQUIRE(cit.peekNextValue() == 400);
+
+    SKsize                count = 0;
+    IntMap::ConstIterator all   = cmap.rangeIterator(10, 20);
+    while (all.hasMoreElements())
+    {
+        ++count;
+        all.next();
+    }
+    REQUIRE(count == 10);
+}
+
+TEST_CASE("BTreeMap_BulkLoad")
+{
+    for (SKuint32 n = 0; n < 3000; n = n * 3 + 1)
+    {
+        skArray<int> keys, values;
+        for (SKuint32 i = 0; i < n; ++i)
+        {
+            keys.push_back((int)i * 5);
+            values.push_back((int)i);
+        }
+
+        IntMap map;
+        map.insert(-1, -1);
+        map.bulkLoad(keys, values);
+        REQUIRE(map.size() == n);
+        REQUIRE(!map.contains(-1));
+
+        for (SKuint32 i = 0; i < n; ++i)
+            REQUIRE(*map.get((int)i * 5) == (int)i);
+
+        // the loaded tree must keep working under updates
+        for (SKuint32 i = 0; i < n; ++i)
+            REQUIRE(map.insert((int)i * 5 + 1, 0));
+        for (SKuint32 i = 0; i < n; ++i)
+            REQUIRE(map.remove((int)i * 5));
+        REQUIRE(map.size() == n);
+
+        IntMap copy(map);
+        REQUIRE(copy.size() == n);
+        REQUIRE((n == 0 || copy.lowerBound(0).peekNextKey() == 1));
+    }
+}
+
+TEST_CASE("BTreeMap_Strings")
+{
+    skBTreeMap<skString, int> map;
+    for (int i = 0; i < 500; ++i)
+        REQUIRE(map.insert(skString::format("key%04d", i), i));
+
+    REQUIRE(*map.get("key0042") == 42);
+
+    skBTreeMap<skString, int>::Iterator it = map.rangeIterator("key0100", "key0105");
+    for (int i = 100; i < 105; ++i)
+    {
+        REQUIRE(it.peekNextValue() == i);
+        it.next();
+    }
+    REQUIRE(!it.hasMoreElements());
+
+    skBTreeSet<int> set;
+    REQUIRE(set.insert(3));
+    REQUIRE(!set.insert(3));
+    REQUIRE(set.insert(1));
+    REQUIRE(set.iterator().peekNextKey() == 1);
+    set.erase(1);
+    REQUIRE(!set.contains(1));
+    REQUIRE(set.size() == 1);
+}
+
+BENCHMARK_CASE("BTreeMap_Lookup")
+{
+    const SKuint32 count   = 1000000;
+    const SKuint32 lookups = 1000000;
+    skRandInit();
+
+    skArray<int> keys, values, probes;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        keys.push_back((int)i * 4);
+        values.push_back((int)i);
+    }
+    for (SKuint32 i = 0; i < lookups; ++i)
+        probes.push_back((int)skRandomUnsignedInt(count * 4));
+
+    skArray<int> shuffled(keys);
+    for (SKuint32 i = count - 1; i > 0; --i)
+        skSwap(shuffled[i], shuffled[skRandomUnsignedInt(i + 1)]);
+
+    skTimer timer;
+
+    IntMap                  map;
+    skBinarySearchTree<int> tree;
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        map.insert(shuffled[i], shuffled[i] / 4);
+    benchmarkReport("skBTreeMap insert", timer.getMicroseconds(), count);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        tree.insert(shuffled[i]);
+    benchmarkReport("skBinarySearchTree insert", timer.getMicroseconds(), count);
+
+    IntMap loaded;
+    timer.reset();
+    loaded.bulkLoad(keys, values);
+    benchmarkReport("skBTreeMap bulkLoad", timer.getMicroseconds(), count);
+
+    SKuint32 foundA = 0, foundB = 0, foundC = 0;
+
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+        foundA += map.contains(probes[i]) ? 1 : 0;
+    benchmarkReport("skBTreeMap find", timer.getMicroseconds(), lookups);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+        foundB += tree.find(probes[i]) ? 1 : 0;
+    benchmarkReport("skBinarySearchTree find", timer.getMicroseconds(), lookups);
+
+    const int* data = keys.ptr();
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+    {
+        SKuint32 lo = 0, n = count;
+        while (n > 0)
+        {
+            const SKuint32 half = n >> 1;
+            if (data[lo + half] < probes[i])
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+                n = half;
+        }
+        foundC += lo < count && data[lo] == probes[i] ? 1 : 0;
+    }
+    benchmarkReport("sorted skArray binary search", timer.getMicroseconds(), lookups);
+
+    REQUIRE(foundA == foundB);
+    REQUIRE(foundA == foundC);
+
+    // range scans of 100 elements
+    SKuint64 sum = 0;
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups / 10; ++i)
+    {
+        IntMap::Iterator it = loaded.rangeIterator(probes[i], probes[i] + 400);
+        while (it.hasMoreElements())
+        {
+            sum += it.peekNextValue();
+            it.next();
+        }
+    }
+    benchmarkReport("skBTreeMap range scan (100)", timer.getMicroseconds(), lookups / 10);
+    REQUIRE(sum > 0);
+}
@@ -0,0 +1,17 @@
+#ifndef __BENCHMARK_H_
+#define __BENCHMARK_H_
+
+#include <cstdio>
+#include "Utils/skTimer.h"
+
+// Benchmarks are hidden from the default run.
+// Use: UtilsTests [benchmark] to run them.
+#define BENCHMARK_CASE(name) TEST_CASE(name, "[.][benchmark]")
+
+inline void benchmarkReport(const char* name, SKulong micro, SKuint64 ops)
+{
+    const double ns = ops > 0 ? 1000.0 * (double)micro / (double)ops : 0.0;
+    printf("%-48s %10lu us %10.2f ns/op\n", name, micro, ns);
+}
+
+#endif
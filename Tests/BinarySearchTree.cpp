@@ -23,7 +23,11 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
+#include <type_traits>
+#include <utility>
+#include "Benchmark.h"
 #include "Macro.h"
+#include "Utils/skRandom.h"
 #include "Utils/skBinarySearchTree.h"
 #include "Utils/skString.h"
 #include "catch/catch.hpp"
@@ -234,32 +238,34 @@ TEST_CASE("BinarySearchTree_case3_then_1x1")
     EXPECT_EQ(true, tree.right() == 0);
 }
 
-//                       50
+// Inserting list into the balanced tree gives
+// (r marks red nodes):
+//
+//                       34
 //                     /     \
 //                    /       \
 //                   /         \
-//                  30          70
+//                  30          50
 //                 /  \       /    \
-//                20  40     60     80
-//                    /       \     /  \
-//                   32        65  75  85
-//                     \
-//                      34
-//                        \
-//                         36
+//                20  32     40     70
+//                          /      /  \
+//                         36r    60   80
+//                                 \   /  \
+//                                 65r 75r 85r
 //
 
 TEST_CASE("BinarySearchTree_minimum_maximum")
 {
     SearchTree tree;
-    int        i = 0;
 
     int len = sizeof(list) / sizeof(int);
     populate(tree, list, len);
 
     SearchTree::NodePointerType node = tree.root(), L, R;
     EXPECT_EQ(true, node != 0);
-    EXPECT_EQ(50, node->data());
+    EXPECT_EQ(34, node->data());
+    EXPECT_EQ(20, tree.minimum()->data());
+    EXPECT_EQ(85, tree.maximum()->data());
 
     node = node->left();
     EXPECT_EQ(true, node != 0);
@@ -271,23 +277,24 @@ TEST_CASE("BinarySearchTree_minimum_maximum")
 
     R = node->right();
     EXPECT_EQ(true, R != 0);
-    EXPECT_EQ(40, R->data());
-
+    EXPECT_EQ(32, R->data());
+    EXPECT_EQ(true, R->left() == 0);
     EXPECT_EQ(true, R->right() == 0);
 
-    L = R->left();
-    EXPECT_EQ(true, L != 0);
-    EXPECT_EQ(32, L->data());
-
-    EXPECT_EQ(true, L->left() == 0);
-
-    R = tree.maximum(L->right());
-    EXPECT_EQ(true, R != 0);
-    EXPECT_EQ(36, R->data());
-
     node = tree.root();
     R    = node->right();
     EXPECT_EQ(true, R != 0);
+    EXPECT_EQ(50, R->data());
+
+    L = tree.maximum(R->left());
+    EXPECT_EQ(true, L != 0);
+    EXPECT_EQ(40, L->data());
+
+    L = tree.minimum(R->left());
+    EXPECT_EQ(36, L->data());
+    EXPECT_EQ(true, L->isRed());
+
+    R = R->right();
     EXPECT_EQ(70, R->data());
 
     L = tree.maximum(R->left());
@@ -297,3 +304,271 @@ TEST_CASE("BinarySearchTree_minimum_maximum")
     R = tree.maximum(R->right());
     EXPECT_EQ(85, R->data());
 }
+
+// Returns the black height of node, or -1 if a red-black rule is broken.
+static int validate(SearchTree::NodePointerType node)
+{
+    if (!node)
+        return 1;
+
+    SearchTree::NodePointerType L = node->left(), R = node->right();
+    if (L && (L->parent() != node || node->data() < L->data()))
+        return -1;
+    if (R && (R->parent() != node || R->data() < node->data()))
+        return -1;
+    if (node->isRed() && ((L && L->isRed()) || (R && R->isRed())))
+        return -1;
+    if (node->count() != (L ? L->count() : 0) + (R ? R->count() : 0) + 1)
+        return -1;
+
+    const int lh = validate(L), rh = validate(R);
+    if (lh < 0 || lh != rh)
+        return -1;
+    return lh + (node->isRed() ? 0 : 1);
+}
+
+static int height(SearchTree::NodePointerType node)
+{
+    if (!node)
+        return 0;
+    const int l = height(node->left()), r = height(node->right());
+    return 1 + (l > r ? l : r);
+}
+
+TEST_CASE("BinarySearchTree_balanced")
+{
+    const int  count = 4096;
+    SearchTree tree;
+
+    // sorted input used to degenerate into a list
+    for (int i = 0; i < count; ++i)
+        tree.insert(i);
+
+    EXPECT_EQ(count, (int)tree.size());
+    EXPECT_EQ(true, validate(tree.root()) > 0);
+    EXPECT_EQ(true, tree.root()->isRed() == false);
+    EXPECT_EQ(true, height(tree.root()) <= 2 * 12);
+
+    for (int i = 0; i < count; i += 2)
+        tree.erase(i);
+
+    EXPECT_EQ(count / 2, (int)tree.size());
+    EXPECT_EQ(true, validate(tree.root()) > 0);
+
+    int                  expected = 1;
+    SearchTree::Iterator it       = tree.iterator_ascending();
+    while (it.hasMoreElements())
+    {
+        EXPECT_EQ(expected, it.getNext());
+        expected += 2;
+    }
+
+    it = tree.iterator_descending();
+    EXPECT_EQ(count - 1, it.getNext());
+
+    SearchTree copy(tree);
+    tree.clear();
+    EXPECT_EQ(true, tree.root() == 0);
+    EXPECT_EQ(count / 2, (int)copy.size());
+    EXPECT_EQ(true, copy.find(count - 1));
+    EXPECT_EQ(false, copy.find(count - 2));
+    EXPECT_EQ(true, validate(copy.root()) > 0);
+}
+
+TEST_CASE("BinarySearchTree_random")
+{
+    skRandInit();
+
+    SearchTree   tree;
+    skArray<int> values;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        const int v = (int)skRandomUnsignedInt(1000);
+        tree.insert(v);
+        values.push_back(v);
+
+        if (i % 3 == 2)
+        {
+            const SKuint32 j = skRandomUnsignedInt(values.size());
+            EXPECT_EQ(true, tree.find(values[j]));
+
+            tree.erase(values[j]);
+            values.remove(j);
+        }
+    }
+
+    EXPECT_EQ(values.size(), (SKuint32)tree.size());
+    EXPECT_EQ(true, validate(tree.root()) > 0);
+
+    int counts[1000] = {};
+    for (SKuint32 i = 0; i < values.size(); ++i)
+        ++counts[values[i]];
+
+    int                  last = -1;
+    SearchTree::Iterator it   = tree.iterator_ascending();
+    while (it.hasMoreElements())
+    {
+        const int v = it.getNext();
+        EXPECT_EQ(true, last <= v);
+        --counts[v];
+        last = v;
+    }
+
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(0, counts[i]);
+}
+
+TEST_CASE("BinarySearchTree_bounds")
+{
+    SearchTree tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i * 10);
+    tree.insert(500);
+    tree.insert(500);
+
+    EXPECT_EQ(500, tree.lowerBound(495)->data());
+    EXPECT_EQ(500, tree.lowerBound(500)->data());
+    EXPECT_EQ(510, tree.upperBound(500)->data());
+    EXPECT_EQ(0, tree.lowerBound(-1)->data());
+    EXPECT_EQ(true, tree.lowerBound(991) == 0);
+    EXPECT_EQ(true, tree.upperBound(990) == 0);
+
+    // equal values sit next to each other
+    EXPECT_EQ(true, tree.lowerBound(500) != tree.upperBound(500));
+    EXPECT_EQ(3, (int)tree.rangeCount(500, 501));
+
+    typedef decltype(std::declval<SearchTree::RangeIterator&>().peekNext()) ValueReference;
+    static_assert(std::is_const<std::remove_reference<ValueReference>::type>::value,
+                  "ordered values must not be writable through an iterator");
+
+    SearchTree::RangeIterator it = tree.rangeIterator(495, 531);
+
+    int expected[] = {500, 500, 500, 510, 520, 530};
+    for (int v : expected)
+        EXPECT_EQ(v, it.getNext());
+    EXPECT_EQ(false, it.hasMoreElements());
+
+    EXPECT_EQ(false, tree.rangeIterator(20, 20).hasMoreElements());
+    EXPECT_EQ(false, tree.rangeIterator(30, 10).hasMoreElements());
+    EXPECT_EQ(false, tree.rangeIterator(991, 2000).hasMoreElements());
+
+    SKsize count = 0;
+    it           = tree.rangeIterator();
+    while (it.hasMoreElements())
+    {
+        it.next();
+        ++count;
+    }
+    EXPECT_EQ(tree.size(), count);
+}
+
+TEST_CASE("BinarySearchTree_rank_select")
+{
+    skRandInit();
+
+    SearchTree   tree;
+    skArray<int> values;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const int v = (int)skRandomUnsignedInt(500);
+        tree.insert(v);
+        values.push_back(v);
+
+        if (i % 4 == 3)
+        {
+            const SKuint32 j = skRandomUnsignedInt(values.size());
+            tree.erase(values[j]);
+            values.remove(j);
+        }
+    }
+    EXPECT_EQ(true, validate(tree.root()) > 0);
+    EXPECT_EQ(tree.size(), tree.root()->count());
+
+    int counts[501] = {};
+    for (SKuint32 i = 0; i < values.size(); ++i)
+        ++counts[values[i] + 1];
+
+    // counts[v] becomes the number of values less than v
+    for (int v = 1; v <= 500; ++v)
+        counts[v] += counts[v - 1];
+
+    for (int v = 0; v < 500; ++v)
+    {
+        EXPECT_EQ((SKsize)counts[v], tree.rank(v));
+        if (v < 499)
+            EXPECT_EQ((SKsize)(counts[v + 1] - counts[v]), tree.rangeCount(v, v + 1));
+    }
+
+    SearchTree::RangeIterator it = tree.rangeIterator();
+    for (SKsize k = 0; k < tree.size(); ++k)
+    {
+        SearchTree::NodePointerType node = tree.select(k);
+        EXPECT_EQ(true, node != 0);
+        EXPECT_EQ(it.getNext(), node->data());
+        EXPECT_EQ(true, tree.rank(node->data()) <= k);
+    }
+    EXPECT_EQ(true, tree.select(tree.size()) == 0);
+
+    // median of 0..999 inserted in sorted order
+    SearchTree sorted;
+    for (int i = 0; i < 1000; ++i)
+        sorted.insert(i);
+    EXPECT_EQ(500, sorted.select(500)->data());
+    EXPECT_EQ(990, sorted.select(990)->data());
+    EXPECT_EQ(250, (int)sorted.rangeCount(250, 500));
+}
+
+BENCHMARK_CASE("BinarySearchTree_Insert")
+{
+    const int count = 10000000;
+    skRandInit();
+
+    skArray<int> random;
+    random.resize(count);
+    for (int i = 0; i < count; ++i)
+        random[i] = (int)skRandomUnsignedInt(0x7FFFFFFF);
+
+    skTimer timer;
+    {
+        SearchTree tree;
+
+        timer.reset();
+        for (int i = 0; i < count; ++i)
+            tree.insert(i);
+        benchmarkReport("skBinarySearchTree insert sorted", timer.getMicroseconds(), count);
+
+        timer.reset();
+        int found = 0;
+        for (int i = 0; i < count; ++i)
+            found += tree.find(i) ? 1 : 0;
+        benchmarkReport("skBinarySearchTree find sorted", timer.getMicroseconds(), count);
+        REQUIRE(found == count);
+
+        timer.reset();
+        tree.clear();
+        benchmarkReport("skBinarySearchTree clear", timer.getMicroseconds(), count);
+    }
+    {
+        SearchTree tree;
+
+        timer.reset();
+        for (int i = 0; i < count; ++i)
+            tree.insert(random[i]);
+        benchmarkReport("skBinarySearchTree insert random", timer.getMicroseconds(), count);
+
+        timer.reset();
+        int found = 0;
+        for (int i = 0; i < count; ++i)
+            found += tree.find(random[i]) ? 1 : 0;
+        benchmarkReport("skBinarySearchTree find random", timer.getMicroseconds(), count);
+        REQUIRE(found == count);
+
+        timer.reset();
+        for (int i = 0; i < count; ++i)
+            tree.erase(random[i]);
+        benchmarkReport("skBinarySearchTree erase random", timer.getMicroseconds(), count);
+        REQUIRE(tree.empty());
+    }
+}
@@ -0,0 +1,322 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include "Benchmark.h"
+#include "Utils/skChar.h"
+#include "Utils/skFormat.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "Utils/skStringBuilder.h"
+#include "catch/catch.hpp"
+
+static skString toChars(double v)
+{
+    char buf[skChar::MaxFloatChars];
+    return skString(buf, skChar::toChars(buf, v));
+}
+
+static skString toChars(float v)
+{
+    char buf[skChar::MaxFloatChars];
+    return skString(buf, skChar::toChars(buf, v));
+}
+
+static double randomDouble()
+{
+    const SKuint64 bits = (SKuint64)skRandomUnsignedInt(0xFFFFFFFF) << 32 | skRandomUnsignedInt(0xFFFFFFFF);
+
+    double v;
+    memcpy(&v, &bits, sizeof v);
+    return std::isfinite(v) ? v : 1.0 / (double)(bits | 1);
+}
+
+static float randomFloat()
+{
+    const SKuint32 bits = skRandomUnsignedInt(0xFFFFFFFF);
+
+    float v;
+    memcpy(&v, &bits, sizeof v);
+    return std::isfinite(v) ? v : 1.f / (float)(bits | 1);
+}
+
+// The number of significant digits in a toChars result.
+static int significantDigits(const skString& str)
+{
+    int first = -1, last = -1, pos = 0;
+    for (SKsize i = 0; i < str.size() && str[i] != 'e'; ++i)
+    {
+        if (str[i] < '0' || str[i] > '9')
+            continue;
+        if (str[i] != '0')
+        {
+            if (first < 0)
+                first = pos;
+            last = pos;
+        }
+        ++pos;
+    }
+    return first < 0 ? 1 : last - first + 1;
+}
+
+TEST_CASE("CharFloat_ToChars")
+{
+    REQUIRE(toChars(0.0) == "0");
+    REQUIRE(toChars(-0.0) == "-0");
+    REQUIRE(toChars(1.0) == "1");
+    REQUIRE(toChars(-2.5) == "-2.5");
+    REQUIRE(toChars(0.1) == "0.1");
+    REQUIRE(toChars(0.1 + 0.2) == "0.30000000000000004");
+    REQUIRE(toChars(100.0) == "100");
+    REQUIRE(toChars(123.456) == "123.456");
+    REQUIRE(toChars(0.001) == "0.001");
+    REQUIRE(toChars(1e-5) == "1e-5");
+    REQUIRE(toChars(123456789012345.0) == "123456789012345");
+    REQUIRE(toChars(1e21) == "1e+21");
+    REQUIRE(toChars(1.5e300) == "1.5e+300");
+    REQUIRE(toChars(9007199254740993.0) == "9.007199254740992e+15");
+    REQUIRE(toChars(std::numeric_limits<double>::max()) == "1.7976931348623157e+308");
+    REQUIRE(toChars(std::numeric_limits<double>::min()) == "2.2250738585072014e-308");
+    REQUIRE(toChars(std::numeric_limits<double>::denorm_min()) == "5e-324");
+    REQUIRE(toChars(std::numeric_limits<double>::infinity()) == "inf");
+    REQUIRE(toChars(-std::numeric_limits<double>::infinity()) == "-inf");
+    REQUIRE(toChars(std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+    REQUIRE(toChars(0.1f) == "0.1");
+    REQUIRE(toChars(1.f / 3.f) == "0.33333334");
+    REQUIRE(toChars(1e10f) == "10000000000");
+    REQUIRE(toChars(std::numeric_limits<float>::max()) == "3.4028235e+38");
+    REQUIRE(toChars(std::numeric_limits<float>::denorm_min()) == "1e-45");
+
+    // Exact round trips, with no digit that could be dropped.
+    char text[32];
+    skRandInit();
+    for (int i = 0; i < 20000; ++i)
+    {
+        const double   v   = randomDouble();
+        const skString str = toChars(v);
+        REQUIRE(std::strtod(str.c_str(), nullptr) == v);
+
+        const int digits = significantDigits(str);
+        if (digits > 1)
+        {
+            snprintf(text, sizeof text, "%.*e", digits - 2, v);
+            REQUIRE(std::strtod(text, nullptr) != v);
+        }
+
+        const float    f    = randomFloat();
+        const skString fstr = toChars(f);
+        REQUIRE(std::strtof(fstr.c_str(), nullptr) == f);
+
+        const int fdigits = significantDigits(fstr);
+        if (fdigits > 1)
+        {
+            snprintf(text, sizeof text, "%.*e", fdigits - 2, (double)f);
+            REQUIRE(std::strtof(text, nullptr) != f);
+        }
+    }
+
+    skString str("junk");
+    skChar::toString(str, 0.25);
+    REQUIRE(str == "0.25");
+    REQUIRE(skChar::toString(1.1f) == "1.1");
+
+    skStringBuilder sb;
+    sb.write(0.1);
+    sb.write(' ');
+    sb.write(-1e100);
+    sb.write(' ');
+    sb.write(2.5f);
+    sb.toString(str);
+    REQUIRE(str == "0.1 -1e+100 2.5");
+
+    skString formatted;
+    skFormat(formatted, "{} {}", 0.7, 1e-10f);
+    REQUIRE(formatted == "0.7 1e-10");
+}
+
+TEST_CASE("CharFloat_Parse")
+{
+    double d;
+    float  f;
+    SKsize end;
+
+    REQUIRE(skChar::parse("1.5", 3, d) == skChar::PR_OK);
+    REQUIRE(d == 1.5);
+    REQUIRE(skChar::parse("  -.5x", 6, d, &end) == skChar::PR_OK);
+    REQUIRE(d == -0.5);
+    REQUIRE(end == 5);
+    REQUIRE(skChar::parse("1.5E3", 5, d) == skChar::PR_OK);
+    REQUIRE(d == 1500);
+    REQUIRE(skChar::parse("2e+", 3, d, &end) == skChar::PR_OK);
+    REQUIRE(d == 2);
+    REQUIRE(end == 1);
+
+    // The length bounds the parse.
+    REQUIRE(skChar::parse("1.25", 3, d, &end) == skChar::PR_OK);
+    REQUIRE(d == 1.2);
+    REQUIRE(end == 3);
+
+    REQUIRE(skChar::parse("-0", 2, d) == skChar::PR_OK);
+    REQUIRE(d == 0);
+    REQUIRE(std::signbit(d));
+    REQUIRE(skChar::parse(".e5", 3, d, &end) == skChar::PR_EMPTY);
+    REQUIRE(d == 0);
+    REQUIRE(end == 0);
+    REQUIRE(skChar::parse(nullptr, 3, d) == skChar::PR_EMPTY);
+
+    REQUIRE(skChar::parse("-Infinity", 9, d, &end) == skChar::PR_OK);
+    REQUIRE(d == -std::numeric_limits<double>::infinity());
+    REQUIRE(end == 9);
+    REQUIRE(skChar::parse("NaN", 3, d) == skChar::PR_OK);
+    REQUIRE(std::isnan(d));
+
+    // Hexadecimal floats, as strtod reads them.
+    REQUIRE(skChar::parse("0x1.8p3", 7, d, &end) == skChar::PR_OK);
+    REQUIRE(d == 12);
+    REQUIRE(end == 7);
+    REQUIRE(skChar::parse("-0X.8P-1;", 9, d, &end) == skChar::PR_OK);
+    REQUIRE(d == -0.25);
+    REQUIRE(end == 8);
+    REQUIRE(skChar::parse("0x1Fp", 5, d, &end) == skChar::PR_OK);
+    REQUIRE(d == 31);
+    REQUIRE(end == 4);
+    REQUIRE(skChar::parse("0x10p2", 4, f, &end) == skChar::PR_OK);
+    REQUIRE(f == 16);
+    REQUIRE(end == 4);
+    REQUIRE(skChar::parse("0xg", 3, d, &end) == skChar::PR_OK);
+    REQUIRE(d == 0);
+    REQUIRE(end == 1);
+    REQUIRE(skChar::parse("0x1p2000", 8, d) == skChar::PR_OVERFLOW);
+    REQUIRE(skChar::toDouble("0x1.8p3") == 12);
+    REQUIRE(skString("0x1p-2").toFloat() == 0.25f);
+
+    REQUIRE(skChar::parse("1e400", 5, d) == skChar::PR_OVERFLOW);
+    REQUIRE(d == std::numeric_limits<double>::infinity());
+    REQUIRE(skChar::parse("1e-400", 6, d) == skChar::PR_OK);
+    REQUIRE(d == 0);
+    REQUIRE(skChar::parse("4.9e-324", 8, d) == skChar::PR_OK);
+    REQUIRE(d == std::numeric_limits<double>::denorm_min());
+    REQUIRE(skChar::parse("1e39", 4, f) == skChar::PR_OVERFLOW);
+    REQUIRE(f == std::numeric_limits<float>::infinity());
+
+    // Halfway cases that need more than 19 digits to settle.
+    const char* hard[] = {
+        "9007199254740993",
+        "9007199254740993.0000000000000000001",
+        "2.4703282292062327208828439643411068618252990130716238221279284125033775364e-324",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "7.038531e-26",
+        "0.30000000000000004",
+    };
+    for (const char* str : hard)
+    {
+        REQUIRE(skChar::parse(str, strlen(str), d) == skChar::PR_OK);
+        REQUIRE(d == std::strtod(str, nullptr));
+        REQUIRE(skChar::parse(str, strlen(str), f) == skChar::PR_OK);
+        REQUIRE(f == std::strtof(str, nullptr));
+    }
+
+    // Against the C library for long, short and scaled digit strings. A
+    // single digit can round past the largest double.
+    char text[48];
+    skRandInit();
+    for (int i = 0; i < 20000; ++i)
+    {
+        const double v   = randomDouble();
+        const int    len = snprintf(text, sizeof text, "%.*g;", (int)(i % 20) + 1, v);
+        REQUIRE(skChar::parse(text, (SKsize)len, d, &end) != skChar::PR_EMPTY);
+        REQUIRE(end == (SKsize)len - 1);
+        REQUIRE(d == std::strtod(text, nullptr));
+        REQUIRE(skChar::parse(text, (SKsize)len, f) != skChar::PR_EMPTY);
+        REQUIRE(f == std::strtof(text, nullptr));
+    }
+
+    REQUIRE(skChar::toDouble("2.75") == 2.75);
+    REQUIRE(skChar::toDouble("") == 0.0);
+    REQUIRE(skChar::toFloat(skString("-3.5")) == -3.5f);
+    REQUIRE(skString("1e3").toDouble() == 1000);
+}
+
+BENCHMARK_CASE("CharFloat_Benchmark")
+{
+    const SKuint32 n = 1000000;
+
+    skRandInit();
+    skArray<double> values;
+    values.reserve(n);
+    for (SKuint32 i = 0; i < n; ++i)
+        values.push_back(randomDouble());
+
+    char     buf[32];
+    SKuint64 total = 0;
+
+    skTimer timer;
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)snprintf(buf, sizeof buf, "%.17g", values[i]);
+    benchmarkReport("format snprintf %.17g", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += skChar::toChars(buf, values[i]);
+    benchmarkReport("format toChars", timer.getMicroseconds(), n);
+
+    skStringBuilder sb(ALLOC_MUL2, 1 << 20);
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        sb.write(values[i]);
+    benchmarkReport("format skStringBuilder", timer.getMicroseconds(), n);
+
+    skStringArray text;
+    text.reserve(n);
+    for (SKuint32 i = 0; i < n; ++i)
+        text.push_back(toChars(values[i]));
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)(std::strtod(text[i].c_str(), nullptr) != 0);
+    benchmarkReport("parse strtod", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        double v;
+        skChar::parse(text[i].c_str(), text[i].size(), v);
+        total += (SKuint64)(v != 0);
+    }
+    benchmarkReport("parse skChar::parse", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)(text[i].toDouble() != 0);
+    benchmarkReport("parse skString::toDouble", timer.getMicroseconds(), n);
+
+    REQUIRE(total != 0);
+}
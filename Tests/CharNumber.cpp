@@ -0,0 +1,236 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include "Benchmark.h"
+#include "Utils/skChar.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "Utils/skStringBuilder.h"
+#include "catch/catch.hpp"
+
+static skString toChars(SKint64 v)
+{
+    char buf[skChar::MaxIntegerChars];
+    return skString(buf, skChar::toChars(buf, v));
+}
+
+static skString toChars(SKuint64 v)
+{
+    char buf[skChar::MaxIntegerChars];
+    return skString(buf, skChar::toChars(buf, v));
+}
+
+TEST_CASE("CharNumber_ToChars")
+{
+    REQUIRE(toChars((SKuint64)0) == "0");
+    REQUIRE(toChars((SKint64)-1) == "-1");
+    REQUIRE(toChars((SKuint64)18446744073709551615ULL) == "18446744073709551615");
+    REQUIRE(toChars(std::numeric_limits<SKint64>::min()) == "-9223372036854775808");
+    REQUIRE(toChars(std::numeric_limits<SKint64>::max()) == "9223372036854775807");
+
+    // Every digit count, on both sides of each power of ten.
+    char expected[32];
+    for (SKuint64 p = 1; p <= 1000000000000000000ULL; p *= 10)
+    {
+        for (SKuint64 v : {p - 1, p, p + 1, p * 9})
+        {
+            snprintf(expected, sizeof expected, "%llu", (unsigned long long)v);
+            REQUIRE(toChars(v) == expected);
+
+            snprintf(expected, sizeof expected, "%lld", -(long long)v);
+            REQUIRE(toChars(-(SKint64)v) == expected);
+        }
+    }
+
+    skRandInit();
+    for (int i = 0; i < 10000; ++i)
+    {
+        const SKint64 v = ((SKint64)skRandomUnsignedInt(0xFFFFFFFF) << 32 | skRandomUnsignedInt(0xFFFFFFFF)) >> (i % 64);
+        snprintf(expected, sizeof expected, "%lld", (long long)v);
+        REQUIRE(toChars(v) == expected);
+    }
+
+    skString str("junk");
+    skChar::toString(str, (SKint32)-123456);
+    REQUIRE(str == "-123456");
+    skChar::toString(str, (SKuint16)65535);
+    REQUIRE(str == "65535");
+
+    skStringBuilder sb;
+    sb.write((SKint32)-5);
+    sb.write(' ');
+    sb.write((SKuint64)12345678901234567890ULL);
+    sb.toString(str);
+    REQUIRE(str == "-5 12345678901234567890");
+}
+
+TEST_CASE("CharNumber_Parse")
+{
+    SKint64  v;
+    SKuint64 u;
+    SKsize   end;
+
+    REQUIRE(skChar::parse("12345", 5, v) == skChar::PR_OK);
+    REQUIRE(v == 12345);
+
+    // The length bounds the parse.
+    REQUIRE(skChar::parse("12345", 3, v, 10, &end) == skChar::PR_OK);
+    REQUIRE(v == 123);
+    REQUIRE(end == 3);
+
+    REQUIRE(skChar::parse("  -42abc", 8, v, 10, &end) == skChar::PR_OK);
+    REQUIRE(v == -42);
+    REQUIRE(end == 5);
+
+    REQUIRE(skChar::parse("abc", 3, v, 10, &end) == skChar::PR_EMPTY);
+    REQUIRE(v == 0);
+    REQUIRE(end == 0);
+    REQUIRE(skChar::parse("-", 1, v) == skChar::PR_EMPTY);
+    REQUIRE(skChar::parse(nullptr, 4, v) == skChar::PR_EMPTY);
+
+    REQUIRE(skChar::parse("0xff", 4, v, 16) == skChar::PR_OK);
+    REQUIRE(v == 255);
+    REQUIRE(skChar::parse("0x1F", 4, v, 0) == skChar::PR_OK);
+    REQUIRE(v == 31);
+    REQUIRE(skChar::parse("017", 3, v, 0) == skChar::PR_OK);
+    REQUIRE(v == 15);
+    REQUIRE(skChar::parse("0xg", 3, v, 16, &end) == skChar::PR_OK);
+    REQUIRE(v == 0);
+    REQUIRE(end == 1);
+    REQUIRE(skChar::parse("-101", 4, v, 2) == skChar::PR_OK);
+    REQUIRE(v == -5);
+    REQUIRE(skChar::parse("zz", 2, v, 36) == skChar::PR_OK);
+    REQUIRE(v == 35 * 36 + 35);
+
+    REQUIRE(skChar::parse("9223372036854775807", 19, v) == skChar::PR_OK);
+    REQUIRE(v == std::numeric_limits<SKint64>::max());
+    REQUIRE(skChar::parse("-9223372036854775808", 20, v) == skChar::PR_OK);
+    REQUIRE(v == std::numeric_limits<SKint64>::min());
+    REQUIRE(skChar::parse("9223372036854775808", 19, v) == skChar::PR_OVERFLOW);
+    REQUIRE(v == std::numeric_limits<SKint64>::max());
+    REQUIRE(skChar::parse("-99999999999999999999999", 24, v, 10, &end) == skChar::PR_OVERFLOW);
+    REQUIRE(v == std::numeric_limits<SKint64>::min());
+    REQUIRE(end == 24);
+
+    REQUIRE(skChar::parse("18446744073709551615", 20, u) == skChar::PR_OK);
+    REQUIRE(u == 18446744073709551615ULL);
+    REQUIRE(skChar::parse("18446744073709551616", 20, u) == skChar::PR_OVERFLOW);
+    REQUIRE(u == 18446744073709551615ULL);
+    REQUIRE(skChar::parse("-1", 2, u) == skChar::PR_OK);
+    REQUIRE(u == 18446744073709551615ULL);
+    REQUIRE(skChar::parse("00000000000000000000000000001", 29, u) == skChar::PR_OK);
+    REQUIRE(u == 1);
+
+    // Against strtoll, across the eight digit chunks.
+    char text[32];
+    skRandInit();
+    for (int i = 0; i < 10000; ++i)
+    {
+        const SKint64 r = ((SKint64)skRandomUnsignedInt(0xFFFFFFFF) << 32 | skRandomUnsignedInt(0xFFFFFFFF)) >> (i % 64);
+
+        const int len = snprintf(text, sizeof text, "%lld;", (long long)r);
+        REQUIRE(skChar::parse(text, (SKsize)len, v, 10, &end) == skChar::PR_OK);
+        REQUIRE(v == r);
+        REQUIRE(end == (SKsize)len - 1);
+        REQUIRE(v == std::strtoll(text, nullptr, 10));
+    }
+
+    // A digit run that stops inside a chunk.
+    REQUIRE(skChar::parse("1234567a90123456", 16, v) == skChar::PR_OK);
+    REQUIRE(v == 1234567);
+    REQUIRE(skChar::parse("12345678:0123456", 16, v) == skChar::PR_OK);
+    REQUIRE(v == 12345678);
+
+    REQUIRE(skChar::toInt32(skStringView("12345678", 4)) == 1234);
+    REQUIRE(skChar::toInt32(skStringView()) == -1);
+    REQUIRE(skChar::toBool(skStringView("yes!", 3)));
+    REQUIRE(!skChar::toBool(skStringView("yes", 2)));
+    REQUIRE(skString("-77").toInt64() == -77);
+}
+
+BENCHMARK_CASE("CharNumber_Benchmark")
+{
+    const SKuint32 n = 1000000;
+
+    skRandInit();
+    skArray<SKint64> values;
+    values.reserve(n);
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        const SKint64 r = (SKint64)skRandomUnsignedInt(0xFFFFFFFF) << 32 | skRandomUnsignedInt(0xFFFFFFFF);
+        values.push_back(r >> (i % 63));
+    }
+
+    char     buf[32];
+    SKuint64 total = 0;
+
+    skTimer timer;
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)snprintf(buf, sizeof buf, "%lld", (long long)values[i]);
+    benchmarkReport("format snprintf", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += skChar::toChars(buf, values[i]);
+    benchmarkReport("format toChars", timer.getMicroseconds(), n);
+
+    skStringBuilder sb(ALLOC_MUL2, 1 << 20);
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        sb.write(values[i]);
+    benchmarkReport("format skStringBuilder", timer.getMicroseconds(), n);
+
+    skStringArray text;
+    text.reserve(n);
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        const int len = snprintf(buf, sizeof buf, "%lld", (long long)values[i]);
+        text.push_back(skString(buf, (SKsize)len));
+    }
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)std::strtoll(text[i].c_str(), nullptr, 10);
+    benchmarkReport("parse strtoll", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        SKint64 v;
+        skChar::parse(text[i].c_str(), text[i].size(), v);
+        total += (SKuint64)v;
+    }
+    benchmarkReport("parse skChar::parse", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)text[i].toInt64();
+    benchmarkReport("parse skString::toInt64", timer.getMicroseconds(), n);
+
+    REQUIRE(total != 0);
+}
@@ -0,0 +1,250 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstring>
+#include "Benchmark.h"
+#include "Utils/skArray.h"
+#include "Utils/skChar.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+static int sign(int v)
+{
+    return v < 0 ? -1 : v > 0 ? 1 : 0;
+}
+
+static SKsize referenceFind(const char* str, SKsize len, const char* sub, SKsize subLen)
+{
+    for (SKsize i = 0; i + subLen <= len; ++i)
+    {
+        if (memcmp(str + i, sub, subLen) == 0)
+            return i;
+    }
+    return SK_NPOS;
+}
+
+static int referenceCompareNoCase(const char* a, const char* b, SKsize len)
+{
+    for (SKsize i = 0; i < len; ++i)
+    {
+        int x = (unsigned char)a[i], y = (unsigned char)b[i];
+        if (x >= 'A' && x <= 'Z')
+            x |= 0x20;
+        if (y >= 'A' && y <= 'Z')
+            y |= 0x20;
+        if (x != y)
+            return x - y;
+    }
+    return 0;
+}
+
+// Runs body once per instruction set the machine supports.
+#define FOR_EACH_SIMD_LEVEL(body)                                          \
+    for (int level = skChar::SL_SCALAR; level <= skChar::supportedSimdLevel(); ++level) \
+    {                                                                      \
+        skChar::setSimdLevel((skChar::SimdLevel)level);                   \
+        body;                                                              \
+    }                                                                      \
+    skChar::setSimdLevel(skChar::SL_AVX2)
+
+TEST_CASE("CharSimd_Length")
+{
+    // Page sized, so the strings can be put to end on a page boundary.
+    skArray<char> buffer;
+    buffer.resize(3 * 4096);
+    char* base = buffer.ptr() + (4096 - ((SKuintPtr)buffer.ptr() & 4095));
+
+    FOR_EACH_SIMD_LEVEL(
+        for (SKsize start = 0; start < 70; ++start) {
+            for (SKsize len = 0; len < 200; len += 3)
+            {
+                memset(base, 'x', 4096);
+                base[start + len] = 0;
+                REQUIRE(skChar::length(base + start) == len);
+
+                char* end = base + 4096 - len - 1;
+                end[len]  = 0;
+                REQUIRE(skChar::length(end) == len);
+            }
+        });
+
+    REQUIRE(skChar::length(nullptr) == 0);
+    REQUIRE(skChar::length("") == 0);
+}
+
+TEST_CASE("CharSimd_FindChar")
+{
+    skRandInit();
+
+    char str[300];
+    for (SKsize i = 0; i < sizeof str; ++i)
+        str[i] = (char)('a' + skRandomUnsignedInt(20));
+
+    FOR_EACH_SIMD_LEVEL(
+        for (SKsize len = 0; len < sizeof str; len += 1) {
+            for (char ch = 'a'; ch <= 'z'; ch += 3)
+            {
+                const void*  ptr      = memchr(str, ch, len);
+                const SKsize expected = ptr ? (SKsize)((const char*)ptr - str) : SK_NPOS;
+                REQUIRE(skChar::find(str, len, ch) == expected);
+            }
+        });
+
+    REQUIRE(skChar::find(nullptr, 0, 'a') == SK_NPOS);
+    REQUIRE(skChar::find("\xff", 1, '\xff') == 0);
+}
+
+TEST_CASE("CharSimd_FindString")
+{
+    skRandInit();
+
+    // A small alphabet makes partial matches common.
+    char str[400];
+    for (SKsize i = 0; i < sizeof str; ++i)
+        str[i] = (char)('a' + skRandomUnsignedInt(3));
+
+    FOR_EACH_SIMD_LEVEL(
+        for (SKsize len = 0; len < sizeof str; len += 7) {
+            for (SKsize subLen = 1; subLen < 12; ++subLen)
+            {
+                const char* sub = str + skRandomUnsignedInt(sizeof str - subLen);
+                REQUIRE(skChar::find(str, len, sub, subLen) == referenceFind(str, len, sub, subLen));
+                REQUIRE(skChar::find(str, len, "abcabcd", 7) == referenceFind(str, len, "abcabcd", 7));
+            }
+        });
+
+    REQUIRE(skChar::find("abc", 3, "", 0) == 0);
+    REQUIRE(skChar::find("abc", 3, "abcd", 4) == SK_NPOS);
+    REQUIRE(skChar::find(nullptr, 0, "a", 1) == SK_NPOS);
+}
+
+TEST_CASE("CharSimd_Compare")
+{
+    skRandInit();
+
+    char a[300], b[300];
+    for (SKsize i = 0; i < sizeof a; ++i)
+        a[i] = (char)('A' + skRandomUnsignedInt(58));
+
+    FOR_EACH_SIMD_LEVEL(
+        for (SKsize len = 0; len < sizeof a; len += 5) {
+            memcpy(b, a, sizeof a);
+            REQUIRE(skChar::compare(a, b, len) == 0);
+            REQUIRE(skChar::compareNoCase(a, b, len) == 0);
+
+            // Flip the case of every letter, then change one byte.
+            for (SKsize i = 0; i < len; ++i)
+            {
+                if ((a[i] >= 'A' && a[i] <= 'Z') || (a[i] >= 'a' && a[i] <= 'z'))
+                    b[i] = a[i] ^ 0x20;
+            }
+            REQUIRE(skChar::compareNoCase(a, b, len) == 0);
+            REQUIRE(sign(skChar::compare(a, b, len)) == sign(memcmp(a, b, len)));
+
+            if (len > 0)
+            {
+                const SKsize pos = skRandomUnsignedInt((SKuint32)len);
+                b[pos]           = (char)(0x80 | skRandomUnsignedInt(127));
+
+                REQUIRE(sign(skChar::compare(a, b, len)) == sign(memcmp(a, b, len)));
+                REQUIRE(sign(skChar::compareNoCase(a, b, len)) == sign(referenceCompareNoCase(a, b, len)));
+            }
+        });
+}
+
+TEST_CASE("CharSimd_StringMembers")
+{
+    const skString str("Hello, World");
+
+    REQUIRE(str.find('H') == 0);
+    REQUIRE(str.find('W') == 7);
+    REQUIRE(str.find('z') == skString::npos);
+    REQUIRE(str.find("World") == 7);
+    REQUIRE(str.find("World", 2) == 5);
+    REQUIRE(str.find("") == 0);
+
+    REQUIRE(str.equalsNoCase("hello, world"));
+    REQUIRE(!str.equalsNoCase("hello, worl"));
+    REQUIRE(str.compareNoCase("HELLO, WORLD!") < 0);
+    REQUIRE(skStringView("abc").compareNoCase("ABD") < 0);
+    REQUIRE(skString() == skString());
+    REQUIRE(skString("a") != skString());
+}
+
+template <typename Fn>
+static void benchmarkLevels(const char* name, SKsize iterations, SKsize bytes, Fn fn)
+{
+    static const char* Names[] = {"scalar", "sse2", "avx2"};
+
+    for (int level = skChar::SL_SCALAR; level <= skChar::supportedSimdLevel(); ++level)
+    {
+        skChar::setSimdLevel((skChar::SimdLevel)level);
+
+        SKsize  sink = 0;
+        skTimer timer;
+        for (SKsize i = 0; i < iterations; ++i)
+            sink += fn();
+        const SKulong micro = timer.getMicroseconds();
+
+        char label[64];
+        snprintf(label, sizeof label, "%s %s %zub", name, Names[level], (size_t)bytes);
+        benchmarkReport(label, micro, iterations);
+        REQUIRE(sink != 0);
+    }
+    skChar::setSimdLevel(skChar::SL_AVX2);
+}
+
+BENCHMARK_CASE("CharSimd_Benchmark")
+{
+    const SKsize sizes[] = {16, 64, 1024, 64 * 1024};
+
+    for (SKsize size : sizes)
+    {
+        // Each search runs to the end of the input, and each compare
+        // differs only in the last byte.
+        skString a;
+        a.resize(size);
+        for (SKsize i = 0; i < size; ++i)
+            a.ptr()[i] = (char)('a' + i % 23);
+        a.ptr()[size - 4] = '#';
+
+        skString b(a), upper(a);
+        b.ptr()[size - 1] = '!';
+        for (SKsize i = 0; i < size; ++i)
+            upper.ptr()[i] = (char)toupper(upper.ptr()[i]);
+        upper.ptr()[size - 1] = '!';
+
+        const char* sub = a.c_str() + size - 6;
+
+        const SKsize iterations = skMax<SKsize>(256 * 1024 * 1024 / size / 16, 1000);
+
+        benchmarkLevels("length", iterations, size, [&] { return skChar::length(a.c_str()); });
+        benchmarkLevels("find(char)", iterations, size, [&] { return skChar::find(a.c_str(), size, '#'); });
+        benchmarkLevels("find(string)", iterations, size, [&] { return skChar::find(a.c_str(), size, sub, 3); });
+        benchmarkLevels("compare", iterations, size, [&] { return (SKsize)skChar::compare(a.c_str(), b.c_str(), size); });
+        benchmarkLevels("compareNoCase", iterations, size, [&] { return (SKsize)skChar::compareNoCase(a.c_str(), upper.c_str(), size); });
+    }
+}
@@ -24,7 +24,11 @@
 -------------------------------------------------------------------------------
 */
 
+#include "Benchmark.h"
 #include "Utils/skDeque.h"
+#include "Utils/skList.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
 #include "catch/catch.hpp"
 
 #define TEST_CASE_NAME DequeTest
@@ -99,3 +103,201 @@ TEST_CASE("DequeTest_DequePushPopFront")
         REQUIRE(0 == lst.size());
     }
 }
+
+TEST_CASE("DequeTest_RandomAccess")
+{
+    IntArray lst;
+    int      i;
+    for (i = 0; i < ARR_SIZE; ++i)
+    {
+        lst.push_back(i);
+        lst.push_front(-i - 1);
+    }
+
+    REQUIRE(2 * ARR_SIZE == lst.size());
+    for (i = 0; i < 2 * ARR_SIZE; ++i)
+        REQUIRE(i - ARR_SIZE == lst[i]);
+
+    REQUIRE(-ARR_SIZE == lst.front());
+    REQUIRE(ARR_SIZE - 1 == lst.back());
+    REQUIRE(ARR_SIZE == lst.find(0));
+    REQUIRE(lst.npos == lst.find(ARR_SIZE));
+
+    IntArray::Iterator it = lst.iterator();
+    i                     = -ARR_SIZE;
+    while (it.hasMoreElements())
+        REQUIRE(i++ == it.getNext());
+
+    IntArray::ReverseIterator rit = lst.reverseIterator();
+    while (rit.hasMoreElements())
+        REQUIRE(--i == rit.getNext());
+    REQUIRE(-ARR_SIZE == i);
+}
+
+TEST_CASE("DequeTest_StableAddresses")
+{
+    IntArray lst;
+    lst.push_back(1);
+    int* first = &lst.front();
+
+    for (int i = 0; i < 10 * ARR_SIZE; ++i)
+    {
+        lst.push_back(i);
+        lst.push_front(i);
+    }
+
+    REQUIRE(first == &lst[10 * ARR_SIZE]);
+    REQUIRE(1 == *first);
+}
+
+TEST_CASE("DequeTest_MixedAgainstReference")
+{
+    IntArray     lst;
+    skArray<int> ref;  // ref[0] is the front
+    skRandInit(123);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        switch (skRandomUnsignedInt(4))
+        {
+        case 0:
+            lst.push_back(i);
+            ref.push_back(i);
+            break;
+        case 1:
+        {
+            lst.push_front(i);
+            skArray<int> tmp;
+            tmp.push_back(i);
+            for (SKuint32 j = 0; j < ref.size(); ++j)
+                tmp.push_back(ref[j]);
+            ref = tmp;
+            break;
+        }
+        case 2:
+            if (!ref.empty())
+            {
+                REQUIRE(ref.back() == lst.back());
+                lst.pop_back();
+                ref.resize(ref.size() - 1);
+            }
+            break;
+        default:
+            if (!ref.empty())
+            {
+                REQUIRE(ref.front() == lst.front());
+                lst.pop_front();
+                skArray<int> tmp;
+                for (SKuint32 j = 1; j < ref.size(); ++j)
+                    tmp.push_back(ref[j]);
+                ref = tmp;
+            }
+            break;
+        }
+
+        REQUIRE(ref.size() == lst.size());
+    }
+
+    for (SKuint32 j = 0; j < ref.size(); ++j)
+        REQUIRE(ref[j] == lst[j]);
+
+    IntArray copy(lst);
+    REQUIRE(copy.size() == lst.size());
+    for (SKuint32 j = 0; j < ref.size(); ++j)
+        REQUIRE(ref[j] == copy[j]);
+}
+
+TEST_CASE("DequeTest_Strings")
+{
+    skDeque<skString> lst;
+    for (int i = 0; i < ARR_SIZE; ++i)
+    {
+        lst.push_back("back");
+        lst.push_front("front");
+    }
+
+    REQUIRE(lst.front() == "front");
+    REQUIRE(lst.back() == "back");
+
+    // Popped slots release what they held.
+    lst.push_back("a string long enough to live on the heap");
+    lst.push_front("a string long enough to live on the heap");
+    const skString* back  = &lst.back();
+    const skString* front = &lst.front();
+    lst.pop_back();
+    lst.pop_front();
+    REQUIRE(back->empty());
+    REQUIRE(front->empty());
+
+    while (!lst.empty())
+        lst.pop_front();
+}
+
+BENCHMARK_CASE("DequeTest_AgainstList")
+{
+    const int Count = 1000000;
+
+    {
+        skList<int> lst;
+        skTimer     t;
+        for (int i = 0; i < Count; ++i)
+            lst.push_back(i);
+        for (int i = 0; i < Count; ++i)
+            lst.pop_front();
+        benchmarkReport("skList push_back/pop_front", t.getMicroseconds(), Count);
+    }
+    {
+        IntArray lst;
+        skTimer  t;
+        for (int i = 0; i < Count; ++i)
+            lst.push_back(i);
+        for (int i = 0; i < Count; ++i)
+            lst.pop_front();
+        benchmarkReport("skDeque push_back/pop_front", t.getMicroseconds(), Count);
+    }
+    {
+        skList<int> lst;
+        skTimer     t;
+        for (int i = 0; i < Count; ++i)
+        {
+            lst.push_front(i);
+            lst.push_back(i);
+            lst.pop_front();
+        }
+        benchmarkReport("skList push_front/push_back/pop_front", t.getMicroseconds(), Count);
+    }
+    {
+        IntArray lst;
+        skTimer  t;
+        for (int i = 0; i < Count; ++i)
+        {
+            lst.push_front(i);
+            lst.push_back(i);
+            lst.pop_front();
+        }
+        benchmarkReport("skDeque push_front/push_back/pop_front", t.getMicroseconds(), Count);
+    }
+    {
+        const int   Small = 5000;
+        skList<int> lst;
+        for (int i = 0; i < Small; ++i)
+            lst.push_back(i);
+
+        volatile int sink = 0;
+        skTimer      t;
+        for (int i = 0; i < Small; ++i)
+            sink = sink + lst.at((SKuint32)i);
+        benchmarkReport("skList at (5k)", t.getMicroseconds(), Small);
+    }
+    {
+        IntArray lst;
+        for (int i = 0; i < Count; ++i)
+            lst.push_back(i);
+
+        volatile int sink = 0;
+        skTimer      t;
+        for (int i = 0; i < Count; ++i)
+            sink = sink + lst[(SKuint32)i];
+        benchmarkReport("skDeque operator[] (1M)", t.getMicroseconds(), Count);
+    }
+}
@@ -0,0 +1,196 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstdio>
+#include "Benchmark.h"
+#include "Utils/skFormat.h"
+#include "Utils/skMemoryStream.h"
+#include "Utils/skString.h"
+#include "Utils/skStringBuilder.h"
+#include "catch/catch.hpp"
+
+static skString format(const char* fmt)
+{
+    skString str;
+    skFormat(str, fmt);
+    return str;
+}
+
+template <typename... Args>
+static skString format(const char* fmt, const Args&... args)
+{
+    skString str;
+    skFormat(str, fmt, args...);
+    return str;
+}
+
+TEST_CASE("Format_Basics")
+{
+    REQUIRE(format("plain text") == "plain text");
+    REQUIRE(format("{} + {} = {}", 1, 2, 3) == "1 + 2 = 3");
+    REQUIRE(format("{1} {0} {1}", "a", "b") == "b a b");
+    REQUIRE(format("{{}} {}", 'x') == "{} x");
+    REQUIRE(format("{} {}", true, false) == "true false");
+    REQUIRE(format("{}", skString("str")) == "str");
+    REQUIRE(format("{}", skStringView("view")) == "view");
+    REQUIRE(format("{}", (const char*)nullptr).empty());
+
+    // Missing arguments and broken placeholders do not throw the rest off.
+    REQUIRE(format("{} {} {}", 1) == "1  ");
+    REQUIRE(format("{", 1) == "{");
+    REQUIRE(format("a}b") == "a}b");
+
+    skString dst("keep ");
+    REQUIRE(skFormat(dst, "{}", 42) == 2);
+    REQUIRE(dst == "keep 42");
+}
+
+TEST_CASE("Format_Integers")
+{
+    REQUIRE(format("{}", 0) == "0");
+    REQUIRE(format("{}", -17) == "-17");
+    REQUIRE(format("{}", (SKint64)-9223372036854775807LL - 1) == "-9223372036854775808");
+    REQUIRE(format("{}", (SKuint64)18446744073709551615ULL) == "18446744073709551615");
+    REQUIRE(format("{}", (SKuint8)200) == "200");
+    REQUIRE(format("{}", (SKint16)-300) == "-300");
+    REQUIRE(format("{:x} {:X} {:o} {:b}", 255, 255, 8, 5) == "ff FF 10 101");
+    REQUIRE(format("{:d}", 'A') == "65");
+    REQUIRE(format("{:c}", 66) == "B");
+
+    REQUIRE(format("[{:5}]", 42) == "[   42]");
+    REQUIRE(format("[{:<5}]", 42) == "[42   ]");
+    REQUIRE(format("[{:^6}]", 42) == "[  42  ]");
+    REQUIRE(format("[{:*>5}]", 42) == "[***42]");
+    REQUIRE(format("[{:05}]", -42) == "[-0042]");
+    REQUIRE(format("[{:08x}]", 0xBEEF) == "[0000beef]");
+    REQUIRE(format("[{:1}]", 12345) == "[12345]");
+
+    char expected[32];
+    int  value = 12345;
+    snprintf(expected, sizeof expected, "%p", (void*)&value);
+    REQUIRE(format("{}", (const void*)&value) == expected);
+}
+
+TEST_CASE("Format_Floats")
+{
+    REQUIRE(format("{}", 0.5) == "0.5");
+    REQUIRE(format("{}", 1.5f) == "1.5");
+    REQUIRE(format("{:.3f}", 3.14159) == "3.142");
+    REQUIRE(format("{:.2e}", 1234.5) == "1.23e+03");
+    REQUIRE(format("[{:8.2f}]", -1.5) == "[   -1.50]");
+    REQUIRE(format("[{:08.2f}]", -1.5) == "[-0001.50]");
+    REQUIRE(format("{:f}", 1e300).size() == 308);
+}
+
+TEST_CASE("Format_Strings")
+{
+    REQUIRE(format("[{:6}]", "ab") == "[ab    ]");
+    REQUIRE(format("[{:>6}]", "ab") == "[    ab]");
+    REQUIRE(format("[{:-^7}]", "ab") == "[--ab---]");
+    REQUIRE(format("[{:.2}]", "abcdef") == "[ab]");
+
+    // Longer than the internal buffer.
+    const skString long1('a', 1000), long2('b', 300);
+    const skString result = format("<{}|{}>", long1, long2);
+    REQUIRE(result.size() == 1303);
+    REQUIRE(result.startsWith("<aaaa"));
+    REQUIRE(result.find('|') == 1001);
+    REQUIRE(result.endsWith("bbbb>"));
+
+    REQUIRE(format("{:1000}", "x").size() == 1000);
+}
+
+TEST_CASE("Format_Destinations")
+{
+    skStringBuilder sb;
+    skFormat(sb, "{}-{}", "builder", 1);
+    skFormat(sb, "/{}", 2.5);
+
+    skString str;
+    sb.toString(str);
+    REQUIRE(str == "builder-1/2.5");
+
+    skMemoryStream ms(skStream::WRITE);
+    REQUIRE(skFormat(ms, "{} {}", "stream", 7) == 8);
+    REQUIRE(ms.size() == 8);
+    REQUIRE(skStringView(ms.ptr(), ms.size()) == "stream 7");
+
+    // The printf paths.
+    REQUIRE(skString::format("%d-%s", 5, "five") == "5-five");
+    skString::format(str, "%s", skString('z', 700).c_str());
+    REQUIRE(str.size() == 700);
+    REQUIRE(ms.writef("%05d", 42) == 5);
+}
+
+BENCHMARK_CASE("Format_Benchmark")
+{
+    const SKuint32 n = 500000;
+
+    char     buffer[128];
+    SKuint64 total = 0;
+
+    skTimer timer;
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)snprintf(buffer, sizeof buffer, "id %u: %d items, %s", i, (int)i - 7, "name");
+    benchmarkReport("snprintf", timer.getMicroseconds(), n);
+
+    skString str;
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        skString::format(str, "id %u: %d items, %s", i, (int)i - 7, "name");
+        total += str.size();
+    }
+    benchmarkReport("skString::format", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        str.resize(0);
+        total += skFormat(str, "id {}: {} items, {}", i, (int)i - 7, "name");
+    }
+    benchmarkReport("skFormat skString", timer.getMicroseconds(), n);
+
+    skStringBuilder sb(ALLOC_MUL2, 4096);
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += skFormat(sb, "id {}: {} items, {}\n", i, (int)i - 7, "name");
+    benchmarkReport("skFormat skStringBuilder", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+        total += (SKuint64)snprintf(buffer, sizeof buffer, "%g %.3f", i * 0.25, i * 1.5);
+    benchmarkReport("snprintf double", timer.getMicroseconds(), n);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        str.resize(0);
+        total += skFormat(str, "{} {:.3f}", i * 0.25, i * 1.5);
+    }
+    benchmarkReport("skFormat double", timer.getMicroseconds(), n);
+
+    REQUIRE(total > 0);
+}
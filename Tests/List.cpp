@@ -147,3 +147,141 @@ TEST_CASE("List_PopBack")
 
     REQUIRE(lb.size() == 0);
 }
+
+
+struct IntrusiveItem
+{
+    int        value;
+    skListHook all;
+    skListHook odd;
+
+    explicit IntrusiveItem(int v = 0) :
+        value(v)
+    {
+    }
+};
+
+typedef skIntrusiveList<IntrusiveItem, &IntrusiveItem::all> AllList;
+typedef skIntrusiveList<IntrusiveItem, &IntrusiveItem::odd> OddList;
+
+
+TEST_CASE("List_IntrusiveMultipleLists")
+{
+    IntrusiveItem items[MaxSize];
+    AllList       all;
+    OddList       odd;
+
+    for (int i = 0; i < MaxSize; ++i)
+    {
+        items[i].value = i;
+        all.push_back(&items[i]);
+        if (i & 1)
+            odd.push_front(&items[i]);
+    }
+
+    REQUIRE(all.size() == MaxSize);
+    REQUIRE(odd.size() == MaxSize / 2);
+    REQUIRE(all.front() == &items[0]);
+    REQUIRE(odd.front() == &items[MaxSize - 1]);
+
+    int               expected = 0;
+    AllList::Iterator it       = all.iterator();
+    while (it.hasMoreElements())
+        REQUIRE(it.getNext().value == expected++);
+    REQUIRE(expected == MaxSize);
+
+    expected                   = 1;
+    OddList::ReverseIterator r = odd.reverseIterator();
+    while (r.hasMoreElements())
+    {
+        REQUIRE(r.getNext().value == expected);
+        expected += 2;
+    }
+
+    // unlink from the middle of one list leaves the other intact
+    all.erase(&items[5]);
+    REQUIRE(!items[5].all.isLinked());
+    REQUIRE(items[5].odd.isLinked());
+    REQUIRE(all.size() == MaxSize - 1);
+    REQUIRE(all.next(&items[4]) == &items[6]);
+    REQUIRE(all.prev(&items[6]) == &items[4]);
+    REQUIRE(odd.size() == MaxSize / 2);
+
+    // erasing an unlinked hook is a no-op
+    all.erase(&items[5]);
+    REQUIRE(all.size() == MaxSize - 1);
+
+    all.insert_front(&items[6], &items[5]);
+    REQUIRE(all.next(&items[4]) == &items[5]);
+    REQUIRE(all.size() == MaxSize);
+
+    REQUIRE(all.pop_front() == &items[0]);
+    REQUIRE(all.pop_back() == &items[MaxSize - 1]);
+    REQUIRE(!items[0].all.isLinked());
+    REQUIRE(all.size() == MaxSize - 2);
+
+    odd.clear();
+    for (int i = 0; i < MaxSize; ++i)
+        REQUIRE(!items[i].odd.isLinked());
+}
+
+
+TEST_CASE("List_IntrusiveSplice")
+{
+    IntrusiveItem items[MaxSize];
+    AllList       a, b;
+
+    for (int i = 0; i < MaxSize; ++i)
+    {
+        items[i].value = i;
+        if (i < MaxSize / 2)
+            a.push_back(&items[i]);
+        else
+            b.push_back(&items[i]);
+    }
+
+    a.splice(b);
+    REQUIRE(b.empty());
+    REQUIRE(b.front() == nullptr);
+    REQUIRE(a.size() == MaxSize);
+    REQUIRE(a.back() == &items[MaxSize - 1]);
+
+    int               expected = 0;
+    AllList::Iterator it       = a.iterator();
+    while (it.hasMoreElements())
+        REQUIRE(it.getNext().value == expected++);
+    REQUIRE(expected == MaxSize);
+
+    // splicing into an empty list takes the whole chain
+    b.splice(a);
+    REQUIRE(a.empty());
+    REQUIRE(b.size() == MaxSize);
+    REQUIRE(b.front() == &items[0]);
+
+    b.erase(&items[MaxSize - 1]);
+    REQUIRE(b.back() == &items[MaxSize - 2]);
+    b.clear();
+}
+
+
+TEST_CASE("List_Splice")
+{
+    skList<int> a, b;
+    for (int i = 0; i < MaxSize; ++i)
+    {
+        a.push_back(i);
+        b.push_back(MaxSize + i);
+    }
+
+    a.splice(b);
+    REQUIRE(b.size() == 0);
+    REQUIRE(a.size() == 2 * MaxSize);
+
+    int                   expected = 0;
+    skList<int>::Iterator it       = a.iterator();
+    while (it.hasMoreElements())
+        REQUIRE(it.getNext() == expected++);
+
+    b.push_back(1);
+    REQUIRE(b.size() == 1);
+}
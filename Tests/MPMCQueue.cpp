@@ -0,0 +1,294 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "Macro.h"
+#include "Utils/skMPMCQueue.h"
+#include "catch/catch.hpp"
+
+typedef skMPMCQueue<int> IntQueue;
+
+TEST_CASE("MPMCQueue_Capacity")
+{
+    IntQueue a(100);
+    EXPECT_EQ(128, a.capacity());
+    EXPECT_TRUE(a.empty());
+
+    IntQueue b(1);
+    EXPECT_EQ(2, b.capacity());
+}
+
+TEST_CASE("MPMCQueue_FullEmpty")
+{
+    IntQueue q(16);
+    int      i, v;
+
+    for (i = 0; i < 16; ++i)
+        EXPECT_TRUE(q.tryEnqueue(i));
+
+    EXPECT_FALSE(q.tryEnqueue(16));
+    EXPECT_EQ(16, q.sizeApprox());
+
+    for (i = 0; i < 16; ++i)
+    {
+        EXPECT_TRUE(q.tryDequeue(v));
+        EXPECT_EQ(i, v);
+    }
+
+    EXPECT_FALSE(q.tryDequeue(v));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_CASE("MPMCQueue_Wrap")
+{
+    IntQueue q(8);
+    int      v, n = 0, e = 0;
+
+    for (int k = 0; k < 100; ++k)
+    {
+        for (int i = 0; i < 5; ++i)
+            EXPECT_TRUE(q.tryEnqueue(n++));
+
+        for (int i = 0; i < 5; ++i)
+        {
+            EXPECT_TRUE(q.tryDequeue(v));
+            EXPECT_EQ(e++, v);
+        }
+    }
+}
+
+TEST_CASE("MPMCQueue_DequeueBulk")
+{
+    IntQueue q(32);
+    int      buf[32];
+
+    EXPECT_EQ(0, q.tryDequeueBulk(buf, 32));
+
+    for (int i = 0; i < 20; ++i)
+        q.enqueue(i);
+
+    EXPECT_EQ(8, q.tryDequeueBulk(buf, 8));
+    for (int i = 0; i < 8; ++i)
+        EXPECT_EQ(i, buf[i]);
+
+    EXPECT_EQ(12, q.dequeueBulk(buf, 32));
+    for (int i = 0; i < 12; ++i)
+        EXPECT_EQ(i + 8, buf[i]);
+
+    EXPECT_TRUE(q.empty());
+}
+
+static void runProducersConsumers(IntQueue& q,
+                                  int       producers,
+                                  int       consumers,
+                                  int       perProducer,
+                                  bool      bulk,
+                                  SKint64&  sum,
+                                  SKint64&  count)
+{
+    std::atomic<SKint64> total(0), received(0);
+
+    std::vector<std::thread> threads;
+
+    const SKint64 expected = (SKint64)producers * perProducer;
+
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.push_back(std::thread([&q, perProducer]() {
+            for (int i = 1; i <= perProducer; ++i)
+                q.enqueue(i);
+        }));
+    }
+
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.push_back(std::thread([&q, &total, &received, expected, bulk]() {
+            int     buf[64];
+            SKint64 local = 0;
+            while (received.load() < expected)
+            {
+                SKsize nr = 0;
+                if (bulk)
+                    nr = q.tryDequeueBulk(buf, 64);
+                else if (q.tryDequeue(buf[0]))
+                    nr = 1;
+
+                if (nr == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                for (SKsize i = 0; i < nr; ++i)
+                    local += buf[i];
+                received.fetch_add((SKint64)nr);
+            }
+            total.fetch_add(local);
+        }));
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    sum   = total.load();
+    count = received.load();
+}
+
+TEST_CASE("MPMCQueue_ProducersConsumers")
+{
+    const int perProducer = 10000;
+    const int producers   = 4;
+
+    const SKint64 expected = (SKint64)producers * perProducer * (perProducer + 1) / 2;
+
+    for (int k = 0; k < 2; ++k)
+    {
+        IntQueue q(64);
+        SKint64  sum, count;
+        runProducersConsumers(q, producers, 4, perProducer, k == 1, sum, count);
+
+        EXPECT_EQ((SKint64)producers * perProducer, count);
+        EXPECT_EQ(expected, sum);
+        EXPECT_TRUE(q.empty());
+    }
+}
+
+TEST_CASE("MPMCQueue_Blocking")
+{
+    IntQueue q(2);
+
+    // A consumer sleeps on the empty queue until a value arrives.
+    std::atomic<int> got(0);
+    std::thread      consumer([&q, &got]() {
+        int v;
+        q.dequeue(v);
+        got.store(v);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(0, got.load());
+    EXPECT_TRUE(q.tryEnqueue(7));
+    consumer.join();
+    EXPECT_EQ(7, got.load());
+
+    // A producer sleeps on the full queue until a value is taken.
+    EXPECT_TRUE(q.tryEnqueue(1));
+    EXPECT_TRUE(q.tryEnqueue(2));
+    std::atomic<bool> done(false);
+    std::thread       producer([&q, &done]() {
+        q.enqueue(3);
+        done.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(done.load());
+
+    int buf[2];
+    EXPECT_EQ(2, q.dequeueBulk(buf, 2));
+    producer.join();
+    EXPECT_TRUE(done.load());
+
+    int v;
+    q.dequeue(v);
+    EXPECT_EQ(3, v);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_CASE("MPMCQueue_BlockingProducersConsumers")
+{
+    const int perThread = 10000;
+    const int threads   = 4;
+
+    IntQueue                 q(16);
+    std::atomic<SKint64>     total(0);
+    std::vector<std::thread> workers;
+
+    for (int p = 0; p < threads; ++p)
+    {
+        workers.push_back(std::thread([&q]() {
+            for (int i = 1; i <= perThread; ++i)
+                q.enqueue(i);
+        }));
+    }
+
+    // Each consumer takes exactly its share, alternating single and bulk
+    // dequeues, so every one of them ends up waiting at some point.
+    for (int c = 0; c < threads; ++c)
+    {
+        workers.push_back(std::thread([&q, &total, c]() {
+            int     buf[8];
+            SKint64 local = 0;
+            int     left  = perThread;
+            while (left > 0)
+            {
+                if (c & 1)
+                {
+                    const SKsize nr = q.dequeueBulk(buf, (SKsize)skMin(left, 8));
+                    for (SKsize i = 0; i < nr; ++i)
+                        local += buf[i];
+                    left -= (int)nr;
+                }
+                else
+                {
+                    q.dequeue(buf[0]);
+                    local += buf[0];
+                    --left;
+                }
+            }
+            total.fetch_add(local);
+        }));
+    }
+
+    for (std::thread& t : workers)
+        t.join();
+
+    EXPECT_EQ((SKint64)threads * perThread * (perThread + 1) / 2, total.load());
+    EXPECT_TRUE(q.empty());
+}
+
+BENCHMARK_CASE("MPMCQueue_Contention")
+{
+    const int perThread = 200000;
+    const int counts[]  = {1, 2, 4, 8, 16, 32};
+
+    for (int bulk = 0; bulk < 2; ++bulk)
+    {
+        for (int n : counts)
+        {
+            IntQueue q(1024);
+            SKint64  sum, count;
+
+            skTimer timer;
+            runProducersConsumers(q, n, n, perThread, bulk != 0, sum, count);
+            const SKulong us = timer.getMicroseconds();
+
+            char name[64];
+            snprintf(name, 64, "skMPMCQueue %2ip x %2ic%s", n, n, bulk ? " bulk" : "");
+            benchmarkReport(name, us, (SKuint64)count);
+        }
+    }
+}
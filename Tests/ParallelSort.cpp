@@ -0,0 +1,118 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <thread>
+#include "Benchmark.h"
+#include "Utils/skParallelSort.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+typedef skParallelSortImpl<int, skLess<int> > IntParallelSort;
+
+template <typename T, typename Compare>
+static bool isSorted(const skArray<T>& arr, Compare cmp)
+{
+    for (SKuint32 i = 1; i < arr.size(); ++i)
+    {
+        if (cmp(arr[i], arr[i - 1]))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("ParallelSort_Integers")
+{
+    skRandInit();
+
+    const SKuint32 sizes[]   = {0, 1, 1000, IntParallelSort::SequentialThreshold, 300007};
+    const SKuint32 threads[] = {1, 2, 3, 4, 7};
+
+    for (SKuint32 n : sizes)
+    {
+        skArray<int> base;
+        SKint64      sum = 0;
+        for (SKuint32 i = 0; i < n; ++i)
+        {
+            base.push_back((int)skRandomUnsignedInt(n / 4 + 1));
+            sum += base[i];
+        }
+
+        for (SKuint32 t : threads)
+        {
+            skArray<int> arr(base);
+            skParallelSort(arr, skLess<int>(), t);
+
+            REQUIRE(arr.size() == n);
+            REQUIRE(isSorted(arr, skLess<int>()));
+
+            SKint64 check = 0;
+            for (SKuint32 i = 0; i < n; ++i)
+                check += arr[i];
+            REQUIRE(check == sum);
+        }
+
+        skArray<int> desc(base);
+        skParallelSort(desc, skGreater<int>(), 4);
+        REQUIRE(isSorted(desc, skGreater<int>()));
+    }
+}
+
+TEST_CASE("ParallelSort_Strings")
+{
+    skRandInit();
+
+    skArray<skString> arr;
+    for (SKuint32 i = 0; i < 100000; ++i)
+        arr.push_back(skString::format("%08x", skRandomUnsignedInt()));
+
+    skParallelSort(arr, skLess<skString>(), 4);
+    REQUIRE(isSorted(arr, skLess<skString>()));
+}
+
+BENCHMARK_CASE("ParallelSort_Scaling")
+{
+    skRandInit();
+
+    const SKuint32 n       = 20000000;
+    const SKuint32 maxCore = skMax<SKuint32>(4, std::thread::hardware_concurrency());
+
+    skArray<SKuint32> base, arr;
+    base.resize(n);
+    for (SKuint32 i = 0; i < n; ++i)
+        base[i] = skRandomUnsignedInt();
+
+    char    name[64];
+    skTimer timer;
+    for (SKuint32 t = 1; t <= maxCore; t *= 2)
+    {
+        arr = base;
+        timer.reset();
+        skParallelSort(arr, skLess<SKuint32>(), t);
+        snprintf(name, sizeof name, "skParallelSort threads=%u", t);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+        REQUIRE(isSorted(arr, skLess<SKuint32>()));
+    }
+}
@@ -0,0 +1,200 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Macro.h"
+#include "Utils/skArray.h"
+#include "Utils/skPriorityQueue.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+typedef skAllocator<int, SKuint32>      IntAllocator;
+typedef skAllocator<SKuint64, SKuint32> TimeAllocator;
+
+typedef skPriorityQueue<int>                                           MaxHeap;
+typedef skPriorityQueue<int, skGreater<int> >                          MinHeap;
+typedef skPriorityQueue<int, skGreater<int>, IntAllocator, 4>          MinHeap4;
+typedef skPriorityQueue<SKuint64, skGreater<SKuint64>, TimeAllocator>    TimerHeap2;
+typedef skPriorityQueue<SKuint64, skGreater<SKuint64>, TimeAllocator, 4> TimerHeap4;
+
+template <typename Heap>
+void checkDrainsInOrder(Heap& heap, bool ascending)
+{
+    int  prev  = 0;
+    bool first = true;
+    while (!heap.empty())
+    {
+        const int v = heap.top();
+        if (!first)
+        {
+            if (ascending)
+                EXPECT_LE(prev, v);
+            else
+                EXPECT_GE(prev, v);
+        }
+        prev  = v;
+        first = false;
+        heap.pop();
+    }
+}
+
+TEST_CASE("PriorityQueue_MaxHeap")
+{
+    MaxHeap h;
+    EXPECT_TRUE(h.empty());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        h.push((i * 7919) % 1000);
+        EXPECT_EQ(i + 1, h.size());
+    }
+
+    EXPECT_EQ(999, h.top());
+    checkDrainsInOrder(h, false);
+}
+
+TEST_CASE("PriorityQueue_MinHeap")
+{
+    MinHeap  h2;
+    MinHeap4 h4;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const int v = (i * 7919) % 1013;
+        h2.push(v);
+        h4.push(v);
+    }
+
+    EXPECT_EQ(0, h2.top());
+    EXPECT_EQ(0, h4.top());
+
+    int a, b;
+    while (h2.pop(a))
+    {
+        EXPECT_TRUE(h4.pop(b));
+        EXPECT_EQ(a, b);
+    }
+    EXPECT_TRUE(h4.empty());
+}
+
+TEST_CASE("PriorityQueue_Heapify")
+{
+    skArray<int> arr;
+    for (int i = 0; i < 500; ++i)
+        arr.push_back((i * 31) % 97);
+
+    MinHeap4 h(arr);
+    EXPECT_EQ(500, h.size());
+    EXPECT_EQ(0, h.top());
+    checkDrainsInOrder(h, true);
+
+    MaxHeap m;
+    m.push(5);
+    m.assign(arr);
+    EXPECT_EQ(500, m.size());
+    EXPECT_EQ(96, m.top());
+
+    MaxHeap c(m);
+    checkDrainsInOrder(m, false);
+    EXPECT_EQ(500, c.size());
+    checkDrainsInOrder(c, false);
+}
+
+TEST_CASE("PriorityQueue_PopReleases")
+{
+    skPriorityQueue<skString> h;
+    h.push("a string long enough to live on the heap, first");
+    h.push("a string long enough to live on the heap, second");
+    h.push("a string long enough to live on the heap, third");
+
+    // The popped top is swapped to the end, then released.
+    h.pop();
+    EXPECT_EQ(2, h.size());
+    EXPECT_TRUE(h.ptr()[2].empty());
+    EXPECT_EQ(skString("a string long enough to live on the heap, second"), h.top());
+
+    skString out;
+    EXPECT_TRUE(h.pop(out));
+    EXPECT_EQ(skString("a string long enough to live on the heap, second"), out);
+    EXPECT_TRUE(h.ptr()[1].empty());
+
+    h.pop();
+    EXPECT_TRUE(h.empty());
+    EXPECT_TRUE(h.ptr()[0].empty());
+}
+
+static int compareDescending(SKuint64 a, SKuint64 b)
+{
+    return a > b;
+}
+
+template <typename Heap>
+void benchmarkHold(const char* name, SKuint32 live, SKuint32 ops)
+{
+    skRandInit(live);
+    Heap     heap;
+    SKuint64 now = 0;
+
+    for (SKuint32 i = 0; i < live; ++i)
+        heap.push(now + skRandomUnsignedInt(100000));
+
+    // Hold model: expire the earliest deadline and schedule a new one.
+    skTimer t;
+    for (SKuint32 i = 0; i < ops; ++i)
+    {
+        now = heap.top();
+        heap.pop();
+        heap.push(now + skRandomUnsignedInt(100000));
+    }
+    benchmarkReport(name, t.getMicroseconds(), ops);
+}
+
+BENCHMARK_CASE("PriorityQueue_TimerHold")
+{
+    const SKuint32 sizes[] = {1000, 100000, 1000000};
+    for (SKuint32 live : sizes)
+    {
+        printf("live timers: %u\n", live);
+        benchmarkHold<TimerHeap2>("  binary heap hold", live, 1000000);
+        benchmarkHold<TimerHeap4>("  4-ary heap hold", live, 1000000);
+    }
+
+    // What the heap replaces: skArray plus a sort after every insert.
+    skArray<SKuint64> arr;
+    skRandInit(0);
+    for (SKuint32 i = 0; i < 1000; ++i)
+        arr.push_back(skRandomUnsignedInt(100000));
+    arr.sort(compareDescending);
+
+    skTimer t;
+    for (SKuint32 i = 0; i < 1000; ++i)
+    {
+        const SKuint64 now = arr.back();
+        arr.pop_back();
+        arr.push_back(now + skRandomUnsignedInt(100000));
+        arr.sort(compareDescending);
+    }
+    benchmarkReport("skArray + sort hold (1000 live)", t.getMicroseconds(), 1000);
+}
@@ -24,7 +24,9 @@
 -------------------------------------------------------------------------------
 */
 
+#include "Benchmark.h"
 #include "Utils/skQueue.h"
+#include "Utils/skString.h"
 #include "catch/catch.hpp"
 
 #define ARR_SIZE 20
@@ -56,3 +58,166 @@ TEST_CASE("Queue Test 1")
     }
     printf("\n");
 }
+
+TEST_CASE("Queue_PowerOfTwoCapacity")
+{
+    Queue q;
+    for (int i = 0; i < 100; ++i)
+    {
+        q.enqueue(i);
+        const SKuint32 cap = q.capacity();
+        REQUIRE(cap >= q.size());
+        REQUIRE((cap & (cap - 1)) == 0);
+    }
+
+    q.reserve(1000);
+    REQUIRE(q.capacity() == 1024);
+}
+
+TEST_CASE("Queue_WrapOrder")
+{
+    Queue q;
+    int   n = 0, e = 0;
+
+    // keep the front moving so that growth happens on a wrapped ring
+    for (int k = 0; k < 50; ++k)
+    {
+        for (int i = 0; i < 7; ++i)
+            q.enqueue(n++);
+        for (int i = 0; i < 5; ++i)
+            REQUIRE(q.dequeue() == e++);
+
+        for (SKuint32 i = 0; i < q.size(); ++i)
+            REQUIRE(q[i] == e + (int)i);
+    }
+
+    Queue::Iterator it = q.iterator();
+    int             v  = e;
+    while (it.hasMoreElements())
+        REQUIRE(it.getNext() == v++);
+    REQUIRE(v == n);
+
+    Queue::ReverseIterator rit = q.reverseIterator();
+    while (rit.hasMoreElements())
+        REQUIRE(rit.getNext() == --v);
+    REQUIRE(v == e);
+
+    Queue c(q);
+    REQUIRE(c.size() == q.size());
+    while (!c.empty())
+        REQUIRE(c.dequeue() == q.dequeue());
+}
+
+TEST_CASE("Queue_Ranges")
+{
+    Queue q;
+    int   src[100], dst[100];
+    for (int i = 0; i < 100; ++i)
+        src[i] = i;
+
+    q.enqueueRange(src, 10);
+    REQUIRE(q.dequeueRange(dst, 6) == 6);
+    for (int i = 0; i < 6; ++i)
+        REQUIRE(dst[i] == i);
+
+    // wraps around the end of the ring
+    q.enqueueRange(src + 10, 10);
+    REQUIRE(q.size() == 14);
+    REQUIRE(q.dequeueRange(dst, 100) == 14);
+    for (int i = 0; i < 14; ++i)
+        REQUIRE(dst[i] == i + 6);
+
+    REQUIRE(q.empty());
+    REQUIRE(q.dequeueRange(dst, 10) == 0);
+
+    skQueue<skString> sq;
+    skString          ss[3] = {"a", "b", "c"}, sd[3];
+    sq.enqueue("z");
+    sq.enqueueRange(ss, 3);
+    REQUIRE(sq.dequeue() == "z");
+    REQUIRE(sq.dequeueRange(sd, 3) == 3);
+    REQUIRE(sd[2] == "c");
+}
+
+// Reference ring that wraps with a modulo, as the queue did previously.
+class ModuloRing
+{
+public:
+    explicit ModuloRing(SKuint32 capacity) :
+        m_data(new int[capacity + 1]),
+        m_capacity(capacity + 1),
+        m_front(0),
+        m_back(0)
+    {
+    }
+
+    ~ModuloRing()
+    {
+        delete[] m_data;
+    }
+
+    void enqueue(int v)
+    {
+        m_data[m_back] = v;
+        m_back         = (m_back + 1) % m_capacity;
+    }
+
+    int dequeue()
+    {
+        const int v = m_data[m_front];
+        m_front     = (m_front + 1) % m_capacity;
+        return v;
+    }
+
+private:
+    int*     m_data;
+    SKuint32 m_capacity, m_front, m_back;
+};
+
+BENCHMARK_CASE("Queue_PerElement")
+{
+    const int Loops = 20000;
+    const int Batch = 512;
+
+    volatile int sink = 0;
+    int          buf[Batch];
+    for (int i = 0; i < Batch; ++i)
+        buf[i] = i;
+
+    {
+        ModuloRing ring(Batch);
+        skTimer    t;
+        for (int k = 0; k < Loops; ++k)
+        {
+            for (int i = 0; i < Batch; ++i)
+                ring.enqueue(i);
+            for (int i = 0; i < Batch; ++i)
+                sink = sink + ring.dequeue();
+        }
+        benchmarkReport("modulo ring enqueue/dequeue", t.getMicroseconds(), (SKuint64)Loops * Batch);
+    }
+    {
+        Queue q;
+        q.reserve(Batch);
+        skTimer t;
+        for (int k = 0; k < Loops; ++k)
+        {
+            for (int i = 0; i < Batch; ++i)
+                q.enqueue(i);
+            for (int i = 0; i < Batch; ++i)
+                sink = sink + q.dequeue();
+        }
+        benchmarkReport("skQueue enqueue/dequeue", t.getMicroseconds(), (SKuint64)Loops * Batch);
+    }
+    {
+        Queue q;
+        q.reserve(Batch);
+        skTimer t;
+        for (int k = 0; k < Loops; ++k)
+        {
+            q.enqueueRange(buf, Batch);
+            sink = sink + (int)q.dequeueRange(buf, Batch);
+        }
+        benchmarkReport("skQueue enqueueRange/dequeueRange", t.getMicroseconds(), (SKuint64)Loops * Batch);
+    }
+}
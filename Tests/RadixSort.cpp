@@ -0,0 +1,254 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Utils/skArray.h"
+#include "Utils/skRadixSort.h"
+#include "Utils/skRandom.h"
+#include "catch/catch.hpp"
+
+struct TimedEvent
+{
+    SKuint64 timestamp;
+    SKuint32 sequence;
+};
+
+struct TimestampKey
+{
+    SKuint64 operator()(const TimedEvent& ev) const
+    {
+        return ev.timestamp;
+    }
+};
+
+static SKuint64 random64(void)
+{
+    return (SKuint64)skRandomUnsignedInt() << 32 | skRandomUnsignedInt();
+}
+
+template <typename T>
+static bool isAscending(const skArray<T>& arr)
+{
+    for (SKuint32 i = 1; i < arr.size(); ++i)
+    {
+        if (arr[i] < arr[i - 1])
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("RadixSort_Integers")
+{
+    skRandInit();
+
+    const SKuint32 sizes[] = {0, 1, 2, 63, 64, 1000, 50000};
+    for (SKuint32 n : sizes)
+    {
+        skArray<SKuint32> u32;
+        skArray<SKuint64> u64;
+        skArray<SKint32>  s32;
+        skArray<SKint64>  s64;
+        skArray<SKuint16> u16;
+
+        for (SKuint32 i = 0; i < n; ++i)
+        {
+            u32.push_back(skRandomUnsignedInt());
+            u64.push_back(random64());
+            s32.push_back((SKint32)skRandomUnsignedInt());
+            s64.push_back((SKint64)random64());
+            u16.push_back((SKuint16)skRandomUnsignedInt());
+        }
+
+        u32.radixSort();
+        u64.radixSort();
+        s32.radixSort();
+        s64.radixSort();
+        u16.radixSort();
+
+        REQUIRE(isAscending(u32));
+        REQUIRE(isAscending(u64));
+        REQUIRE(isAscending(s32));
+        REQUIRE(isAscending(s64));
+        REQUIRE(isAscending(u16));
+    }
+
+    // keys that only differ in the low digit skip the upper passes
+    skArray<SKuint64> narrow;
+    for (SKuint32 i = 0; i < 1000; ++i)
+        narrow.push_back(0xABCD000000000000ULL | skRandomUnsignedInt(256));
+    narrow.radixSort();
+    REQUIRE(isAscending(narrow));
+}
+
+TEST_CASE("RadixSort_Floats")
+{
+    skRandInit();
+
+    skArray<float>  f;
+    skArray<double> d;
+    for (SKuint32 i = 0; i < 20000; ++i)
+    {
+        const double v = ((double)skRandomUnsignedInt() - 2147483648.0) / 1024.0;
+        f.push_back((float)v);
+        d.push_back(v);
+    }
+    f.push_back(0.f);
+    f.push_back(-0.f);
+    d.push_back(1e300);
+    d.push_back(-1e300);
+    d.push_back(-1e-300);
+
+    f.radixSort();
+    d.radixSort();
+
+    REQUIRE(isAscending(f));
+    REQUIRE(isAscending(d));
+    REQUIRE(d[0] == -1e300);
+    REQUIRE(d[d.size() - 1] == 1e300);
+
+    // raw pointers
+    float values[] = {3.5f, -2.f, 0.25f, -100.f, 7.f};
+    skRadixSort(values, 5);
+    REQUIRE(values[0] == -100.f);
+    REQUIRE(values[1] == -2.f);
+    REQUIRE(values[4] == 7.f);
+}
+
+TEST_CASE("RadixSort_StableRecords")
+{
+    skRandInit();
+
+    skArray<TimedEvent> events;
+    for (SKuint32 i = 0; i < 30000; ++i)
+    {
+        TimedEvent ev;
+        ev.timestamp = 1600000000000ULL + skRandomUnsignedInt(5000);
+        ev.sequence  = i;
+        events.push_back(ev);
+    }
+
+    events.radixSort(TimestampKey());
+
+    for (SKuint32 i = 1; i < events.size(); ++i)
+    {
+        REQUIRE(events[i - 1].timestamp <= events[i].timestamp);
+        if (events[i - 1].timestamp == events[i].timestamp)
+            REQUIRE(events[i - 1].sequence < events[i].sequence);
+    }
+
+    TimedEvent small[3] = {{5, 0}, {1, 1}, {5, 2}};
+    skRadixSort(small, 3, TimestampKey());
+    REQUIRE(small[0].sequence == 1);
+    REQUIRE(small[1].sequence == 0);
+    REQUIRE(small[2].sequence == 2);
+}
+
+static int lessU32(SKuint32 a, SKuint32 b)
+{
+    return a < b;
+}
+
+BENCHMARK_CASE("RadixSort_Benchmark")
+{
+    skRandInit();
+
+    char           name[64];
+    const SKuint32 sizes[] = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+    for (SKuint32 n : sizes)
+    {
+        // repeat small sizes so each row measures a comparable amount of work
+        const SKuint32 reps = n < 1000000 ? 1000000 / n : 1;
+
+        skArray<SKuint32> base, arr;
+        base.resize(n);
+        for (SKuint32 i = 0; i < n; ++i)
+            base[i] = skRandomUnsignedInt();
+
+        skTimer timer;
+        SKulong total = 0;
+        for (SKuint32 r = 0; r < reps; ++r)
+        {
+            arr = base;
+            timer.reset();
+            arr.sort(lessU32);
+            total += timer.getMicroseconds();
+        }
+        snprintf(name, sizeof name, "skQSort SKuint32 n=%u", n);
+        benchmarkReport(name, total, (SKuint64)n * reps);
+
+        total = 0;
+        for (SKuint32 r = 0; r < reps; ++r)
+        {
+            arr = base;
+            timer.reset();
+            arr.radixSort();
+            total += timer.getMicroseconds();
+        }
+        REQUIRE(isAscending(arr));
+        snprintf(name, sizeof name, "radixSort SKuint32 n=%u", n);
+        benchmarkReport(name, total, (SKuint64)n * reps);
+
+        if (n <= 10000000)
+        {
+            typedef skRadixIdentity<SKuint64>              Identity;
+            typedef skRadixSortImpl<SKuint64, Identity, 8> ByteRadix;
+
+            skArray<SKuint64> wide;
+            wide.resize(n);
+            SKuint64* scratch = new SKuint64[n];
+            Identity  identity;
+
+            total = 0;
+            for (SKuint32 r = 0; r < reps; ++r)
+            {
+                for (SKuint32 i = 0; i < n; ++i)
+                    wide[i] = (SKuint64)base[i] * 2654435761ULL;
+
+                timer.reset();
+                ByteRadix::sort(wide.ptr(), n, scratch, identity);
+                total += timer.getMicroseconds();
+            }
+            snprintf(name, sizeof name, "radix 8-bit SKuint64 n=%u", n);
+            benchmarkReport(name, total, (SKuint64)n * reps);
+
+            total = 0;
+            for (SKuint32 r = 0; r < reps; ++r)
+            {
+                for (SKuint32 i = 0; i < n; ++i)
+                    wide[i] = (SKuint64)base[i] * 2654435761ULL;
+
+                timer.reset();
+                skRadixSort(wide.ptr(), n, scratch, identity);
+                total += timer.getMicroseconds();
+            }
+            REQUIRE(isAscending(wide));
+            snprintf(name, sizeof name, "radix 11-bit SKuint64 n=%u", n);
+            benchmarkReport(name, total, (SKuint64)n * reps);
+
+            delete[] scratch;
+        }
+    }
+}
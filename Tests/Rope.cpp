@@ -0,0 +1,251 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cmath>
+#include <string>
+#include "Benchmark.h"
+#include "Utils/skMemoryStream.h"
+#include "Utils/skRandom.h"
+#include "Utils/skRope.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+static bool sameText(const skRope& rope, const std::string& expected)
+{
+    if (rope.size() != expected.size())
+        return false;
+    const skString flat = rope.toString();
+    return expected.empty() ? flat.empty() : memcmp(flat.c_str(), expected.data(), expected.size()) == 0;
+}
+
+// An AVL tree over n leaves is at most about 1.44 log2(n) high.
+static bool isBalanced(const skRope& rope)
+{
+    const double leaves = (double)rope.size() / (skRope::LeafSize / 4) + 2;
+    return rope.depth() <= (SKuint32)(1.45 * std::log2(leaves)) + 2;
+}
+
+TEST_CASE("Rope_Basics")
+{
+    skRope rope("Hello");
+    rope.append(", World");
+    REQUIRE(rope.size() == 12);
+    REQUIRE(rope[0] == 'H');
+    REQUIRE(rope.at(7) == 'W');
+    REQUIRE(rope.toString() == "Hello, World");
+
+    rope.insert(5, " there");
+    REQUIRE(rope.toString() == "Hello there, World");
+
+    rope.erase(0, 6);
+    REQUIRE(rope.toString() == "there, World");
+
+    rope.erase(5);
+    REQUIRE(rope.toString() == "there");
+
+    const skRope sub = rope.substr(1, 3);
+    REQUIRE(sub.toString() == "her");
+    REQUIRE(rope.substr(10).empty());
+
+    rope.clear();
+    REQUIRE(rope.empty());
+    REQUIRE(rope.size() == 0);
+    REQUIRE(rope.toString().empty());
+    REQUIRE(!rope.iterator().hasMoreElements());
+}
+
+TEST_CASE("Rope_LargeText")
+{
+    std::string text;
+    for (int i = 0; i < 10000; ++i)
+        text += "line " + std::to_string(i) + "\n";
+
+    const skRope rope(skStringView(text.data(), text.size()));
+    REQUIRE(sameText(rope, text));
+    REQUIRE(isBalanced(rope));
+
+    // Every chunk but the last is a full leaf.
+    SKsize           chunks = 0;
+    skRope::Iterator it     = rope.iterator();
+    while (it.hasMoreElements())
+    {
+        const skStringView chunk = it.getNext();
+        if (it.hasMoreElements())
+            REQUIRE(chunk.size() == skRope::LeafSize);
+        ++chunks;
+    }
+    REQUIRE(chunks == (text.size() + skRope::LeafSize - 1) / skRope::LeafSize);
+
+    for (SKsize i = 0; i < text.size(); i += 97)
+        REQUIRE(rope.at(i) == text[i]);
+
+    skMemoryStream stream(skStream::WRITE);
+    REQUIRE(rope.write(stream) == text.size());
+    REQUIRE(stream.size() == text.size());
+    REQUIRE(memcmp(stream.ptr(), text.data(), text.size()) == 0);
+}
+
+TEST_CASE("Rope_RandomEdits")
+{
+    skRandInit();
+
+    skRope      rope;
+    std::string expected;
+
+    for (int step = 0; step < 3000; ++step)
+    {
+        const SKuint32 op  = skRandomUnsignedInt(10);
+        const SKsize   pos = expected.empty() ? 0 : skRandomUnsignedInt((SKuint32)expected.size() + 1);
+
+        if (op < 5)
+        {
+            std::string piece(1 + skRandomUnsignedInt(op == 0 ? 3000 : 40), (char)('a' + step % 26));
+            rope.insert(pos, skStringView(piece.data(), piece.size()));
+            expected.insert(pos, piece);
+        }
+        else if (op < 8)
+        {
+            const SKsize nr = skRandomUnsignedInt(200);
+            rope.erase(pos, nr);
+            if (pos < expected.size())
+                expected.erase(pos, nr);
+        }
+        else if (op < 9)
+        {
+            const SKsize nr = skRandomUnsignedInt(500);
+            rope.append(rope.substr(pos, nr));
+            if (pos < expected.size())
+                expected += expected.substr(pos, nr);
+        }
+        else
+        {
+            rope.append("x");
+            expected += "x";
+        }
+
+        REQUIRE(rope.size() == expected.size());
+        if (step % 100 == 0)
+        {
+            REQUIRE(sameText(rope, expected));
+            REQUIRE(isBalanced(rope));
+        }
+    }
+    REQUIRE(sameText(rope, expected));
+}
+
+TEST_CASE("Rope_SharedNodes")
+{
+    skRope a("The quick brown fox");
+    skRope b(a);
+
+    a.insert(4, "very ");
+    a.append(" jumps");
+    REQUIRE(a.toString() == "The very quick brown fox jumps");
+    REQUIRE(b.toString() == "The quick brown fox");
+
+    skRope c = a.substr(4, 10);
+    b.erase(0, 4);
+    REQUIRE(c.toString() == "very quick");
+    REQUIRE(a.toString() == "The very quick brown fox jumps");
+
+    // Inserting a rope into itself.
+    c.insert(5, c);
+    REQUIRE(c.toString() == "very very quickquick");
+
+    c.append(c);
+    REQUIRE(c.size() == 40);
+}
+
+BENCHMARK_CASE("Rope_Benchmark")
+{
+    skRandInit();
+
+    const SKsize docSize = 8 * 1024 * 1024;
+    const int    edits   = 400;
+
+    std::string base;
+    while (base.size() < docSize)
+        base += "The quick brown fox jumps over the lazy dog. ";
+
+    // Random small edits in a large document.
+    skRope  rope(skStringView(base.data(), base.size()));
+    skTimer timer;
+    for (int i = 0; i < edits; ++i)
+    {
+        const SKsize pos = skRandomUnsignedInt((SKuint32)rope.size());
+        if (i & 1)
+            rope.erase(pos, 8);
+        else
+            rope.insert(pos, "inserted");
+    }
+    benchmarkReport("skRope insert/erase 8MB", timer.getMicroseconds(), edits);
+
+    skRandInit();
+    skString str(base.data(), base.size());
+    timer.reset();
+    for (int i = 0; i < edits; ++i)
+    {
+        const SKsize pos = skRandomUnsignedInt((SKuint32)str.size());
+        if (i & 1)
+            str.erase(pos, 8);
+        else
+        {
+            // skString has no insert; grow and shift the tail by hand.
+            const SKsize len = str.size();
+            str.resize(len + 8);
+            memmove(str.ptr() + pos + 8, str.ptr() + pos, len - pos);
+            memcpy(str.ptr() + pos, "inserted", 8);
+        }
+    }
+    benchmarkReport("skString insert/erase 8MB", timer.getMicroseconds(), edits);
+    REQUIRE(rope.size() == str.size());
+
+    // Assembling a document from small pieces, then flattening it.
+    // skString::append grows to the exact size, so keep this modest.
+    const int pieces = 20000;
+
+    timer.reset();
+    skRope assembled;
+    for (int i = 0; i < pieces; ++i)
+        assembled.append("a short piece ");
+    skString flat;
+    assembled.toString(flat);
+    benchmarkReport("skRope append + flatten", timer.getMicroseconds(), pieces);
+
+    timer.reset();
+    skString appended;
+    for (int i = 0; i < pieces; ++i)
+        appended.append("a short piece ");
+    benchmarkReport("skString append", timer.getMicroseconds(), pieces);
+    REQUIRE(flat == appended);
+
+    // Joining large documents.
+    timer.reset();
+    skRope joined;
+    for (int i = 0; i < 1000; ++i)
+        joined.append(rope);
+    benchmarkReport("skRope append(rope) 8MB", timer.getMicroseconds(), 1000);
+    REQUIRE(joined.size() == 1000 * rope.size());
+}
@@ -0,0 +1,425 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <algorithm>
+#include "Benchmark.h"
+#include "Utils/skArray.h"
+#include "Utils/skFixedArray.h"
+#include "Utils/skList.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+enum SortPattern
+{
+    SP_RANDOM,
+    SP_SORTED,
+    SP_REVERSED,
+    SP_EQUAL,
+    SP_FEW_UNIQUE,
+    SP_ORGAN_PIPE,
+    SP_SAWTOOTH,
+    SP_MAX,
+};
+
+static const char* PatternNames[SP_MAX] = {
+    "random",
+    "sorted",
+    "reversed",
+    "all equal",
+    "few unique",
+    "organ pipe",
+    "sawtooth",
+};
+
+static void fillPattern(skArray<int>& arr, SKuint32 n, int pattern)
+{
+    arr.resize(n);
+    for (SKuint32 i = 0; i < n; ++i)
+    {
+        switch (pattern)
+        {
+        case SP_RANDOM:
+            arr[i] = (int)skRandomUnsignedInt();
+            break;
+        case SP_SORTED:
+            arr[i] = (int)i;
+            break;
+        case SP_REVERSED:
+            arr[i] = (int)(n - i);
+            break;
+        case SP_EQUAL:
+            arr[i] = 7;
+            break;
+        case SP_FEW_UNIQUE:
+            arr[i] = (int)skRandomUnsignedInt(8);
+            break;
+        case SP_ORGAN_PIPE:
+            arr[i] = (int)(i < n / 2 ? i : n - i);
+            break;
+        default:
+            arr[i] = (int)(i % 97);
+            break;
+        }
+    }
+}
+
+template <typename T, typename Compare>
+static bool isSorted(const T* base, SKsize n, Compare cmp)
+{
+    for (SKsize i = 1; i < n; ++i)
+    {
+        if (cmp(base[i], base[i - 1]))
+            return false;
+    }
+    return true;
+}
+
+static int intLess(int a, int b)
+{
+    return a < b;
+}
+
+static int intGreater(int a, int b)
+{
+    return a > b;
+}
+
+TEST_CASE("Sort_Patterns")
+{
+    skRandInit();
+
+    const SKuint32 sizes[] = {0, 1, 2, 3, 17, 24, 25, 129, 1000, 10007};
+    for (SKuint32 n : sizes)
+    {
+        for (int p = 0; p < SP_MAX; ++p)
+        {
+            skArray<int> arr;
+            fillPattern(arr, n, p);
+
+            SKint64 sum = 0;
+            for (SKuint32 i = 0; i < n; ++i)
+                sum += arr[i];
+
+            arr.sort(intLess);
+            REQUIRE(isSorted(arr.ptr(), n, skLess<int>()));
+
+            for (SKuint32 i = 0; i < n; ++i)
+                sum -= arr[i];
+            REQUIRE(sum == 0);
+
+            arr.sort(intGreater);
+            REQUIRE(isSorted(arr.ptr(), n, skGreater<int>()));
+
+            arr.sort(skLess<int>());
+            REQUIRE(isSorted(arr.ptr(), n, skLess<int>()));
+        }
+    }
+}
+
+TEST_CASE("Sort_Fallbacks")
+{
+    skRandInit();
+
+    skArray<double> arr;
+    for (int i = 0; i < 5000; ++i)
+        arr.push_back((double)skRandomUnsignedInt(1000) / 7.0);
+
+    skArray<double> copy(arr);
+    skHeapSort(arr.ptr(), arr.ptr() + arr.size(), skLess<double>());
+    REQUIRE(isSorted(arr.ptr(), arr.size(), skLess<double>()));
+
+    skInsertionSort(copy.ptr(), copy.ptr() + 500, skGreater<double>());
+    REQUIRE(isSorted(copy.ptr(), 500, skGreater<double>()));
+
+    skIntroSort(copy.ptr(), copy.ptr() + copy.size());
+    for (SKuint32 i = 0; i < arr.size(); ++i)
+        REQUIRE(arr[i] == copy[i]);
+}
+
+TEST_CASE("Sort_Containers")
+{
+    skRandInit();
+
+    skArray<skString> strings;
+    for (int i = 0; i < 2000; ++i)
+        strings.push_back(skString::format("%u", skRandomUnsignedInt(500)));
+
+    strings.sort([](const skString& a, const skString& b) { return a < b; });
+    REQUIRE(isSorted(strings.ptr(), strings.size(), skLess<skString>()));
+
+    skList<int> list;
+    for (int i = 0; i < 1000; ++i)
+        list.push_back((int)skRandomUnsignedInt(100));
+
+    list.sort(intLess);
+
+    int                   last = -1;
+    skList<int>::Iterator it   = list.iterator();
+    while (it.hasMoreElements())
+    {
+        const int v = it.getNext();
+        REQUIRE(last <= v);
+        last = v;
+    }
+    REQUIRE(list.size() == 1000);
+
+    skFixedArray<int, 64> fixed;
+    for (int i = 0; i < 64; ++i)
+        fixed.push_back(64 - i);
+    fixed.sort(skLess<int>());
+    REQUIRE(isSorted(fixed.ptr(), fixed.size(), skLess<int>()));
+}
+
+struct SortRecord
+{
+    int      key;
+    SKuint32 order;
+};
+
+static bool recordKeyLess(const SortRecord& a, const SortRecord& b)
+{
+    return a.key < b.key;
+}
+
+TEST_CASE("Sort_Stable")
+{
+    skRandInit();
+
+    const SKuint32 sizes[] = {0, 1, 2, 31, 32, 33, 100, 1000, 10007};
+    for (SKuint32 n : sizes)
+    {
+        for (int p = 0; p < SP_MAX; ++p)
+        {
+            skArray<int> keys;
+            fillPattern(keys, n, p);
+
+            skArray<SortRecord> arr;
+            for (SKuint32 i = 0; i < n; ++i)
+                arr.push_back({keys[i] % 16, i});
+
+            arr.stableSort(recordKeyLess);
+            for (SKuint32 i = 1; i < n; ++i)
+            {
+                REQUIRE(arr[i - 1].key <= arr[i].key);
+                if (arr[i - 1].key == arr[i].key)
+                    REQUIRE(arr[i - 1].order < arr[i].order);
+            }
+
+            keys.stableSort(intGreater);
+            REQUIRE(isSorted(keys.ptr(), n, skGreater<int>()));
+        }
+    }
+
+    skFixedArray<SortRecord, 64> fixed;
+    for (SKuint32 i = 0; i < 64; ++i)
+        fixed.push_back({(int)(i % 3), i});
+
+    fixed.stableSort(recordKeyLess);
+    for (SKuint16 i = 1; i < 64; ++i)
+    {
+        REQUIRE(fixed[i - 1].key <= fixed[i].key);
+        if (fixed[i - 1].key == fixed[i].key)
+            REQUIRE(fixed[i - 1].order < fixed[i].order);
+    }
+}
+
+TEST_CASE("Sort_PartialSort")
+{
+    skRandInit();
+
+    const SKuint32 sizes[] = {1, 2, 25, 129, 1000, 10007};
+    for (SKuint32 n : sizes)
+    {
+        for (int p = 0; p < SP_MAX; ++p)
+        {
+            skArray<int> base;
+            fillPattern(base, n, p);
+
+            skArray<int> expected(base);
+            expected.sort(skLess<int>());
+
+            const SKuint32 ks[] = {0, 1, 10, n / 2, n - 1, n, n + 5};
+            for (SKuint32 k : ks)
+            {
+                skArray<int> arr(base);
+                arr.partialSort(k);
+
+                const SKuint32 m = skMin(k, n);
+                for (SKuint32 i = 0; i < m; ++i)
+                    REQUIRE(arr[i] == expected[i]);
+                for (SKuint32 i = m; i < n && m > 0; ++i)
+                    REQUIRE(arr[m - 1] <= arr[i]);
+            }
+        }
+    }
+
+    skFixedArray<int, 100> fixed;
+    for (int i = 0; i < 100; ++i)
+        fixed.push_back(i * 37 % 100);
+
+    fixed.partialSort(5, intGreater);
+    for (int i = 0; i < 5; ++i)
+        REQUIRE(fixed[i] == 99 - i);
+}
+
+TEST_CASE("Sort_NthElement")
+{
+    skRandInit();
+
+    const SKuint32 sizes[] = {1, 2, 25, 129, 1000, 10007};
+    for (SKuint32 n : sizes)
+    {
+        for (int p = 0; p < SP_MAX; ++p)
+        {
+            skArray<int> base;
+            fillPattern(base, n, p);
+
+            skArray<int> expected(base);
+            expected.sort(skLess<int>());
+
+            const SKuint32 ks[] = {0, 1, n / 4, n / 2, n - 1};
+            for (SKuint32 k : ks)
+            {
+                if (k >= n)
+                    continue;
+
+                skArray<int> arr(base);
+                arr.nthElement(k, intLess);
+
+                REQUIRE(arr[k] == expected[k]);
+                for (SKuint32 i = 0; i < k; ++i)
+                    REQUIRE(arr[i] <= arr[k]);
+                for (SKuint32 i = k + 1; i < n; ++i)
+                    REQUIRE(arr[k] <= arr[i]);
+            }
+        }
+    }
+
+    skArray<skString> strings;
+    for (int i = 0; i < 500; ++i)
+        strings.push_back(skString::format("%03d", (i * 211) % 500));
+
+    strings.nthElement(250);
+    REQUIRE(strings[250] == "250");
+
+    skFixedArray<int, 9> fixed;
+    for (int i = 0; i < 9; ++i)
+        fixed.push_back(8 - i);
+    fixed.nthElement(4);
+    REQUIRE(fixed[4] == 4);
+
+    // Out of range positions leave the array alone.
+    fixed.nthElement(9);
+    REQUIRE(fixed.size() == 9);
+}
+
+BENCHMARK_CASE("Sort_Patterns_Benchmark")
+{
+    skRandInit();
+
+    const SKuint32 n = 1000000;
+    char           name[64];
+
+    for (int p = 0; p < SP_MAX; ++p)
+    {
+        skArray<int> base, arr;
+        fillPattern(base, n, p);
+
+        skTimer timer;
+
+        arr = base;
+        timer.reset();
+        arr.sort(intLess);
+        snprintf(name, sizeof name, "skArray::sort(fn) %s", PatternNames[p]);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+
+        arr = base;
+        timer.reset();
+        arr.sort(skLess<int>());
+        snprintf(name, sizeof name, "skArray::sort(skLess) %s", PatternNames[p]);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+
+        arr = base;
+        timer.reset();
+        std::sort(arr.ptr(), arr.ptr() + n);
+        snprintf(name, sizeof name, "std::sort %s", PatternNames[p]);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+    }
+}
+
+BENCHMARK_CASE("Sort_Selection_Benchmark")
+{
+    skRandInit();
+
+    const SKuint32 n = 1000000;
+    char           name[64];
+
+    skArray<int> base, arr;
+    fillPattern(base, n, SP_RANDOM);
+
+    skTimer timer;
+
+    arr = base;
+    timer.reset();
+    arr.sort(skLess<int>());
+    benchmarkReport("skArray::sort", timer.getMicroseconds(), n);
+
+    arr = base;
+    timer.reset();
+    arr.stableSort();
+    benchmarkReport("skArray::stableSort", timer.getMicroseconds(), n);
+
+    arr = base;
+    timer.reset();
+    std::stable_sort(arr.ptr(), arr.ptr() + n);
+    benchmarkReport("std::stable_sort", timer.getMicroseconds(), n);
+
+    const SKuint32 ks[] = {10, 100, 1000, 10000};
+    for (SKuint32 k : ks)
+    {
+        arr = base;
+        timer.reset();
+        arr.partialSort(k);
+        snprintf(name, sizeof name, "skArray::partialSort k=%u", k);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+
+        arr = base;
+        timer.reset();
+        std::partial_sort(arr.ptr(), arr.ptr() + k, arr.ptr() + n);
+        snprintf(name, sizeof name, "std::partial_sort k=%u", k);
+        benchmarkReport(name, timer.getMicroseconds(), n);
+    }
+
+    arr = base;
+    timer.reset();
+    arr.nthElement(n / 2);
+    benchmarkReport("skArray::nthElement median", timer.getMicroseconds(), n);
+
+    arr = base;
+    timer.reset();
+    std::nth_element(arr.ptr(), arr.ptr() + n / 2, arr.ptr() + n);
+    benchmarkReport("std::nth_element median", timer.getMicroseconds(), n);
+}
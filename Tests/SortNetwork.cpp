@@ -0,0 +1,185 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Utils/skArray.h"
+#include "Utils/skFixedArray.h"
+#include "Utils/skRandom.h"
+#include "Utils/skSortNetwork.h"
+#include "Utils/skString.h"
+#include "catch/catch.hpp"
+
+template <typename T, typename Compare>
+static bool isSorted(const T* base, SKsize n, Compare cmp)
+{
+    for (SKsize i = 1; i < n; ++i)
+    {
+        if (cmp(base[i], base[i - 1]))
+            return false;
+    }
+    return true;
+}
+
+static int intLess(int a, int b)
+{
+    return a < b;
+}
+
+TEST_CASE("SortNetwork_ZeroOne")
+{
+    // A network sorts every input once it sorts every sequence of
+    // zeros and ones.
+    for (SKuint32 n = 2; n <= 16; ++n)
+    {
+        int data[16];
+        for (SKuint32 bits = 0; bits < (1u << n); ++bits)
+        {
+            for (SKuint32 i = 0; i < n; ++i)
+                data[i] = (bits >> i) & 1;
+
+            skSortNetwork<16>(data, n, skLess<int>());
+            REQUIRE(isSorted(data, n, skLess<int>()));
+        }
+    }
+}
+
+TEST_CASE("SortNetwork_Random")
+{
+    skRandInit();
+
+    for (SKuint32 n = 0; n <= skSortNetworkLimit; ++n)
+    {
+        for (int trial = 0; trial < 200; ++trial)
+        {
+            int    ints[skSortNetworkLimit];
+            double reals[skSortNetworkLimit];
+
+            SKint64 sum = 0;
+            for (SKuint32 i = 0; i < n; ++i)
+            {
+                ints[i]  = (int)skRandomUnsignedInt();
+                reals[i] = (double)skRandomUnsignedInt(1000) / 8.0;
+                sum += ints[i];
+            }
+
+            skSortNetwork<skSortNetworkLimit>(ints, n, skLess<int>());
+            REQUIRE(isSorted(ints, n, skLess<int>()));
+
+            for (SKuint32 i = 0; i < n; ++i)
+                sum -= ints[i];
+            REQUIRE(sum == 0);
+
+            skSortNetwork<skSortNetworkLimit>(reals, n, skGreater<double>());
+            REQUIRE(isSorted(reals, n, skGreater<double>()));
+        }
+    }
+
+    skString strings[20];
+    for (int i = 0; i < 20; ++i)
+        strings[i] = skString::format("%u", skRandomUnsignedInt(100));
+
+    skSortNetwork<20>(strings, 20, skLess<skString>());
+    REQUIRE(isSorted(strings, 20, skLess<skString>()));
+}
+
+TEST_CASE("SortNetwork_FixedArray")
+{
+    skRandInit();
+
+    for (int n = 0; n <= 32; ++n)
+    {
+        skFixedArray<int, 32> fixed;
+        for (int i = 0; i < n; ++i)
+            fixed.push_back((int)skRandomUnsignedInt(50));
+
+        fixed.sort(intLess);
+        REQUIRE(isSorted(fixed.ptr(), fixed.size(), skLess<int>()));
+
+        fixed.sort(skGreater<int>());
+        REQUIRE(isSorted(fixed.ptr(), fixed.size(), skGreater<int>()));
+    }
+
+    // Above the network limit the array falls back to skIntroSort.
+    skFixedArray<int, 100> large;
+    for (int i = 0; i < 100; ++i)
+        large.push_back(100 - i);
+
+    large.sort(skLess<int>());
+    REQUIRE(isSorted(large.ptr(), large.size(), skLess<int>()));
+}
+
+template <SKuint16 L>
+static void benchmarkNetwork(void)
+{
+    typedef skFixedArray<int, L> Fixed;
+
+    const SKuint32 count = 2000000 / L;
+    char           name[64];
+
+    skArray<Fixed> base, arr;
+    base.resize(count);
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        for (SKuint16 j = 0; j < L; ++j)
+            base[i].push_back((int)skRandomUnsignedInt());
+    }
+
+    skTimer timer;
+
+    arr = base;
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        arr[i].sort(skLess<int>());
+    snprintf(name, sizeof name, "network L=%u", (unsigned)L);
+    benchmarkReport(name, timer.getMicroseconds(), count);
+
+    arr = base;
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        skIntroSort(arr[i].ptr(), arr[i].ptr() + L, skLess<int>());
+    snprintf(name, sizeof name, "skIntroSort L=%u", (unsigned)L);
+    benchmarkReport(name, timer.getMicroseconds(), count);
+
+    arr = base;
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        skIntroSort(arr[i].ptr(), arr[i].ptr() + L, skFunctionCompare<int>(intLess));
+    snprintf(name, sizeof name, "skIntroSort(fn) L=%u", (unsigned)L);
+    benchmarkReport(name, timer.getMicroseconds(), count);
+}
+
+BENCHMARK_CASE("SortNetwork_Benchmark")
+{
+    skRandInit();
+
+    benchmarkNetwork<4>();
+    benchmarkNetwork<8>();
+    benchmarkNetwork<12>();
+    benchmarkNetwork<16>();
+    benchmarkNetwork<20>();
+    benchmarkNetwork<24>();
+    benchmarkNetwork<28>();
+    benchmarkNetwork<32>();
+}
@@ -23,8 +23,14 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
+#include <atomic>
+#include <cstdlib>
 #include <limits>
+#include <new>
+#include "Benchmark.h"
 #include "Macro.h"
+#include "Utils/skMap.h"
+#include "Utils/skRandom.h"
 #include "Utils/skString.h"
 #include "Utils/skStringBuilder.h"
 #include "catch/catch.hpp"
@@ -34,16 +40,16 @@ TEST_FUNCTION(StringTest, BasicString)
     // const char* assignment
     skString a = "Hello World";
     EXPECT_EQ(11, a.size());
-    EXPECT_EQ(12, a.capacity());
+    EXPECT_EQ(skString::InlineCapacity, a.capacity());
 
     skString b = a;
     EXPECT_EQ(11, b.size());
-    EXPECT_EQ(12, b.capacity());
+    EXPECT_EQ(skString::InlineCapacity, b.capacity());
     EXPECT_TRUE(skChar::equals(b.c_str(), a.c_str()) == 0);
 
     skString c = b;
     EXPECT_EQ(11, c.size());
-    EXPECT_EQ(12, c.capacity());
+    EXPECT_EQ(skString::InlineCapacity, c.capacity());
     EXPECT_TRUE(skChar::equals(c.c_str(), a.c_str()) == 0);
 
     EXPECT_EQ(b, a);
@@ -107,7 +113,7 @@ TEST_FUNCTION(StringTest, SubStringEdges)
         const skString r = a.substr(10, a.size());
 
         EXPECT_EQ(1, r.size());
-        EXPECT_EQ(2, r.capacity());
+        EXPECT_EQ(skString::InlineCapacity, r.capacity());
         EXPECT_EQ('d', r.at(0));
     }
 }
@@ -116,7 +122,7 @@ TEST_FUNCTION(StringTest, FormatString1)
 {
     const skString a = skString::format("%s %s", "Hello", "World");
     EXPECT_EQ(11, a.size());
-    EXPECT_EQ(12, a.capacity());
+    EXPECT_EQ(skString::InlineCapacity, a.capacity());
 
     skStringArray spl;
     a.split(spl, " ");
@@ -135,7 +141,7 @@ TEST_FUNCTION(StringTest, FormatString2)
     skString a;
     skString::format(a, "%s %s", "Hello", "World");
     EXPECT_EQ(11, a.size());
-    EXPECT_EQ(12, a.capacity());
+    EXPECT_EQ(skString::InlineCapacity, a.capacity());
 
     skStringArray spl;
     a.split(spl, " ");
@@ -225,7 +231,7 @@ TEST_FUNCTION(StringTest, AddString)
         a += "Hello ";
 
         const SKsize len = (i + 1) * 6;
-        const SKsize cap = len + 1;
+        const SKsize cap = len <= skString::InlineCapacity ? skString::InlineCapacity : len + 1;
         EXPECT_EQ(len, a.size());
         EXPECT_EQ(cap, a.capacity());
     }
@@ -676,3 +682,244 @@ TEST_FUNCTION(StringBuilder, Test2)
     if (DEBUG)
         printf("STR (%s)\n", str.c_str());
 }
+
+TEST_FUNCTION(StringTest, InlineStorage)
+{
+    EXPECT_EQ(3 * sizeof(void*), sizeof(skString));
+
+    skString a;
+    EXPECT_EQ(nullptr, a.c_str());
+
+    // Grows one character at a time across the inline limit.
+    const char* alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for (SKsize i = 0; i < 52; ++i)
+    {
+        a.append(alphabet[i]);
+        EXPECT_EQ(i + 1, a.size());
+        EXPECT_TRUE(a.equals(skString(alphabet, i + 1)));
+        EXPECT_EQ(0, a.c_str()[i + 1]);
+        if (i < skString::InlineCapacity)
+            EXPECT_EQ(skString::InlineCapacity, a.capacity());
+        else
+            EXPECT_LT(skString::InlineCapacity, a.capacity());
+    }
+
+    skString small("inline"), large("this string is too long to fit inline");
+    small.swap(large);
+    EXPECT_EQ(small, "this string is too long to fit inline");
+    EXPECT_EQ(large, "inline");
+
+    large = small;
+    EXPECT_EQ(large, small);
+    small = "x";
+    EXPECT_EQ(small, "x");
+    EXPECT_EQ(1, small.size());
+
+    // Appending a string to itself across the heap boundary.
+    skString self("0123456789ABCDEF");
+    self += self;
+    EXPECT_EQ(self, "0123456789ABCDEF0123456789ABCDEF");
+    self.append(self.c_str() + 16, 16);
+    EXPECT_EQ(self, "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF");
+
+    skString erased("erase from inline");
+    erased.erase(5, 5);
+    EXPECT_EQ(erased, "erase inline");
+    erased.resize(0);
+    EXPECT_EQ(0, erased.size());
+    EXPECT_TRUE(erased.empty());
+
+    skString hex("\x01\xAB");
+    hex.toHex();
+    EXPECT_EQ(hex, "01AB");
+    hex.fromHex();
+    EXPECT_EQ(2, hex.size());
+    EXPECT_EQ((char)0xAB, hex[1]);
+}
+
+TEST_FUNCTION(StringTest, CachedHash)
+{
+    skString     a("a key long enough to live on the heap");
+    const SKhash h = skHash(a.c_str(), a.size());
+    EXPECT_EQ(h, a.hash());
+    EXPECT_EQ(h, skHash(a));
+    EXPECT_EQ(h, skHash(a.view()));
+
+    // The wrapper hashes the same way and keeps the value, copies included.
+    skHashedString key(a);
+    EXPECT_EQ(h, key.hash());
+    EXPECT_EQ(h, skHash(key));
+    skHashedString copy(key);
+    EXPECT_EQ(h, copy.hash());
+    EXPECT_TRUE(copy == a.view());
+
+    // Changing the source does not reach the key.
+    a.resize(5);
+    EXPECT_EQ(skHash("a key", 5), a.hash());
+    EXPECT_EQ(h, key.hash());
+    EXPECT_EQ(skString("a key long enough to live on the heap"), key.str());
+
+    copy = skHashedString("x");
+    EXPECT_EQ(skHash("x", 1), copy.hash());
+
+    skHashTable<skHashedString, int> table;
+    EXPECT_TRUE(table.insert(key, 1));
+    EXPECT_FALSE(table.insert(key, 2));
+    EXPECT_TRUE(table.insert(skHashedString("other"), 2));
+    table.remove(skHashedString("missing"));
+    EXPECT_EQ(2, table.size());
+    EXPECT_NE(SK_NPOS, table.find(skStringView("other")));
+    table.remove(key);
+    EXPECT_EQ(1, table.size());
+    EXPECT_EQ(SK_NPOS, table.find(key));
+
+    // The removed slot is reused.
+    EXPECT_TRUE(table.insert(key, 3));
+    EXPECT_EQ(3, *table.get(key));
+    EXPECT_EQ(3, *table.get(key.str().view()));
+}
+
+static std::atomic<SKuint64> StringAllocations(0);
+
+void* operator new[](size_t size)
+{
+    ++StringAllocations;
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+static void benchmarkKeys(const char* name, SKsize minLen, SKsize maxLen)
+{
+    const SKuint32 n = 1000000;
+
+    char source[64];
+    for (int i = 0; i < 64; ++i)
+        source[i] = (char)('a' + i % 26);
+
+    skArray<SKsize> lengths;
+    for (SKuint32 i = 0; i < n; ++i)
+        lengths.push_back(minLen + skRandomUnsignedInt((SKuint32)(maxLen - minLen + 1)));
+
+    char label[64];
+
+    const SKuint64 before = StringAllocations;
+    skTimer        timer;
+
+    skStringArray keys;
+    keys.reserve(n);
+    for (SKuint32 i = 0; i < n; ++i)
+        keys.push_back(skString(source + i % 8, lengths[i]));
+
+    snprintf(label, sizeof label, "construct %s", name);
+    benchmarkReport(label, timer.getMicroseconds(), n);
+    printf("%-48s %10.3f allocations/key\n", label, (double)(StringAllocations - before) / n);
+
+    // Command line sized input: 16 tokens per line.
+    skStringArray lines;
+    for (SKuint32 i = 0; i < 100000; i += 16)
+    {
+        skString line;
+        for (SKuint32 j = i; j < i + 16; ++j)
+        {
+            line.append(keys[j]);
+            line.append(' ');
+        }
+        lines.push_back(line);
+    }
+
+    const SKuint64 splitBefore = StringAllocations;
+    SKuint32       tokens      = 0;
+    timer.reset();
+    for (SKuint32 i = 0; i < lines.size(); ++i)
+    {
+        skStringArray split;
+        lines[i].split(split, ' ');
+        tokens += split.size();
+    }
+
+    snprintf(label, sizeof label, "split %s", name);
+    benchmarkReport(label, timer.getMicroseconds(), tokens);
+    printf("%-48s %10.3f allocations/token\n", label, (double)(StringAllocations - splitBefore) / tokens);
+
+    skHashTable<skString, SKuint32> table;
+    timer.reset();
+    for (SKuint32 i = 0; i < 100000; ++i)
+        table.insert(keys[i], i);
+
+    snprintf(label, sizeof label, "hash table insert %s", name);
+    benchmarkReport(label, timer.getMicroseconds(), 100000);
+}
+
+BENCHMARK_CASE("String_InlineKeys_Benchmark")
+{
+    skRandInit();
+
+    benchmarkKeys("3..20 chars", 3, 20);
+    benchmarkKeys("24..48 chars", 24, 48);
+}
+
+BENCHMARK_CASE("String_LongKeys_Benchmark")
+{
+    const SKuint32 n       = 1000;
+    const SKuint32 lookups = 200;
+
+    char label[64];
+    for (SKsize len = 256; len <= 4096; len *= 4)
+    {
+        skArray<skHashedString> keys;
+        keys.reserve(n);
+        for (SKuint32 i = 0; i < n; ++i)
+        {
+            skString key('k', len);
+            snprintf(key.ptr(), len, "%u", i);
+            key.ptr()[skChar::length(key.c_str())] = '-';
+            keys.push_back(key);
+        }
+
+        skHashTable<skHashedString, SKuint32> table;
+        for (SKuint32 i = 0; i < n; ++i)
+            table.insert(keys[i], i);
+
+        // The same key objects: hashed once, then served from the cache.
+        SKuint64 found = 0;
+        skTimer  timer;
+        for (SKuint32 r = 0; r < lookups; ++r)
+        {
+            for (SKuint32 i = 0; i < n; ++i)
+                found += table.find(keys[i]) != SK_NPOS;
+        }
+        snprintf(label, sizeof label, "lookup cached %u chars", (unsigned)len);
+        benchmarkReport(label, timer.getMicroseconds(), (SKuint64)n * lookups);
+
+        // Views of the same keys are hashed on every lookup.
+        timer.reset();
+        for (SKuint32 r = 0; r < lookups; ++r)
+        {
+            for (SKuint32 i = 0; i < n; ++i)
+                found += table.find(keys[i].str().view()) != SK_NPOS;
+        }
+        snprintf(label, sizeof label, "lookup uncached %u chars", (unsigned)len);
+        benchmarkReport(label, timer.getMicroseconds(), (SKuint64)n * lookups);
+
+        // Insert and remove of cached keys.
+        timer.reset();
+        for (SKuint32 r = 0; r < 20; ++r)
+        {
+            for (SKuint32 i = 0; i < n; ++i)
+                table.remove(keys[i]);
+            for (SKuint32 i = 0; i < n; ++i)
+                table.insert(keys[i], i);
+        }
+        snprintf(label, sizeof label, "remove+insert %u chars", (unsigned)len);
+        benchmarkReport(label, timer.getMicroseconds(), (SKuint64)n * 20);
+
+        EXPECT_EQ((SKuint64)n * lookups * 2, found);
+    }
+}
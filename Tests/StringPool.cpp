@@ -0,0 +1,205 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "Utils/skMap.h"
+#include "Utils/skString.h"
+#include "Utils/skStringPool.h"
+#include "catch/catch.hpp"
+
+static skString makeKey(SKuint32 i)
+{
+    return skString::format("config.section%u.key%u", i % 37, i);
+}
+
+TEST_CASE("StringPool_Intern")
+{
+    skStringPool pool;
+
+    const skAtom a = pool.intern("alpha");
+    const skAtom b = pool.intern(skString("beta"));
+    const skAtom c = pool.intern(skString("alphabet").view(0, 5));
+
+    REQUIRE(a == c);
+    REQUIRE(a != b);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(a.view() == "alpha");
+    REQUIRE(skChar::equals(b.c_str(), "beta") == 0);
+    REQUIRE(a.size() == 5);
+    REQUIRE(a.id() == 1);
+    REQUIRE(b.id() == 2);
+    REQUIRE(a.hash() == skHash(skStringView("alpha")));
+
+    REQUIRE(pool.find("beta") == b);
+    REQUIRE(pool.find("gamma").isNull());
+    REQUIRE(pool.size() == 2);
+
+    const skAtom none;
+    REQUIRE(none.isNull());
+    REQUIRE(none.size() == 0);
+    REQUIRE(none.id() == 0);
+    REQUIRE(none.view().empty());
+
+    const skAtom empty = pool.intern("");
+    REQUIRE(!empty.isNull());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(pool.intern(skStringView()) == empty);
+}
+
+TEST_CASE("StringPool_ManyStrings")
+{
+    skStringPool pool;
+
+    skArray<skAtom> atoms;
+    for (SKuint32 i = 0; i < 20000; ++i)
+        atoms.push_back(pool.intern(makeKey(i)));
+
+    // Longer than an arena block.
+    skString big;
+    big.resize(50000);
+    for (SKsize i = 0; i < big.size(); ++i)
+        big.ptr()[i] = (char)('a' + i % 26);
+    const skAtom large = pool.intern(big);
+
+    REQUIRE(pool.size() == 20001);
+    REQUIRE(large.view() == big);
+    REQUIRE(pool.memoryUsed() > big.size());
+
+    // Growing the tables never moves an entry.
+    for (SKuint32 i = 0; i < 20000; ++i)
+    {
+        REQUIRE(atoms[i].view() == makeKey(i));
+        REQUIRE(pool.intern(makeKey(i)) == atoms[i]);
+        REQUIRE(atoms[i].id() == i + 1);
+    }
+    REQUIRE(pool.size() == 20001);
+}
+
+TEST_CASE("StringPool_HashTableKey")
+{
+    skStringPool pool;
+
+    skHashTable<skAtom, SKuint32> table;
+    for (SKuint32 i = 0; i < 1000; ++i)
+        table.insert(pool.intern(makeKey(i)), i);
+
+    REQUIRE(table.size() == 1000);
+    for (SKuint32 i = 0; i < 1000; ++i)
+    {
+        const SKuint32* value = table.get(pool.find(makeKey(i)));
+        REQUIRE(value != nullptr);
+        REQUIRE(*value == i);
+    }
+    REQUIRE(table.get(pool.intern("missing")) == nullptr);
+}
+
+TEST_CASE("StringPool_Threads")
+{
+    skStringPool pool;
+
+    const SKuint32 threadCount = 4;
+    const SKuint32 keyCount    = 5000;
+
+    // Every thread interns the same keys in a different order.
+    std::vector<std::vector<skAtom> > results(threadCount);
+    std::vector<std::thread>          threads;
+    for (SKuint32 t = 0; t < threadCount; ++t)
+    {
+        threads.push_back(std::thread([&pool, &results, t, keyCount]() {
+            std::vector<skAtom>& out = results[t];
+            out.resize(keyCount);
+            for (SKuint32 n = 0; n < keyCount; ++n)
+            {
+                const SKuint32 i = (n * 7919 + t * 131) % keyCount;
+                out[i]           = pool.intern(makeKey(i));
+            }
+        }));
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    REQUIRE(pool.size() == keyCount);
+    for (SKuint32 i = 0; i < keyCount; ++i)
+    {
+        REQUIRE(results[0][i].view() == makeKey(i));
+        for (SKuint32 t = 1; t < threadCount; ++t)
+            REQUIRE(results[t][i] == results[0][i]);
+    }
+}
+
+BENCHMARK_CASE("StringPool_Benchmark")
+{
+    const SKuint32 keyCount = 4096;
+    const SKuint32 lookups  = 4 * 1024 * 1024;
+
+    skStringPool      pool;
+    skArray<skString> keys;
+    skArray<skAtom>   atoms;
+    for (SKuint32 i = 0; i < keyCount; ++i)
+    {
+        keys.push_back(makeKey(i));
+        atoms.push_back(pool.intern(keys[i]));
+    }
+
+    skHashTable<skString, SKuint32> byString;
+    skHashTable<skAtom, SKuint32>   byAtom;
+    for (SKuint32 i = 0; i < keyCount; ++i)
+    {
+        byString.insert(keys[i], i);
+        byAtom.insert(atoms[i], i);
+    }
+
+    skTimer  timer;
+    SKuint64 sum = 0;
+    for (SKuint32 i = 0; i < lookups; ++i)
+        sum += *byString.get(keys[(i * 2654435761u) % keyCount]);
+    benchmarkReport("skHashTable<skString> get", timer.getMicroseconds(), lookups);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+        sum += *byAtom.get(atoms[(i * 2654435761u) % keyCount]);
+    benchmarkReport("skHashTable<skAtom> get", timer.getMicroseconds(), lookups);
+
+    timer.reset();
+    SKuint32 equal = 0;
+    for (SKuint32 i = 0; i < lookups; ++i)
+        equal += keys[i % keyCount] == keys[(i + 1) % keyCount] ? 0 : 1;
+    benchmarkReport("skString ==", timer.getMicroseconds(), lookups);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+        equal += atoms[i % keyCount] == atoms[(i + 1) % keyCount] ? 0 : 1;
+    benchmarkReport("skAtom ==", timer.getMicroseconds(), lookups);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < lookups; ++i)
+        sum += pool.intern(keys[i % keyCount]).id();
+    benchmarkReport("skStringPool::intern (hit)", timer.getMicroseconds(), lookups);
+
+    REQUIRE(sum > 0);
+    REQUIRE(equal == 2 * lookups);
+}
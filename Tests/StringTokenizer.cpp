@@ -0,0 +1,208 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "Utils/skStringTokenizer.h"
+#include "catch/catch.hpp"
+
+// The obvious byte at a time split, to check the tokenizer against.
+static void referenceSplit(skArray<skStringView>& dest,
+                           const skStringView&    input,
+                           const char*            delims,
+                           bool                   keepEmpty)
+{
+    if (input.empty())
+        return;
+
+    const skStringView set(delims);
+
+    SKsize start = 0;
+    for (SKsize i = 0; i <= input.size(); ++i)
+    {
+        if (i == input.size() || set.find(input[i]) != skStringView::npos)
+        {
+            if (i > start || keepEmpty)
+                dest.push_back(input.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+}
+
+TEST_CASE("StringTokenizer_Basics")
+{
+    skStringTokenizer tokens("alpha, beta,,gamma ", ", ");
+
+    REQUIRE(tokens.hasMoreElements());
+    REQUIRE(tokens.peekNext() == "alpha");
+    REQUIRE(tokens.getNext() == "alpha");
+    REQUIRE(tokens.getNext() == "beta");
+    REQUIRE(tokens.getNext() == "gamma");
+    REQUIRE(!tokens.hasMoreElements());
+    REQUIRE(tokens.getNext().empty());
+
+    tokens.reset();
+    REQUIRE(tokens.getNext() == "alpha");
+
+    skStringTokenizer fields("a,,b,", ',', true);
+    REQUIRE(fields.getNext() == "a");
+    REQUIRE(fields.getNext() == "");
+    REQUIRE(fields.getNext() == "b");
+    REQUIRE(fields.hasMoreElements());
+    REQUIRE(fields.getNext() == "");
+    REQUIRE(!fields.hasMoreElements());
+
+    skStringTokenizer none("", ',', true);
+    REQUIRE(!none.hasMoreElements());
+
+    skStringTokenizer whole("no delimiters here", ';');
+    REQUIRE(whole.getNext() == "no delimiters here");
+    REQUIRE(!whole.hasMoreElements());
+
+    const skDelimiterSet set(" \t\r\n");
+    REQUIRE(set.size() == 4);
+    REQUIRE(set.contains('\t'));
+    REQUIRE(!set.contains('x'));
+    REQUIRE(set.find("word\tnext", 9) == 4);
+    REQUIRE(set.find("word", 4) == 4);
+}
+
+TEST_CASE("StringTokenizer_MatchesReference")
+{
+    skRandInit();
+
+    // One, three and more than VectorLimit delimiters, the last of which
+    // takes the lookup table path.
+    const char* sets[]  = {",", ",; ", ",;:|/\\-_+="};
+    const char  chars[] = "abc,;: |/\\-_+=xyz";
+
+    for (const char* delims : sets)
+    {
+        for (SKsize len = 0; len < 300; len += 7)
+        {
+            skString input;
+            for (SKsize i = 0; i < len; ++i)
+                input.append(chars[skRandomUnsignedInt(sizeof chars - 1)]);
+
+            for (int keep = 0; keep < 2; ++keep)
+            {
+                skArray<skStringView> expected, actual;
+                referenceSplit(expected, input, delims, keep != 0);
+                input.splitViews(actual, delims, keep != 0);
+
+                REQUIRE(expected.size() == actual.size());
+                for (SKuint32 i = 0; i < expected.size(); ++i)
+                {
+                    REQUIRE(expected[i] == actual[i]);
+                    if (!expected[i].empty())
+                        REQUIRE(expected[i].ptr() == actual[i].ptr());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("StringTokenizer_SplitViews")
+{
+    const skString line("2021-05-04 12:00:01 INFO server started on port 8080");
+
+    skArray<skStringView> fields;
+    line.splitViews(fields, ' ');
+    REQUIRE(fields.size() == 8);
+    REQUIRE(fields[2] == "INFO");
+    REQUIRE(fields[7].toInt32() == 8080);
+    REQUIRE(fields[0].ptr() == line.c_str());
+
+    skArray<skStringView> parts;
+    skString(line.view(0, 19)).splitViews(parts, "-: ");
+    REQUIRE(parts.size() == 6);
+
+    // split keeps copying pieces and skipping empty ones.
+    skArray<skString> copies;
+    skString("one::two::::three").split(copies, "::");
+    REQUIRE(copies.size() == 3);
+    REQUIRE(copies[0] == "one");
+    REQUIRE(copies[1] == "two");
+    REQUIRE(copies[2] == "three");
+}
+
+BENCHMARK_CASE("StringTokenizer_Benchmark")
+{
+    skRandInit();
+
+    // CSV style rows of short numeric and text fields.
+    skString csv;
+    csv.reserve(64 * 1024 * 1024);
+    while (csv.size() < 64 * 1024 * 1024)
+    {
+        for (int f = 0; f < 8; ++f)
+        {
+            const SKuint32 len = 1 + skRandomUnsignedInt(12);
+            for (SKuint32 i = 0; i < len; ++i)
+                csv.append((char)('a' + skRandomUnsignedInt(26)));
+            csv.append(f < 7 ? ',' : '\n');
+        }
+    }
+
+    const SKsize bytes = csv.size();
+    char         name[64];
+    skTimer      timer;
+
+    SKsize tokens = 0;
+    timer.reset();
+    skStringTokenizer lazy(csv, ",\n");
+    while (lazy.hasMoreElements())
+    {
+        tokens += lazy.getNext().size() > 0;
+    }
+    SKulong micro = timer.getMicroseconds();
+    snprintf(name, sizeof name, "tokenizer %.2f GB/s", (double)bytes / (double)micro / 1000.0);
+    benchmarkReport(name, micro, tokens);
+
+    skArray<skStringView> views;
+    views.reserve((SKuint32)tokens + 1);
+    timer.reset();
+    csv.splitViews(views, ",\n");
+    micro = timer.getMicroseconds();
+    snprintf(name, sizeof name, "splitViews %.2f GB/s", (double)bytes / (double)micro / 1000.0);
+    benchmarkReport(name, micro, views.size());
+
+    // split takes a single separator, so run it on one row at a time.
+    skArray<skStringView> rows;
+    csv.splitViews(rows, '\n');
+
+    SKsize copied = 0;
+    timer.reset();
+    for (SKuint32 i = 0; i < rows.size(); ++i)
+    {
+        skArray<skString> fields;
+        skString(rows[i]).split(fields, ",");
+        copied += fields.size();
+    }
+    micro = timer.getMicroseconds();
+    snprintf(name, sizeof name, "split %.2f GB/s", (double)bytes / (double)micro / 1000.0);
+    benchmarkReport(name, micro, copied);
+}
@@ -0,0 +1,184 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstring>
+#include "Utils/skMap.h"
+#include "Utils/skString.h"
+#include "Utils/skStringBuilder.h"
+#include "Utils/skStringView.h"
+#include "catch/catch.hpp"
+
+TEST_CASE("StringView_Basics")
+{
+    const skStringView empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.find('a') == skStringView::npos);
+    REQUIRE(empty == skStringView(""));
+
+    const char*        text = "key=value;other";
+    const skStringView view(text);
+    REQUIRE(view.size() == 15);
+    REQUIRE(view.ptr() == text);
+    REQUIRE(view.front() == 'k');
+    REQUIRE(view.back() == 'r');
+    REQUIRE(view[15] == 0);
+
+    const skStringView key = view.substr(0, view.find('='));
+    REQUIRE(key == "key");
+    REQUIRE(key.ptr() == text);
+
+    const skStringView value = view.substr(4, view.find(';') - 4);
+    REQUIRE(value == "value");
+    REQUIRE(view.substr(10) == "other");
+    REQUIRE(view.substr(100).empty());
+
+    REQUIRE(view.find("value") == 4);
+    REQUIRE(view.find("other", 5) == 10);
+    REQUIRE(view.find("others") == skStringView::npos);
+    REQUIRE(view.find("") == 0);
+    REQUIRE(view.find('e', 2) == 8);
+    REQUIRE(view.rfind('e') == 13);
+
+    REQUIRE(view.startsWith("key"));
+    REQUIRE(view.startsWith(view));
+    REQUIRE(!view.startsWith("value"));
+    REQUIRE(view.endsWith("other"));
+    REQUIRE(!view.endsWith("key"));
+
+    REQUIRE(skStringView("abc") < skStringView("abd"));
+    REQUIRE(skStringView("ab") < skStringView("abc"));
+    REQUIRE(skStringView("abc").compare("abc") == 0);
+    REQUIRE(skStringView("b").compare("abc") > 0);
+
+    skStringView trimmed = view;
+    trimmed.removePrefix(4);
+    trimmed.removeSuffix(6);
+    REQUIRE(trimmed == "value");
+}
+
+TEST_CASE("StringView_Numbers")
+{
+    const skStringView line("12 -7 65535 3.5 true 18446744073709551615");
+
+    REQUIRE(line.substr(0, 2).toInt32() == 12);
+    REQUIRE(line.substr(3, 2).toInt16() == -7);
+    REQUIRE(line.substr(3, 2).toInt64() == -7);
+    REQUIRE(line.substr(6, 5).toUint16() == 65535);
+    REQUIRE(line.substr(6, 5).toUint32() == 65535);
+    REQUIRE(line.substr(12, 3).toDouble() == 3.5);
+    REQUIRE(line.substr(12, 3).toFloat() == 3.5f);
+    REQUIRE(line.substr(16, 4).toBoolean());
+    REQUIRE(line.substr(21).toUint64() == 18446744073709551615ULL);
+
+    // The view ends before the rest of the digits.
+    REQUIRE(line.substr(0, 1).toInt32() == 1);
+    REQUIRE(skStringView().toInt32(42) == 42);
+    REQUIRE(skChar::toInt32(line.substr(6, 2)) == 65);
+}
+
+TEST_CASE("StringView_Interop")
+{
+    skString source("split these words without copies");
+
+    skStringView view = source.view(6, 5);
+    REQUIRE(view == "these");
+    REQUIRE(view.ptr() == source.c_str() + 6);
+    REQUIRE(source.view() == source);
+    REQUIRE(source.view(100).empty());
+
+    skString copy(view);
+    REQUIRE(copy == "these");
+    REQUIRE(copy == view);
+    REQUIRE(copy.equals(view));
+    REQUIRE(copy.compare(skStringView("these")) == 0);
+
+    skString joined("words: ");
+    joined.append(source.view(12, 5));
+    joined += source.view(17, 1);
+    joined += source.view(18);
+    REQUIRE(joined == "words: words without copies");
+
+    REQUIRE(source.find(skStringView("words")) == 12);
+    REQUIRE(source.find(skStringView("without"), 12) == 6);
+    REQUIRE(source.startsWith(skStringView("split")));
+    REQUIRE(source.endsWith(source.view(26)));
+
+    REQUIRE(skHash(view) == skHash(copy));
+    REQUIRE(skHash(view) == skHash("these"));
+    REQUIRE(view.hash() == skHash(copy));
+
+    skStringBuilder builder;
+    builder.write(source.view(0, 5));
+    builder.write(skStringView(" it"));
+    REQUIRE(builder.toString() == "split it");
+}
+
+TEST_CASE("StringView_HashTableLookup")
+{
+    skHashTable<skString, int> table;
+    table.insert("alpha", 1);
+    table.insert("beta", 2);
+    table.insert("gamma", 3);
+
+    const skStringView input("alpha,beta,gamma,delta");
+
+    SKsize start = 0;
+    int    sum   = 0;
+    for (;;)
+    {
+        const SKsize       end   = input.find(',', start);
+        const skStringView token = input.substr(start, end == skStringView::npos ? skStringView::npos : end - start);
+
+        int* value = table.get(token);
+        if (value)
+            sum += *value;
+        else
+            REQUIRE(token == "delta");
+
+        if (end == skStringView::npos)
+            break;
+        start = end + 1;
+    }
+    REQUIRE(sum == 6);
+    REQUIRE(table.find(skStringView("beta")) == table.find(skString("beta")));
+}
+
+TEST_CASE("StringView_HashUnterminated")
+{
+    // A view over an exactly sized buffer, with no terminator after it.
+    char* buffer = new char[4];
+    memcpy(buffer, "abcd", 4);
+
+    const skStringView view(buffer, 4);
+    REQUIRE(view.hash() == skHash("abcd"));
+    REQUIRE(skHash(view.substr(1, 3)) == skHash("bcd"));
+
+    skHashTable<skString, int> table;
+    table.insert("abcd", 1);
+    REQUIRE(table.get(view) != nullptr);
+
+    delete[] buffer;
+}
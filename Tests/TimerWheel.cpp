@@ -0,0 +1,211 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Macro.h"
+#include "Utils/skRandom.h"
+#include "Utils/skTimerWheel.h"
+#include "catch/catch.hpp"
+
+class TimerRecorder
+{
+public:
+    skTimerWheel* wheel;
+    SKuint64      fired;
+    SKuint64      mismatched;
+    SKuint64      lastTick;
+
+    explicit TimerRecorder(skTimerWheel* w) :
+        wheel(w),
+        fired(0),
+        mismatched(0),
+        lastTick(0)
+    {
+    }
+
+    void onTimer(void* userData)
+    {
+        // userData holds the tick the timer is due on
+        const SKuint64 due = (SKuint64)(SKuintPtr)userData;
+        if (due != wheel->now())
+            ++mismatched;
+        lastTick = wheel->now();
+        ++fired;
+    }
+
+    skTimerWheel::Callback callback()
+    {
+        return skTimerWheel::Callback::bind<TimerRecorder, &TimerRecorder::onTimer>(this);
+    }
+};
+
+TEST_CASE("TimerWheel_FiresOnTime")
+{
+    skTimerWheel  wheel;
+    TimerRecorder rec(&wheel);
+
+    EXPECT_EQ(0, wheel.advance(5));
+
+    wheel.schedule(0, rec.callback(), (void*)(SKuintPtr)6);
+    wheel.schedule(1, rec.callback(), (void*)(SKuintPtr)6);
+    wheel.schedule(10, rec.callback(), (void*)(SKuintPtr)15);
+    EXPECT_EQ(3, wheel.size());
+
+    EXPECT_EQ(2, wheel.advance(1));
+    EXPECT_EQ(0, wheel.advance(8));
+    EXPECT_EQ(1, wheel.advance(1));
+    EXPECT_EQ(0, rec.mismatched);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel_Cascade")
+{
+    skTimerWheel  wheel;
+    TimerRecorder rec(&wheel);
+
+    skRandInit(42);
+
+    // delays that land in all four wheels
+    const SKuint64 ranges[] = {200, 60000, 3000000, 20000000};
+    SKuint64       nr       = 0;
+    for (SKuint64 range : ranges)
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            const SKuint64 delay = 1 + skRandomUnsignedInt((SKuint32)range);
+            wheel.schedule(delay, rec.callback(), (void*)(SKuintPtr)(wheel.now() + delay));
+            ++nr;
+        }
+        // move the wheel to an unaligned position before the next batch
+        wheel.advance(137);
+    }
+
+    wheel.advance(20000000);
+    EXPECT_EQ(nr, rec.fired);
+    EXPECT_EQ(0, rec.mismatched);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel_Cancel")
+{
+    skTimerWheel  wheel;
+    TimerRecorder rec(&wheel);
+
+    skTimerWheel::Handle a = wheel.schedule(10, rec.callback(), (void*)(SKuintPtr)10);
+    skTimerWheel::Handle b = wheel.schedule(1000, rec.callback(), (void*)(SKuintPtr)1000);
+
+    EXPECT_TRUE(wheel.isActive(a));
+    EXPECT_TRUE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.isActive(a));
+    EXPECT_FALSE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.cancel(skTimerWheel::InvalidHandle));
+
+    // the released node is reused, but the old handle stays invalid
+    skTimerWheel::Handle c = wheel.schedule(20, rec.callback(), (void*)(SKuintPtr)20);
+    EXPECT_NE(a, c);
+    EXPECT_FALSE(wheel.isActive(a));
+    EXPECT_TRUE(wheel.isActive(c));
+
+    wheel.advance(1000);
+    EXPECT_EQ(2, rec.fired);
+    EXPECT_EQ(0, rec.mismatched);
+    EXPECT_FALSE(wheel.isActive(b));
+    EXPECT_FALSE(wheel.cancel(b));
+}
+
+class Rescheduler
+{
+public:
+    skTimerWheel* wheel;
+    int           remaining;
+
+    void onTimer(void*)
+    {
+        if (--remaining > 0)
+            wheel->schedule(0, skTimerWheel::Callback::bind<Rescheduler, &Rescheduler::onTimer>(this));
+    }
+};
+
+TEST_CASE("TimerWheel_ScheduleFromCallback")
+{
+    skTimerWheel wheel;
+    Rescheduler  r = {&wheel, 5};
+    wheel.schedule(0, skTimerWheel::Callback::bind<Rescheduler, &Rescheduler::onTimer>(&r));
+
+    EXPECT_EQ(1, wheel.advance(1));
+    EXPECT_EQ(1, wheel.size());
+    EXPECT_EQ(4, wheel.advance(10));
+    EXPECT_EQ(0, r.remaining);
+    EXPECT_TRUE(wheel.empty());
+}
+
+BENCHMARK_CASE("TimerWheel_OneMillionTimers")
+{
+    const SKuint32 Live = 1000000;
+
+    skTimerWheel                  wheel;
+    TimerRecorder                 rec(&wheel);
+    skTimerWheel::Callback        cb = rec.callback();
+    skArray<skTimerWheel::Handle> handles;
+    handles.reserve(Live);
+
+    skRandInit(7);
+    skTimer t;
+    for (SKuint32 i = 0; i < Live; ++i)
+        handles.push_back(wheel.schedule(1 + skRandomUnsignedInt(60000), cb));
+    benchmarkReport("skTimerWheel schedule (1M live)", t.getMicroseconds(), Live);
+
+    t.reset();
+    for (SKuint32 i = 0; i < Live; i += 2)
+        wheel.cancel(handles[i]);
+    benchmarkReport("skTimerWheel cancel (half of 1M)", t.getMicroseconds(), Live / 2);
+
+    t.reset();
+    for (SKuint32 i = 0; i < Live; i += 2)
+        handles[i] = wheel.schedule(1 + skRandomUnsignedInt(60000), cb);
+    benchmarkReport("skTimerWheel reschedule (pooled)", t.getMicroseconds(), Live / 2);
+
+    t.reset();
+    wheel.advance(60001);
+    benchmarkReport("skTimerWheel expire 1M over 60k ticks", t.getMicroseconds(), Live);
+    REQUIRE(rec.fired == Live);
+
+    // What the wheel replaces: scanning an array of deadlines every tick.
+    skArray<SKuint64> deadlines;
+    for (SKuint32 i = 0; i < 100000; ++i)
+        deadlines.push_back(1 + skRandomUnsignedInt(60000));
+
+    t.reset();
+    SKuint64 expired = 0;
+    for (SKuint64 tick = 0; tick < 100; ++tick)
+    {
+        for (SKuint32 i = 0; i < deadlines.size(); ++i)
+        {
+            if (deadlines[i] == tick)
+                ++expired;
+        }
+    }
+    benchmarkReport("skArray scan per tick (100k live, 100 ticks)", t.getMicroseconds(), 100);
+}
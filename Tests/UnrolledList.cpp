@@ -0,0 +1,188 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "Utils/skList.h"
+#include "Utils/skRandom.h"
+#include "Utils/skString.h"
+#include "Utils/skUnrolledList.h"
+#include "catch/catch.hpp"
+
+typedef skUnrolledList<int, 8> IntList;
+
+
+TEST_CASE("UnrolledList_PushPop")
+{
+    IntList list;
+    REQUIRE(list.empty());
+    REQUIRE(!list.iterator().hasMoreElements());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        list.push_back(i);
+        list.push_front(-i - 1);
+    }
+
+    REQUIRE(list.size() == 200);
+    REQUIRE(list.front() == -100);
+    REQUIRE(list.back() == 99);
+
+    for (SKuint32 i = 0; i < list.size(); ++i)
+        REQUIRE(list.at(i) == (int)i - 100);
+
+    int                      expected = 99;
+    IntList::ReverseIterator r        = list.reverseIterator();
+    while (r.hasMoreElements())
+        REQUIRE(r.getNext() == expected--);
+    REQUIRE(expected == -101);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        list.pop_front();
+        list.pop_back();
+    }
+
+    REQUIRE(list.size() == 100);
+    REQUIRE(list.front() == -50);
+    REQUIRE(list.back() == 49);
+
+    while (!list.empty())
+        list.pop_back();
+    REQUIRE(list.nodeCount() == 0);
+}
+
+
+TEST_CASE("UnrolledList_InsertErase")
+{
+    skRandInit();
+
+    IntList     list;
+    skList<int> ref;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const SKuint32 op  = skRandomUnsignedInt(3);
+        const SKuint32 pos = list.empty() ? 0 : skRandomUnsignedInt(list.size());
+
+        IntList::Iterator it = list.iterator();
+        for (SKuint32 j = 0; j < pos && it.hasMoreElements(); ++j)
+            it.next();
+
+        if (op < 2 || list.empty())
+        {
+            IntList::Iterator ins = list.insert(it, i);
+            REQUIRE(ins.peekNext() == i);
+
+            if (ref.link_at(pos))
+                ref.insert_front(ref.link_at(pos), i);
+            else
+                ref.push_back(i);
+        }
+        else
+        {
+            IntList::Iterator next = list.erase(it);
+            ref.erase(ref.link_at(pos));
+
+            if (pos < ref.size())
+                REQUIRE(next.peekNext() == ref.at(pos));
+            else
+                REQUIRE(!next.hasMoreElements());
+        }
+
+        REQUIRE(list.size() == ref.size());
+    }
+
+    skList<int>::Iterator a = ref.iterator();
+    IntList::Iterator     b = list.iterator();
+    while (a.hasMoreElements())
+        REQUIRE(a.getNext() == b.getNext());
+    REQUIRE(!b.hasMoreElements());
+
+    // every node stays at least partly used
+    REQUIRE(list.nodeCount() <= 2 * (list.size() / 4 + 1));
+}
+
+
+TEST_CASE("UnrolledList_Strings")
+{
+    skUnrolledList<skString, 4> list;
+    for (int i = 0; i < 64; ++i)
+    {
+        list.push_back(skString::format("item %d", i));
+    }
+
+    list.erase(skString("item 10"));
+    REQUIRE(list.size() == 63);
+    REQUIRE(list.at(10) == "item 11");
+    REQUIRE(!list.find("item 10").hasMoreElements());
+
+    skUnrolledList<skString, 4> copy(list);
+    list.clear();
+    REQUIRE(copy.size() == 63);
+    REQUIRE(copy.front() == "item 0");
+    REQUIRE(copy.back() == "item 63");
+}
+
+
+BENCHMARK_CASE("UnrolledList_Traversal")
+{
+    const SKuint32 count  = 1000000;
+    const int      passes = 10;
+
+    skTimer                 timer;
+    skList<int>             list;
+    skUnrolledList<int, 32> unrolled;
+
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        list.push_back((int)i);
+    benchmarkReport("skList push_back", timer.getMicroseconds(), count);
+
+    timer.reset();
+    for (SKuint32 i = 0; i < count; ++i)
+        unrolled.push_back((int)i);
+    benchmarkReport("skUnrolledList<int, 32> push_back", timer.getMicroseconds(), count);
+
+    SKuint64 sumA = 0, sumB = 0;
+
+    timer.reset();
+    for (int p = 0; p < passes; ++p)
+    {
+        skList<int>::Iterator it = list.iterator();
+        while (it.hasMoreElements())
+            sumA += it.getNext();
+    }
+    benchmarkReport("skList traversal", timer.getMicroseconds(), (SKuint64)count * passes);
+
+    timer.reset();
+    for (int p = 0; p < passes; ++p)
+    {
+        skUnrolledList<int, 32>::Iterator it = unrolled.iterator();
+        while (it.hasMoreElements())
+            sumB += it.getNext();
+    }
+    benchmarkReport("skUnrolledList<int, 32> traversal", timer.getMicroseconds(), (SKuint64)count * passes);
+
+    REQUIRE(sumA == sumB);
+}
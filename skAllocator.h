@@ -26,6 +26,8 @@
 #ifndef _skAllocator_h_
 #define _skAllocator_h_
 
+#include <new>
+#include <type_traits>
 #include "Config/skConfig.h"
 #include "skMemoryUtils.h"
 #include "skMinMax.h"
@@ -265,6 +267,128 @@ public:
     }
 };
 
+// Fixed size object pool.
+//
+// Slots are carved from blocks of BlockSize objects and recycled through a
+// free list, so node based containers pay one heap allocation per block
+// instead of one per node. Blocks are only returned to the heap by release,
+// which expects every live object to have been deallocated or destroyed.
+template <typename T, const SKuint32 BlockSize = 256>
+class skPoolAllocator
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skPoolAllocator<T, BlockSize> SelfType;
+
+private:
+    union Slot
+    {
+        Slot* next;
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+    };
+
+    struct Block
+    {
+        Block* next;
+        Slot   slots[BlockSize];
+    };
+
+    Block* m_blocks;
+    Slot*  m_free;
+    SKsize m_used;
+
+public:
+    skPoolAllocator() :
+        m_blocks(nullptr),
+        m_free(nullptr),
+        m_used(0)
+    {
+    }
+
+    ~skPoolAllocator()
+    {
+        release();
+    }
+
+    // Returns uninitialized storage for one T.
+    PointerType allocate_base(void)
+    {
+        if (!m_free)
+            grow();
+
+        Slot* slot = m_free;
+        m_free     = slot->next;
+        ++m_used;
+        return reinterpret_cast<PointerType>(slot);
+    }
+
+    // Returns storage to the pool without running the destructor.
+    void deallocate_base(PointerType base)
+    {
+        SK_ASSERT(base && m_used > 0);
+
+        Slot* slot = reinterpret_cast<Slot*>(base);
+        slot->next = m_free;
+        m_free     = slot;
+        --m_used;
+    }
+
+    PointerType allocate(ConstReferenceType v)
+    {
+        PointerType base = allocate_base();
+        new (base) T(v);
+        return base;
+    }
+
+    void deallocate(PointerType base)
+    {
+        if (base)
+        {
+            base->~T();
+            deallocate_base(base);
+        }
+    }
+
+    // Frees every block. Objects still in the pool are not destroyed.
+    void release(void)
+    {
+        while (m_blocks)
+        {
+            Block* next = m_blocks->next;
+            skFree(m_blocks);
+            m_blocks = next;
+        }
+        m_free = nullptr;
+        m_used = 0;
+    }
+
+    // The number of live objects.
+    SKsize size(void) const
+    {
+        return m_used;
+    }
+
+private:
+    void grow(void)
+    {
+        Block* block = static_cast<Block*>(skMalloc(sizeof(Block)));
+        block->next  = m_blocks;
+        m_blocks     = block;
+
+        for (SKuint32 i = BlockSize; i > 0; --i)
+        {
+            Slot* slot = &block->slots[i - 1];
+            slot->next = m_free;
+            m_free     = slot;
+        }
+    }
+
+    skPoolAllocator(const skPoolAllocator&)            = delete;
+    skPoolAllocator& operator=(const skPoolAllocator&) = delete;
+};
+
 #if SK_ALLOCATOR == 1
 #define skAllocator skMallocAllocator
 #else
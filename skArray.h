@@ -28,6 +28,7 @@
 
 #include "skAllocator.h"
 #include "skArrayBase.h"
+#include "skRadixSort.h"
 #include "skSort.h"
 
 template <typename T, typename Allocator = skAllocator<T, SKuint32> >
@@ -224,6 +225,26 @@ public:
         this->replicate(rhs);
         return *this;
     }
+
+    // Stable radix sort of integer or floating point elements.
+    void radixSort(void)
+    {
+        radixSort(skRadixIdentity<T>());
+    }
+
+    // Stable radix sort by the integer or floating point key that
+    // key(element) returns. The scratch buffer comes from this array's
+    // allocator.
+    template <typename KeyFn>
+    void radixSort(KeyFn key)
+    {
+        if (this->m_size < 2)
+            return;
+
+        PointerType scratch = this->m_alloc.array_allocate(this->m_size);
+        skRadixSort(this->m_data, (SKsize)this->m_size, scratch, key);
+        this->m_alloc.array_deallocate(scratch, this->m_size);
+    }
 };
 
 #endif  //_skArray_h_
@@ -0,0 +1,942 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBTreeMap_h_
+#define _skBTreeMap_h_
+
+#include "Config/skConfig.h"
+#include "skAllocator.h"
+#include "skArray.h"
+
+template <typename T>
+class skBTreeMapIterator
+{
+public:
+    typedef typename T::PairKeyType     PairKeyType;
+    typedef typename T::PairValueType   PairValueType;
+    typedef typename T::LeafPointerType LeafPointerType;
+
+private:
+    mutable LeafPointerType m_leaf;
+    mutable SKuint32        m_index;
+    LeafPointerType         m_endLeaf;
+    SKuint32                m_endIndex;
+
+public:
+    skBTreeMapIterator() :
+        m_leaf(nullptr),
+        m_index(0),
+        m_endLeaf(nullptr),
+        m_endIndex(0)
+    {
+    }
+
+    // Iterates from (leaf, index) up to, but not including, (endLeaf, endIndex).
+    // A null leaf marks the end of the tree.
+    skBTreeMapIterator(LeafPointerType leaf,
+                       SKuint32        index,
+                       LeafPointerType endLeaf  = nullptr,
+                       SKuint32        endIndex = 0) :
+        m_leaf(leaf),
+        m_index(index),
+        m_endLeaf(endLeaf),
+        m_endIndex(endIndex)
+    {
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_leaf != nullptr && (m_leaf != m_endLeaf || m_index != m_endIndex);
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        if (++m_index >= m_leaf->m_count)
+        {
+            m_leaf  = m_leaf->m_next;
+            m_index = 0;
+        }
+    }
+
+    // Keys are never writable, since changing one would break the order.
+    const PairKeyType& peekNextKey(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_leaf->m_keys[m_index];
+    }
+
+    PairValueType& peekNextValue(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_leaf->m_values[m_index];
+    }
+
+    const PairValueType& peekNextValue(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_leaf->m_values[m_index];
+    }
+};
+
+// Ordered map stored as a B+tree.
+//
+// Keys in each node are contiguous and sized to span a few cache lines,
+// so a lookup touches a handful of nodes instead of one per level of a
+// binary tree. Values live only in the leaves, which are linked so range
+// scans walk forward without returning to the inner nodes.
+//
+// Keys must be default constructible, copyable and ordered with operator<.
+template <typename Key, typename Value>
+class skBTreeMap
+{
+public:
+    typedef skBTreeMap<Key, Value> SelfType;
+    typedef Key                    PairKeyType;
+    typedef Value                  PairValueType;
+
+    enum
+    {
+        // Aim for four cache lines of keys per node.
+        NodeBytes = 4 * SK_CACHE_LINE,
+        Order     = NodeBytes / sizeof(Key) < 8     ? 8
+                    : NodeBytes / sizeof(Key) > 128 ? 128
+                                                    : NodeBytes / sizeof(Key),
+    };
+
+    struct Leaf
+    {
+        SKuint32 m_count;
+        Leaf*    m_next;
+        Leaf*    m_prev;
+        Key      m_keys[Order + 1];
+        Value    m_values[Order + 1];
+
+        Leaf() :
+            m_count(0),
+            m_next(nullptr),
+            m_prev(nullptr)
+        {
+        }
+    };
+
+    struct Inner
+    {
+        SKuint32 m_count;
+        Key      m_keys[Order + 1];
+        void*    m_children[Order + 2];
+
+        Inner() :
+            m_count(0)
+        {
+        }
+    };
+
+    typedef Leaf*                        LeafPointerType;
+    typedef Inner*                       InnerPointerType;
+    typedef skBTreeMapIterator<SelfType> Iterator;
+    typedef const Iterator               ConstIterator;
+
+private:
+    typedef skPoolAllocator<Leaf, 16>  LeafAllocator;
+    typedef skPoolAllocator<Inner, 16> InnerAllocator;
+
+    enum InsertResult
+    {
+        IR_EXISTS,
+        IR_INSERTED,
+        IR_SPLIT,
+    };
+
+    void*          m_root;
+    SKuint32       m_height;  // 0 when empty, 1 when the root is a leaf
+    SKsize         m_size;
+    Leaf*          m_first;
+    Leaf*          m_last;
+    LeafAllocator  m_leaves;
+    InnerAllocator m_inners;
+
+public:
+    skBTreeMap() :
+        m_root(nullptr),
+        m_height(0),
+        m_size(0),
+        m_first(nullptr),
+        m_last(nullptr)
+    {
+    }
+
+    skBTreeMap(const SelfType& rhs) :
+        m_root(nullptr),
+        m_height(0),
+        m_size(0),
+        m_first(nullptr),
+        m_last(nullptr)
+    {
+        replicate(rhs);
+    }
+
+    ~skBTreeMap()
+    {
+        clear();
+    }
+
+    SelfType& operator=(const SelfType& rhs)
+    {
+        if (this != &rhs)
+            replicate(rhs);
+        return *this;
+    }
+
+    void clear(void)
+    {
+        if (m_root)
+            destroy(m_root, 1);
+
+        m_leaves.release();
+        m_inners.release();
+
+        m_root   = nullptr;
+        m_height = 0;
+        m_size   = 0;
+        m_first  = nullptr;
+        m_last   = nullptr;
+    }
+
+    // Returns false if key is already present.
+    bool insert(const Key& key, const Value& val)
+    {
+        if (!m_root)
+        {
+            m_first = m_last = newLeaf();
+            m_root           = m_first;
+            m_height         = 1;
+        }
+
+        Key   split;
+        void* right  = nullptr;
+        int   result = insertRecursive(m_root, 1, key, val, split, right);
+        if (result == IR_EXISTS)
+            return false;
+
+        if (result == IR_SPLIT)
+        {
+            Inner* root         = newInner();
+            root->m_count       = 1;
+            root->m_keys[0]     = split;
+            root->m_children[0] = m_root;
+            root->m_children[1] = right;
+            m_root              = root;
+            ++m_height;
+        }
+
+        ++m_size;
+        return true;
+    }
+
+    void erase(const Key& key)
+    {
+        remove(key);
+    }
+
+    // Returns false if key was not found.
+    bool remove(const Key& key)
+    {
+        if (!m_root || !removeRecursive(m_root, 1, key))
+            return false;
+
+        --m_size;
+
+        if (m_height > 1)
+        {
+            Inner* root = static_cast<Inner*>(m_root);
+            if (root->m_count == 0)
+            {
+                m_root = root->m_children[0];
+                freeInner(root);
+                --m_height;
+            }
+        }
+        else if (m_size == 0)
+            clear();
+        return true;
+    }
+
+    Value* get(const Key& key)
+    {
+        Leaf*    leaf;
+        SKuint32 index;
+        if (!locate(key, leaf, index))
+            return nullptr;
+        return &leaf->m_values[index];
+    }
+
+    const Value* get(const Key& key) const
+    {
+        return const_cast<SelfType*>(this)->get(key);
+    }
+
+    Value* operator[](const Key& key)
+    {
+        return get(key);
+    }
+
+    const Value* operator[](const Key& key) const
+    {
+        return get(key);
+    }
+
+    bool contains(const Key& key) const
+    {
+        return get(key) != nullptr;
+    }
+
+    // Iterator positioned at key, or an empty iterator when it is absent.
+    ConstIterator find(const Key& key) const
+    {
+        Leaf*    leaf;
+        SKuint32 index;
+        if (!locate(key, leaf, index))
+            return Iterator();
+        return Iterator(leaf, index);
+    }
+
+    // First element not less than key, up to the end of the map.
+    ConstIterator lowerBound(const Key& key) const
+    {
+        Leaf*    leaf;
+        SKuint32 index;
+        bound(key, false, leaf, index);
+        return Iterator(leaf, index);
+    }
+
+    // First element greater than key, up to the end of the map.
+    ConstIterator upperBound(const Key& key) const
+    {
+        Leaf*    leaf;
+        SKuint32 index;
+        bound(key, true, leaf, index);
+        return Iterator(leaf, index);
+    }
+
+    // Elements in [lo, hi).
+    ConstIterator rangeIterator(const Key& lo, const Key& hi) const
+    {
+        Leaf *   first, *last;
+        SKuint32 fi, li;
+        bound(lo, false, first, fi);
+        if (!(lo < hi))
+            return Iterator(first, fi, first, fi);
+
+        bound(hi, false, last, li);
+        return Iterator(first, fi, last, li);
+    }
+
+    ConstIterator iterator(void) const
+    {
+        return Iterator(m_first, 0);
+    }
+
+    // The non-const lookups allow the values to be changed in place.
+    Iterator find(const Key& key)
+    {
+        return static_cast<const SelfType*>(this)->find(key);
+    }
+
+    Iterator lowerBound(const Key& key)
+    {
+        return static_cast<const SelfType*>(this)->lowerBound(key);
+    }
+
+    Iterator upperBound(const Key& key)
+    {
+        return static_cast<const SelfType*>(this)->upperBound(key);
+    }
+
+    Iterator rangeIterator(const Key& lo, const Key& hi)
+    {
+        return static_cast<const SelfType*>(this)->rangeIterator(lo, hi);
+    }
+
+    Iterator iterator(void)
+    {
+        return Iterator(m_first, 0);
+    }
+
+    // Replaces the contents with sorted, unique keys and their values in O(n).
+    // Leaves are filled evenly, then each inner level is built from the one
+    // below it.
+    void bulkLoad(const skArray<Key>& keys, const skArray<Value>& values)
+    {
+        SK_ASSERT(keys.size() == values.size());
+        clear();
+
+        const SKuint32 n = keys.size();
+        if (n == 0)
+            return;
+
+        skArray<void*> level;
+        skArray<Key>   lowKeys;
+
+        SKuint32 nodes = (n + Order - 1) / Order;
+        SKuint32 pos   = 0;
+        level.reserve(nodes);
+        lowKeys.reserve(nodes);
+
+        for (SKuint32 i = 0; i < nodes; ++i)
+        {
+            Leaf* leaf = newLeaf();
+
+            const SKuint32 count = n / nodes + (i < n % nodes ? 1 : 0);
+            for (SKuint32 j = 0; j < count; ++j, ++pos)
+            {
+                SK_ASSERT(pos == 0 || keys[pos - 1] < keys[pos]);
+                leaf->m_keys[j]   = keys[pos];
+                leaf->m_values[j] = values[pos];
+            }
+            leaf->m_count = count;
+
+            leaf->m_prev = m_last;
+            if (m_last)
+                m_last->m_next = leaf;
+            else
+                m_first = leaf;
+            m_last = leaf;
+
+            level.push_back(leaf);
+            lowKeys.push_back(leaf->m_keys[0]);
+        }
+
+        m_height = 1;
+        m_size   = n;
+
+        while (level.size() > 1)
+        {
+            const SKuint32 children = level.size();
+            nodes                   = (children + Order) / (Order + 1);
+
+            skArray<void*> upper;
+            skArray<Key>   upperKeys;
+            upper.reserve(nodes);
+            upperKeys.reserve(nodes);
+
+            pos = 0;
+            for (SKuint32 i = 0; i < nodes; ++i)
+            {
+                Inner* inner = newInner();
+
+                const SKuint32 count = children / nodes + (i < children % nodes ? 1 : 0);
+                upperKeys.push_back(lowKeys[pos]);
+
+                for (SKuint32 j = 0; j < count; ++j, ++pos)
+                {
+                    inner->m_children[j] = level[pos];
+                    if (j > 0)
+                        inner->m_keys[j - 1] = lowKeys[pos];
+                }
+                inner->m_count = count - 1;
+                upper.push_back(inner);
+            }
+
+            level   = upper;
+            lowKeys = upperKeys;
+            ++m_height;
+        }
+
+        m_root = level[0];
+    }
+
+    SKsize size(void) const
+    {
+        return m_size;
+    }
+
+    bool empty(void) const
+    {
+        return m_size == 0;
+    }
+
+    SKuint32 height(void) const
+    {
+        return m_height;
+    }
+
+private:
+    Leaf* newLeaf(void)
+    {
+        return new (m_leaves.allocate_base()) Leaf();
+    }
+
+    Inner* newInner(void)
+    {
+        return new (m_inners.allocate_base()) Inner();
+    }
+
+    void freeLeaf(Leaf* leaf)
+    {
+        m_leaves.deallocate(leaf);
+    }
+
+    void freeInner(Inner* inner)
+    {
+        m_inners.deallocate(inner);
+    }
+
+    void destroy(void* node, SKuint32 depth)
+    {
+        if (depth == m_height)
+            freeLeaf(static_cast<Leaf*>(node));
+        else
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            for (SKuint32 i = 0; i <= inner->m_count; ++i)
+                destroy(inner->m_children[i], depth + 1);
+            freeInner(inner);
+        }
+    }
+
+    void replicate(const SelfType& rhs)
+    {
+        skArray<Key>   keys;
+        skArray<Value> values;
+        keys.reserve((SKuint32)rhs.m_size);
+        values.reserve((SKuint32)rhs.m_size);
+
+        for (Leaf* leaf = rhs.m_first; leaf; leaf = leaf->m_next)
+        {
+            for (SKuint32 i = 0; i < leaf->m_count; ++i)
+            {
+                keys.push_back(leaf->m_keys[i]);
+                values.push_back(leaf->m_values[i]);
+            }
+        }
+        bulkLoad(keys, values);
+    }
+
+    // Index of the first key in keys[0, count) that is not less than key.
+    static SKuint32 lowerIndex(const Key* keys, SKuint32 count, const Key& key)
+    {
+        SKuint32 lo = 0;
+        while (count > 0)
+        {
+            const SKuint32 half = count >> 1;
+            if (keys[lo + half] < key)
+            {
+                lo += half + 1;
+                count -= half + 1;
+            }
+            else
+                count = half;
+        }
+        return lo;
+    }
+
+    // Index of the first key in keys[0, count) that is greater than key.
+    static SKuint32 upperIndex(const Key* keys, SKuint32 count, const Key& key)
+    {
+        SKuint32 lo = 0;
+        while (count > 0)
+        {
+            const SKuint32 half = count >> 1;
+            if (!(key < keys[lo + half]))
+            {
+                lo += half + 1;
+                count -= half + 1;
+            }
+            else
+                count = half;
+        }
+        return lo;
+    }
+
+    Leaf* findLeaf(const Key& key) const
+    {
+        void* node = m_root;
+        for (SKuint32 depth = 1; depth < m_height; ++depth)
+        {
+            Inner* inner = static_cast<Inner*>(node);
+            node         = inner->m_children[upperIndex(inner->m_keys, inner->m_count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    bool locate(const Key& key, Leaf*& leaf, SKuint32& index) const
+    {
+        if (!m_root)
+            return false;
+
+        leaf  = findLeaf(key);
+        index = lowerIndex(leaf->m_keys, leaf->m_count, key);
+        return index < leaf->m_count && !(key < leaf->m_keys[index]);
+    }
+
+    // Normalized so that index always refers to an element, or leaf is null.
+    void bound(const Key& key, bool upper, Leaf*& leaf, SKuint32& index) const
+    {
+        if (!m_root)
+        {
+            leaf  = nullptr;
+            index = 0;
+            return;
+        }
+
+        leaf  = findLeaf(key);
+        index = upper ? upperIndex(leaf->m_keys, leaf->m_count, key)
+                      : lowerIndex(leaf->m_keys, leaf->m_count, key);
+        if (index >= leaf->m_count)
+        {
+            leaf  = leaf->m_next;
+            index = 0;
+        }
+    }
+
+    int insertRecursive(void*        node,
+                        SKuint32     depth,
+                        const Key&   key,
+                        const Value& val,
+                        Key&         split,
+                        void*&       right)
+    {
+        if (depth == m_height)
+        {
+            Leaf*          leaf = static_cast<Leaf*>(node);
+            const SKuint32 pos  = lowerIndex(leaf->m_keys, leaf->m_count, key);
+            if (pos < leaf->m_count && !(key < leaf->m_keys[pos]))
+                return IR_EXISTS;
+
+            for (SKuint32 i = leaf->m_count; i > pos; --i)
+            {
+                leaf->m_keys[i]   = leaf->m_keys[i - 1];
+                leaf->m_values[i] = leaf->m_values[i - 1];
+            }
+            leaf->m_keys[pos]   = key;
+            leaf->m_values[pos] = val;
+            if (++leaf->m_count <= Order)
+                return IR_INSERTED;
+
+            Leaf*          upper = newLeaf();
+            const SKuint32 mid   = leaf->m_count / 2;
+            for (SKuint32 i = mid; i < leaf->m_count; ++i)
+            {
+                upper->m_keys[i - mid]   = leaf->m_keys[i];
+                upper->m_values[i - mid] = leaf->m_values[i];
+            }
+            upper->m_count = leaf->m_count - mid;
+            leaf->m_count  = mid;
+
+            upper->m_next = leaf->m_next;
+            upper->m_prev = leaf;
+            if (leaf->m_next)
+                leaf->m_next->m_prev = upper;
+            else
+                m_last = upper;
+            leaf->m_next = upper;
+
+            split = upper->m_keys[0];
+            right = upper;
+            return IR_SPLIT;
+        }
+
+        Inner*         inner  = static_cast<Inner*>(node);
+        const SKuint32 pos    = upperIndex(inner->m_keys, inner->m_count, key);
+        const int      result = insertRecursive(inner->m_children[pos], depth + 1, key, val, split, right);
+        if (result != IR_SPLIT)
+            return result;
+
+        for (SKuint32 i = inner->m_count; i > pos; --i)
+        {
+            inner->m_keys[i]         = inner->m_keys[i - 1];
+            inner->m_children[i + 1] = inner->m_children[i];
+        }
+        inner->m_keys[pos]         = split;
+        inner->m_children[pos + 1] = right;
+        if (++inner->m_count <= Order)
+            return IR_INSERTED;
+
+        // keys[mid] moves up, keys above it go to the new sibling
+        Inner*         upper = newInner();
+        const SKuint32 mid   = inner->m_count / 2;
+        for (SKuint32 i = mid + 1; i < inner->m_count; ++i)
+        {
+            upper->m_keys[i - mid - 1]     = inner->m_keys[i];
+            upper->m_children[i - mid - 1] = inner->m_children[i];
+        }
+        upper->m_children[inner->m_count - mid - 1] = inner->m_children[inner->m_count];
+        upper->m_count                              = inner->m_count - mid - 1;
+        inner->m_count                              = mid;
+
+        split = inner->m_keys[mid];
+        right = upper;
+        return IR_SPLIT;
+    }
+
+    bool removeRecursive(void* node, SKuint32 depth, const Key& key)
+    {
+        if (depth == m_height)
+        {
+            Leaf*          leaf = static_cast<Leaf*>(node);
+            const SKuint32 pos  = lowerIndex(leaf->m_keys, leaf->m_count, key);
+            if (pos >= leaf->m_count || key < leaf->m_keys[pos])
+                return false;
+
+            for (SKuint32 i = pos + 1; i < leaf->m_count; ++i)
+            {
+                leaf->m_keys[i - 1]   = leaf->m_keys[i];
+                leaf->m_values[i - 1] = leaf->m_values[i];
+            }
+            --leaf->m_count;
+            return true;
+        }
+
+        Inner*         inner = static_cast<Inner*>(node);
+        const SKuint32 pos   = upperIndex(inner->m_keys, inner->m_count, key);
+        if (!removeRecursive(inner->m_children[pos], depth + 1, key))
+            return false;
+
+        if (depth + 1 == m_height)
+        {
+            if (static_cast<Leaf*>(inner->m_children[pos])->m_count < Order / 2)
+                rebalanceLeaf(inner, pos);
+        }
+        else if (static_cast<Inner*>(inner->m_children[pos])->m_count < Order / 2)
+            rebalanceInner(inner, pos);
+        return true;
+    }
+
+    // Removes keys[index] and children[index + 1] from parent.
+    static void removeSeparator(Inner* parent, SKuint32 index)
+    {
+        for (SKuint32 i = index + 1; i < parent->m_count; ++i)
+        {
+            parent->m_keys[i - 1] = parent->m_keys[i];
+            parent->m_children[i] = parent->m_children[i + 1];
+        }
+        --parent->m_count;
+    }
+
+    void rebalanceLeaf(Inner* parent, SKuint32 pos)
+    {
+        Leaf* child = static_cast<Leaf*>(parent->m_children[pos]);
+        Leaf* left  = pos > 0 ? static_cast<Leaf*>(parent->m_children[pos - 1]) : nullptr;
+        Leaf* right = pos < parent->m_count ? static_cast<Leaf*>(parent->m_children[pos + 1]) : nullptr;
+
+        if (left && left->m_count > Order / 2)
+        {
+            for (SKuint32 i = child->m_count; i > 0; --i)
+            {
+                child->m_keys[i]   = child->m_keys[i - 1];
+                child->m_values[i] = child->m_values[i - 1];
+            }
+            --left->m_count;
+            child->m_keys[0]   = left->m_keys[left->m_count];
+            child->m_values[0] = left->m_values[left->m_count];
+            ++child->m_count;
+
+            parent->m_keys[pos - 1] = child->m_keys[0];
+        }
+        else if (right && right->m_count > Order / 2)
+        {
+            child->m_keys[child->m_count]   = right->m_keys[0];
+            child->m_values[child->m_count] = right->m_values[0];
+            ++child->m_count;
+
+            for (SKuint32 i = 1; i < right->m_count; ++i)
+            {
+                right->m_keys[i - 1]   = right->m_keys[i];
+                right->m_values[i - 1] = right->m_values[i];
+            }
+            --right->m_count;
+
+            parent->m_keys[pos] = right->m_keys[0];
+        }
+        else if (left)
+        {
+            mergeLeaves(left, child);
+            removeSeparator(parent, pos - 1);
+        }
+        else if (right)
+        {
+            mergeLeaves(child, right);
+            removeSeparator(parent, pos);
+        }
+    }
+
+    // Appends right to left and frees right.
+    void mergeLeaves(Leaf* left, Leaf* right)
+    {
+        for (SKuint32 i = 0; i < right->m_count; ++i)
+        {
+            left->m_keys[left->m_count]   = right->m_keys[i];
+            left->m_values[left->m_count] = right->m_values[i];
+            ++left->m_count;
+        }
+
+        left->m_next = right->m_next;
+        if (right->m_next)
+            right->m_next->m_prev = left;
+        else
+            m_last = left;
+        freeLeaf(right);
+    }
+
+    void rebalanceInner(Inner* parent, SKuint32 pos)
+    {
+        Inner* child = static_cast<Inner*>(parent->m_children[pos]);
+        Inner* left  = pos > 0 ? static_cast<Inner*>(parent->m_children[pos - 1]) : nullptr;
+        Inner* right = pos < parent->m_count ? static_cast<Inner*>(parent->m_children[pos + 1]) : nullptr;
+
+        if (left && left->m_count > Order / 2)
+        {
+            child->m_children[child->m_count + 1] = child->m_children[child->m_count];
+            for (SKuint32 i = child->m_count; i > 0; --i)
+            {
+                child->m_keys[i]     = child->m_keys[i - 1];
+                child->m_children[i] = child->m_children[i - 1];
+            }
+            child->m_keys[0]     = parent->m_keys[pos - 1];
+            child->m_children[0] = left->m_children[left->m_count];
+            ++child->m_count;
+
+            parent->m_keys[pos - 1] = left->m_keys[left->m_count - 1];
+            --left->m_count;
+        }
+        else if (right && right->m_count > Order / 2)
+        {
+            child->m_keys[child->m_count]         = parent->m_keys[pos];
+            child->m_children[child->m_count + 1] = right->m_children[0];
+            ++child->m_count;
+
+            parent->m_keys[pos] = right->m_keys[0];
+
+            for (SKuint32 i = 1; i < right->m_count; ++i)
+                right->m_keys[i - 1] = right->m_keys[i];
+            for (SKuint32 i = 1; i <= right->m_count; ++i)
+                right->m_children[i - 1] = right->m_children[i];
+            --right->m_count;
+        }
+        else if (left)
+        {
+            mergeInners(left, child, parent->m_keys[pos - 1]);
+            removeSeparator(parent, pos - 1);
+        }
+        else if (right)
+        {
+            mergeInners(child, right, parent->m_keys[pos]);
+            removeSeparator(parent, pos);
+        }
+    }
+
+    // Appends separator and right to left and frees right.
+    void mergeInners(Inner* left, Inner* right, const Key& separator)
+    {
+        left->m_keys[left->m_count] = separator;
+        for (SKuint32 i = 0; i < right->m_count; ++i)
+        {
+            left->m_keys[left->m_count + 1 + i]     = right->m_keys[i];
+            left->m_children[left->m_count + 1 + i] = right->m_children[i];
+        }
+        left->m_children[left->m_count + 1 + right->m_count] = right->m_children[right->m_count];
+        left->m_count += 1 + right->m_count;
+        freeInner(right);
+    }
+};
+
+// Ordered set on top of skBTreeMap, in the same way skHashSet wraps
+// skHashTable.
+template <typename T>
+class skBTreeSet
+{
+public:
+    typedef skBTreeMap<T, bool>          TableType;
+    typedef typename TableType::Iterator Iterator;
+    typedef const Iterator               ConstIterator;
+
+private:
+    TableType m_table;
+
+public:
+    skBTreeSet()
+    {
+    }
+
+    void clear(void)
+    {
+        m_table.clear();
+    }
+
+    bool insert(const T& v)
+    {
+        return m_table.insert(v, true);
+    }
+
+    void erase(const T& v)
+    {
+        m_table.erase(v);
+    }
+
+    bool contains(const T& v) const
+    {
+        return m_table.contains(v);
+    }
+
+    ConstIterator lowerBound(const T& v) const
+    {
+        return m_table.lowerBound(v);
+    }
+
+    ConstIterator upperBound(const T& v) const
+    {
+        return m_table.upperBound(v);
+    }
+
+    ConstIterator rangeIterator(const T& lo, const T& hi) const
+    {
+        return m_table.rangeIterator(lo, hi);
+    }
+
+    ConstIterator iterator(void) const
+    {
+        return m_table.iterator();
+    }
+
+    void bulkLoad(const skArray<T>& keys)
+    {
+        skArray<bool> values;
+        values.resize(keys.size(), true);
+        m_table.bulkLoad(keys, values);
+    }
+
+    SKsize size(void) const
+    {
+        return m_table.size();
+    }
+
+    bool empty(void) const
+    {
+        return m_table.empty();
+    }
+};
+
+#endif  //_skBTreeMap_h_
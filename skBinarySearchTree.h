@@ -1,336 +1,740 @@
-/*
--------------------------------------------------------------------------------
-
-    Copyright (c) Charles Carley.
-
-    Contributor(s): none yet.
-
--------------------------------------------------------------------------------
-  This software is provided 'as-is', without any express or implied
-  warranty. In no event will the authors be held liable for any damages
-  arising from the use of this software.
-
-  Permission is granted to anyone to use this software for any purpose,
-  including commercial applications, and to alter it and redistribute it
-  freely, subject to the following restrictions:
-
-  1. The origin of this software must not be misrepresented; you must not
-     claim that you wrote the original software. If you use this software
-     in a product, an acknowledgment in the product documentation would be
-     appreciated but is not required.
-  2. Altered source versions must be plainly marked as such, and must not be
-     misrepresented as being the original software.
-  3. This notice may not be removed or altered from any source distribution.
--------------------------------------------------------------------------------
-*/
-#ifndef _skBinarySearchTree_h_
-#define _skBinarySearchTree_h_
-
-#include "Config/skConfig.h"
-#include "Utils/skArray.h"
-#include "Utils/skTraits.h"
-
-template <typename T>
-class skBinarySearchTree
-{
-public:
-    SK_DECLARE_TYPE(T)
-
-    class Node
-    {
-    public:
-        Node() :
-            m_left(nullptr),
-            m_right(nullptr)
-        {
-        }
-
-        explicit Node(ConstValueType v) :
-            m_left(nullptr),
-            m_right(nullptr),
-            m_data(v)
-        {
-        }
-
-        ~Node()
-        {
-            destruct();
-        }
-
-        Node* left(void)
-        {
-            return m_left;
-        }
-
-        Node* right(void)
-        {
-            return m_right;
-        }
-
-        ReferenceType data(void)
-        {
-            return m_data;
-        }
-
-    private:
-        friend class skBinarySearchTree;
-
-        Node*     m_left;
-        Node*     m_right;
-        ValueType m_data;
-
-        void destruct(void)
-        {
-            delete m_left;
-            m_left = nullptr;
-
-            delete m_right;
-            m_right = nullptr;
-        }
-    };
-
-    SK_DECLARE_TYPE_NAME(Node, Node)
-
-    typedef skArray<T>               Array;
-    typedef typename Array::Iterator Iterator;
-
-private:
-    NodePointerType m_root;
-    SKsize          m_size;
-    Array           m_array;
-
-public:
-    skBinarySearchTree() :
-        m_root(nullptr),
-        m_size(0)
-    {
-    }
-
-    skBinarySearchTree(const skBinarySearchTree& rhs) :
-        m_root(nullptr),
-        m_size(0)
-    {
-        SK_ASSERT(0 && "TODO");
-    }
-
-    ~skBinarySearchTree()
-    {
-        clear();
-    }
-
-    void clear(void)
-    {
-        delete m_root;
-        m_root = nullptr;
-        m_array.clear();
-    }
-
-    void insert(ConstReferenceType val)
-    {
-        if (m_root == nullptr)
-            m_root = new Node(val);
-        else
-            insert_recursive(m_root, val);
-        m_size++;
-    }
-
-    bool find(ConstReferenceType val) const
-    {
-        if (m_root == nullptr)
-            return false;
-
-        return find_recursive(m_root, val) != nullptr;
-    }
-
-    bool findNonRecursive(ConstReferenceType val) const
-    {
-        if (m_root == nullptr)
-            return false;
-
-        NodePointerType node = m_root;
-        while (node != nullptr)
-        {
-            if (node->m_data == val)
-                return true;
-            if (node->m_data < val)
-                node = node->m_right;
-            else
-                node = node->m_left;
-        }
-        return false;
-    }
-
-    bool findNonRecursive(ReferenceType out, ConstReferenceType val) const
-    {
-        if (m_root == nullptr)
-            return false;
-
-        NodePointerType node = m_root;
-        while (node != nullptr)
-        {
-            if (node->m_data == val)
-            {
-                out = node->m_data;
-                return true;
-            }
-            if (node->m_data < val)
-                node = node->m_right;
-            else
-                node = node->m_left;
-        }
-        return false;
-    }
-
-    void erase(ConstReferenceType val)
-    {
-        if (m_root == nullptr)
-            return;
-
-        m_root = erase_recursive(m_root, val);
-    }
-
-    Iterator iterator_ascending(void)
-    {
-        m_array.resize(0);
-        populate(m_root, false);
-        return m_array.iterator();
-    }
-
-    Iterator iterator_descending(void)
-    {
-        m_array.resize(0);
-        populate(m_root, true);
-        return m_array.iterator();
-    }
-
-    NodePointerType minimum(NodePointerType node = nullptr)
-    {
-        return minimum_recursive(node ? node : m_root);
-    }
-
-    NodePointerType maximum(NodePointerType node = nullptr)
-    {
-        return maximum_recursive(node ? node : m_root);
-    }
-
-    NodePointerType root(void)
-    {
-        return m_root;
-    }
-
-    NodePointerType left(void)
-    {
-        return m_root ? m_root->m_left : nullptr;
-    }
-
-    NodePointerType right(void)
-    {
-        return m_root ? m_root->m_right : nullptr;
-    }
-
-    SKsize size(void) const
-    {
-        return m_size;
-    }
-
-private:
-    NodePointerType minimum_recursive(NodePointerType node)
-    {
-        if (node && node->m_left)
-            return minimum_recursive(node->m_left);
-        return node;
-    }
-
-    NodePointerType maximum_recursive(NodePointerType node)
-    {
-        if (node && node->m_right)
-            return maximum_recursive(node->m_right);
-        return node;
-    }
-
-    void insert_recursive(NodePointerType node, ConstReferenceType val)
-    {
-        if (val < node->m_data)
-        {
-            if (node->m_left)
-                insert_recursive(node->m_left, val);
-            else
-                node->m_left = new Node(val);
-        }
-        else
-        {
-            if (node->m_right)
-                insert_recursive(node->m_right, val);
-            else
-                node->m_right = new Node(val);
-        }
-    }
-
-    NodePointerType find_recursive(NodePointerType node, ConstReferenceType val) const
-    {
-        if (!node)
-            return nullptr;
-
-        if (node->m_data == val)
-            return node;
-
-        if (node->m_data > val)
-            return find_recursive(node->m_left, val);
-
-        return find_recursive(node->m_right, val);
-    }
-
-    NodePointerType erase_recursive(NodePointerType node, ConstReferenceType val)
-    {
-        if (!node)
-            return nullptr;
-
-        if (node->m_data > val)
-            node->m_left = erase_recursive(node->m_left, val);
-        else if (node->m_data < val)
-            node->m_right = erase_recursive(node->m_right, val);
-        else
-            return detach(node);
-        return node;
-    }
-
-    NodePointerType detach(NodePointerType node)
-    {
-        SK_ASSERT(node);
-
-        if (node->m_left == nullptr && node->m_right == nullptr)
-        {
-            --m_size;
-            delete node;
-            node = nullptr;
-        }
-        else if (node->m_left == nullptr || node->m_right == nullptr)
-        {
-            NodePointerType local = node->m_left == nullptr ? node->m_right : node->m_left;
-            node->m_left = node->m_right = nullptr;
-
-            --m_size;
-            delete node;
-            node = local;
-        }
-        else
-        {
-            NodePointerType cur = minimum_recursive(node->m_right);
-            node->m_data        = cur->m_data;
-            node->m_right       = erase_recursive(node->m_right, cur->m_data);
-        }
-        return node;
-    }
-
-    void populate(NodePointerType node, bool descending)
-    {
-        if (!node)
-            return;
-
-        populate(descending ? node->m_right : node->m_left, descending);
-        m_array.push_back(node->m_data);
-        populate(descending ? node->m_left : node->m_right, descending);
-    }
-};
-
-#endif  //_skBinarySearchTree_h_
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBinarySearchTree_h_
+#define _skBinarySearchTree_h_
+
+#include "Config/skConfig.h"
+#include "Utils/skAllocator.h"
+#include "Utils/skArray.h"
+#include "Utils/skTraits.h"
+
+template <typename T>
+class skBinarySearchTreeIterator
+{
+public:
+    typedef typename T::NodePointerType    NodePointerType;
+    typedef typename T::ConstReferenceType ConstReferenceType;
+
+private:
+    mutable NodePointerType m_cur;
+    NodePointerType         m_end;
+
+public:
+    skBinarySearchTreeIterator() :
+        m_cur(nullptr),
+        m_end(nullptr)
+    {
+    }
+
+    // Walks in order from first up to, but not including, end.
+    skBinarySearchTreeIterator(NodePointerType first, NodePointerType end) :
+        m_cur(first),
+        m_end(end)
+    {
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_cur != m_end;
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        m_cur = T::successor(m_cur);
+    }
+
+    // Values are only handed out as const, since changing one in place
+    // would break the order of the tree.
+    ConstReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ConstReferenceType ret = m_cur->data();
+        next();
+        return ret;
+    }
+
+    ConstReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_cur->data();
+    }
+};
+
+// Red-black tree.
+//
+// Insert, erase and find are O(log n) regardless of the insertion order.
+// Nodes keep a parent link so traversal and destruction walk the tree
+// without recursion, and they are carved from a pooled allocator rather
+// than allocated one at a time. Equal values are kept; they are placed to
+// the right of existing ones.
+//
+// Every node also records the size of its subtree, which gives O(log n)
+// rank and select along with the bound and range queries.
+template <typename T>
+class skBinarySearchTree
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    class Node
+    {
+    public:
+        explicit Node(ConstReferenceType v, Node* parent) :
+            m_left(nullptr),
+            m_right(nullptr),
+            m_parent(parent),
+            m_count(1),
+            m_red(true),
+            m_data(v)
+        {
+        }
+
+        Node* left(void)
+        {
+            return m_left;
+        }
+
+        Node* right(void)
+        {
+            return m_right;
+        }
+
+        Node* parent(void)
+        {
+            return m_parent;
+        }
+
+        bool isRed(void) const
+        {
+            return m_red;
+        }
+
+        // The number of nodes in the subtree rooted here.
+        SKsize count(void) const
+        {
+            return m_count;
+        }
+
+        ReferenceType data(void)
+        {
+            return m_data;
+        }
+
+    private:
+        friend class skBinarySearchTree;
+
+        Node*     m_left;
+        Node*     m_right;
+        Node*     m_parent;
+        SKsize    m_count;
+        bool      m_red;
+        ValueType m_data;
+    };
+
+    SK_DECLARE_TYPE_NAME(Node, Node)
+
+    typedef skArray<T>                                     Array;
+    typedef typename Array::Iterator                       Iterator;
+    typedef skPoolAllocator<Node>                          NodeAllocator;
+    typedef skBinarySearchTreeIterator<skBinarySearchTree> RangeIterator;
+
+private:
+    NodePointerType m_root;
+    SKsize          m_size;
+    Array           m_array;
+    NodeAllocator   m_pool;
+
+public:
+    skBinarySearchTree() :
+        m_root(nullptr),
+        m_size(0)
+    {
+    }
+
+    skBinarySearchTree(const skBinarySearchTree& rhs) :
+        m_root(nullptr),
+        m_size(0)
+    {
+        replicate(rhs);
+    }
+
+    ~skBinarySearchTree()
+    {
+        clear();
+    }
+
+    skBinarySearchTree& operator=(const skBinarySearchTree& rhs)
+    {
+        if (this != &rhs)
+            replicate(rhs);
+        return *this;
+    }
+
+    void clear(void)
+    {
+        // post-order walk that detaches each leaf before freeing it
+        NodePointerType node = m_root;
+        while (node)
+        {
+            if (node->m_left)
+                node = node->m_left;
+            else if (node->m_right)
+                node = node->m_right;
+            else
+            {
+                NodePointerType parent = node->m_parent;
+                if (parent)
+                {
+                    if (parent->m_left == node)
+                        parent->m_left = nullptr;
+                    else
+                        parent->m_right = nullptr;
+                }
+                m_pool.deallocate(node);
+                node = parent;
+            }
+        }
+
+        m_pool.release();
+        m_root = nullptr;
+        m_size = 0;
+        m_array.clear();
+    }
+
+    void insert(ConstReferenceType val)
+    {
+        NodePointerType parent = nullptr;
+        NodePointerType cur    = m_root;
+        while (cur)
+        {
+            ++cur->m_count;
+            parent = cur;
+            cur    = val < cur->m_data ? cur->m_left : cur->m_right;
+        }
+
+        NodePointerType node = new (m_pool.allocate_base()) Node(val, parent);
+        if (!parent)
+            m_root = node;
+        else if (val < parent->m_data)
+            parent->m_left = node;
+        else
+            parent->m_right = node;
+
+        insertFixup(node);
+        ++m_size;
+    }
+
+    bool find(ConstReferenceType val) const
+    {
+        return findNode(val) != nullptr;
+    }
+
+    bool findNonRecursive(ConstReferenceType val) const
+    {
+        return findNode(val) != nullptr;
+    }
+
+    bool findNonRecursive(ReferenceType out, ConstReferenceType val) const
+    {
+        NodePointerType node = findNode(val);
+        if (node)
+        {
+            out = node->m_data;
+            return true;
+        }
+        return false;
+    }
+
+    void erase(ConstReferenceType val)
+    {
+        NodePointerType node = findNode(val);
+        if (node)
+            eraseNode(node);
+    }
+
+    Iterator iterator_ascending(void)
+    {
+        m_array.resize(0);
+        m_array.reserve((SKuint32)m_size);
+
+        for (NodePointerType node = minimum(); node; node = successor(node))
+            m_array.push_back(node->m_data);
+        return m_array.iterator();
+    }
+
+    Iterator iterator_descending(void)
+    {
+        m_array.resize(0);
+        m_array.reserve((SKuint32)m_size);
+
+        for (NodePointerType node = maximum(); node; node = predecessor(node))
+            m_array.push_back(node->m_data);
+        return m_array.iterator();
+    }
+
+    NodePointerType minimum(NodePointerType node = nullptr) const
+    {
+        return leftmost(node ? node : m_root);
+    }
+
+    NodePointerType maximum(NodePointerType node = nullptr) const
+    {
+        return rightmost(node ? node : m_root);
+    }
+
+    // In-order neighbours; null past either end.
+    static NodePointerType successor(NodePointerType node)
+    {
+        if (node->m_right)
+            return leftmost(node->m_right);
+
+        NodePointerType parent = node->m_parent;
+        while (parent && node == parent->m_right)
+        {
+            node   = parent;
+            parent = parent->m_parent;
+        }
+        return parent;
+    }
+
+    static NodePointerType predecessor(NodePointerType node)
+    {
+        if (node->m_left)
+            return rightmost(node->m_left);
+
+        NodePointerType parent = node->m_parent;
+        while (parent && node == parent->m_left)
+        {
+            node   = parent;
+            parent = parent->m_parent;
+        }
+        return parent;
+    }
+
+    // First node not less than val, or null.
+    NodePointerType lowerBound(ConstReferenceType val) const
+    {
+        NodePointerType node = m_root, result = nullptr;
+        while (node)
+        {
+            if (node->m_data < val)
+                node = node->m_right;
+            else
+            {
+                result = node;
+                node   = node->m_left;
+            }
+        }
+        return result;
+    }
+
+    // First node greater than val, or null.
+    NodePointerType upperBound(ConstReferenceType val) const
+    {
+        NodePointerType node = m_root, result = nullptr;
+        while (node)
+        {
+            if (val < node->m_data)
+            {
+                result = node;
+                node   = node->m_left;
+            }
+            else
+                node = node->m_right;
+        }
+        return result;
+    }
+
+    // Walks the values in [lo, hi) in ascending order.
+    RangeIterator rangeIterator(ConstReferenceType lo, ConstReferenceType hi) const
+    {
+        if (!(lo < hi))
+            return RangeIterator();
+        return RangeIterator(lowerBound(lo), lowerBound(hi));
+    }
+
+    RangeIterator rangeIterator(void) const
+    {
+        return RangeIterator(minimum(), nullptr);
+    }
+
+    // The number of values less than val.
+    SKsize rank(ConstReferenceType val) const
+    {
+        SKsize          result = 0;
+        NodePointerType node   = m_root;
+        while (node)
+        {
+            if (node->m_data < val)
+            {
+                result += count(node->m_left) + 1;
+                node = node->m_right;
+            }
+            else
+                node = node->m_left;
+        }
+        return result;
+    }
+
+    // The number of values in [lo, hi).
+    SKsize rangeCount(ConstReferenceType lo, ConstReferenceType hi) const
+    {
+        if (!(lo < hi))
+            return 0;
+        return rank(hi) - rank(lo);
+    }
+
+    // The node holding the k-th smallest value, counting from zero,
+    // or null if k is out of range.
+    NodePointerType select(SKsize k) const
+    {
+        NodePointerType node = m_root;
+        while (node)
+        {
+            const SKsize left = count(node->m_left);
+            if (k < left)
+                node = node->m_left;
+            else if (k == left)
+                return node;
+            else
+            {
+                k -= left + 1;
+                node = node->m_right;
+            }
+        }
+        return nullptr;
+    }
+
+    NodePointerType root(void)
+    {
+        return m_root;
+    }
+
+    NodePointerType left(void)
+    {
+        return m_root ? m_root->m_left : nullptr;
+    }
+
+    NodePointerType right(void)
+    {
+        return m_root ? m_root->m_right : nullptr;
+    }
+
+    SKsize size(void) const
+    {
+        return m_size;
+    }
+
+    bool empty(void) const
+    {
+        return m_size == 0;
+    }
+
+private:
+    static SKsize count(NodePointerType node)
+    {
+        return node ? node->m_count : 0;
+    }
+
+    static NodePointerType leftmost(NodePointerType node)
+    {
+        while (node && node->m_left)
+            node = node->m_left;
+        return node;
+    }
+
+    static NodePointerType rightmost(NodePointerType node)
+    {
+        while (node && node->m_right)
+            node = node->m_right;
+        return node;
+    }
+
+    void replicate(const skBinarySearchTree& rhs)
+    {
+        clear();
+        for (NodePointerType node = rhs.minimum(); node; node = rhs.successor(node))
+            insert(node->m_data);
+    }
+
+    NodePointerType findNode(ConstReferenceType val) const
+    {
+        NodePointerType node = m_root;
+        while (node)
+        {
+            if (val < node->m_data)
+                node = node->m_left;
+            else if (node->m_data < val)
+                node = node->m_right;
+            else
+                return node;
+        }
+        return nullptr;
+    }
+
+    void rotateLeft(NodePointerType x)
+    {
+        NodePointerType y = x->m_right;
+
+        x->m_right = y->m_left;
+        if (y->m_left)
+            y->m_left->m_parent = x;
+
+        replace(x, y);
+        y->m_left   = x;
+        x->m_parent = y;
+
+        y->m_count = x->m_count;
+        x->m_count = count(x->m_left) + count(x->m_right) + 1;
+    }
+
+    void rotateRight(NodePointerType x)
+    {
+        NodePointerType y = x->m_left;
+
+        x->m_left = y->m_right;
+        if (y->m_right)
+            y->m_right->m_parent = x;
+
+        replace(x, y);
+        y->m_right  = x;
+        x->m_parent = y;
+
+        y->m_count = x->m_count;
+        x->m_count = count(x->m_left) + count(x->m_right) + 1;
+    }
+
+    // Puts v where u hangs from its parent.
+    void replace(NodePointerType u, NodePointerType v)
+    {
+        if (!u->m_parent)
+            m_root = v;
+        else if (u == u->m_parent->m_left)
+            u->m_parent->m_left = v;
+        else
+            u->m_parent->m_right = v;
+
+        if (v)
+            v->m_parent = u->m_parent;
+    }
+
+    static bool isBlack(NodePointerType node)
+    {
+        return !node || !node->m_red;
+    }
+
+    void insertFixup(NodePointerType node)
+    {
+        while (node != m_root && node->m_parent->m_red)
+        {
+            NodePointerType parent = node->m_parent;
+            NodePointerType grand  = parent->m_parent;
+
+            if (parent == grand->m_left)
+            {
+                NodePointerType uncle = grand->m_right;
+                if (!isBlack(uncle))
+                {
+                    parent->m_red = false;
+                    uncle->m_red  = false;
+                    grand->m_red  = true;
+                    node          = grand;
+                }
+                else
+                {
+                    if (node == parent->m_right)
+                    {
+                        node = parent;
+                        rotateLeft(node);
+                        parent = node->m_parent;
+                    }
+                    parent->m_red = false;
+                    grand->m_red  = true;
+                    rotateRight(grand);
+                }
+            }
+            else
+            {
+                NodePointerType uncle = grand->m_left;
+                if (!isBlack(uncle))
+                {
+                    parent->m_red = false;
+                    uncle->m_red  = false;
+                    grand->m_red  = true;
+                    node          = grand;
+                }
+                else
+                {
+                    if (node == parent->m_left)
+                    {
+                        node = parent;
+                        rotateRight(node);
+                        parent = node->m_parent;
+                    }
+                    parent->m_red = false;
+                    grand->m_red  = true;
+                    rotateLeft(grand);
+                }
+            }
+        }
+        m_root->m_red = false;
+    }
+
+    void eraseNode(NodePointerType node)
+    {
+        NodePointerType child, parent;
+        bool            removedRed = node->m_red;
+
+        // every ancestor of the position that is physically unlinked
+        // loses one node from its subtree
+        NodePointerType vacated = node->m_left && node->m_right ? leftmost(node->m_right) : node;
+        for (NodePointerType p = vacated->m_parent; p; p = p->m_parent)
+            --p->m_count;
+
+        if (!node->m_left)
+        {
+            child  = node->m_right;
+            parent = node->m_parent;
+            replace(node, child);
+        }
+        else if (!node->m_right)
+        {
+            child  = node->m_left;
+            parent = node->m_parent;
+            replace(node, child);
+        }
+        else
+        {
+            // splice the successor into node's place
+            NodePointerType next = minimum(node->m_right);
+            removedRed           = next->m_red;
+            child                = next->m_right;
+
+            if (next->m_parent == node)
+                parent = next;
+            else
+            {
+                parent = next->m_parent;
+                replace(next, next->m_right);
+                next->m_right           = node->m_right;
+                next->m_right->m_parent = next;
+            }
+
+            replace(node, next);
+            next->m_left           = node->m_left;
+            next->m_left->m_parent = next;
+            next->m_red            = node->m_red;
+            next->m_count          = node->m_count;
+        }
+
+        m_pool.deallocate(node);
+        --m_size;
+
+        if (!removedRed)
+            eraseFixup(child, parent);
+    }
+
+    void eraseFixup(NodePointerType node, NodePointerType parent)
+    {
+        while (node != m_root && isBlack(node))
+        {
+            if (node == parent->m_left)
+            {
+                NodePointerType sibling = parent->m_right;
+                if (sibling->m_red)
+                {
+                    sibling->m_red = false;
+                    parent->m_red  = true;
+                    rotateLeft(parent);
+                    sibling = parent->m_right;
+                }
+
+                if (isBlack(sibling->m_left) && isBlack(sibling->m_right))
+                {
+                    sibling->m_red = true;
+                    node           = parent;
+                    parent         = node->m_parent;
+                }
+                else
+                {
+                    if (isBlack(sibling->m_right))
+                    {
+                        sibling->m_left->m_red = false;
+                        sibling->m_red         = true;
+                        rotateRight(sibling);
+                        sibling = parent->m_right;
+                    }
+                    sibling->m_red = parent->m_red;
+                    parent->m_red  = false;
+                    if (sibling->m_right)
+                        sibling->m_right->m_red = false;
+                    rotateLeft(parent);
+                    node = m_root;
+                }
+            }
+            else
+            {
+                NodePointerType sibling = parent->m_left;
+                if (sibling->m_red)
+                {
+                    sibling->m_red = false;
+                    parent->m_red  = true;
+                    rotateRight(parent);
+                    sibling = parent->m_left;
+                }
+
+                if (isBlack(sibling->m_left) && isBlack(sibling->m_right))
+                {
+                    sibling->m_red = true;
+                    node           = parent;
+                    parent         = node->m_parent;
+                }
+                else
+                {
+                    if (isBlack(sibling->m_left))
+                    {
+                        sibling->m_right->m_red = false;
+                        sibling->m_red          = true;
+                        rotateLeft(sibling);
+                        sibling = parent->m_left;
+                    }
+                    sibling->m_red = parent->m_red;
+                    parent->m_red  = false;
+                    if (sibling->m_left)
+                        sibling->m_left->m_red = false;
+                    rotateRight(parent);
+                    node = m_root;
+                }
+            }
+        }
+
+        if (node)
+            node->m_red = false;
+    }
+};
+
+#endif  //_skBinarySearchTree_h_
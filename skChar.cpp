@@ -32,11 +32,7 @@
 #include <cstring>
 #include <limits>
 #include "skString.h"
-
-SKsize skChar::length(const char* in)
-{
-    return in && *in ? (SKsize)strlen(in) : 0;
-}
+#include "skStringView.h"
 
 void skChar::copy(char* dest, const char* src)
 {
@@ -79,100 +75,148 @@ SKsize skChar::equalsn(const char* a, const char* b, const SKsize max)
     return (SKsize)(size_t)strncmp(a, b, (size_t)max);
 }
 
+// Parses and saturates to the range of T, which is what strtoll
+// followed by a range check used to give.
+template <typename T>
+static T skParseSigned(const char* in, SKsize len, int base)
+{
+    SKint64 v;
+    skChar::parse(in, len, v, base);
+    return (T)skClamp<SKint64>(v, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+}
+
+template <typename T>
+static T skParseUnsigned(const char* in, SKsize len, int base)
+{
+    SKuint64 v;
+    skChar::parse(in, len, v, base);
+    return (T)skMin<SKuint64>(v, std::numeric_limits<T>::max());
+}
+
 SKint16 skChar::toInt16(const char* in, SKint16 def, int base)
 {
     if (in && *in)
-    {
-        const long long v = std::strtoll(in, nullptr, base);
-        if (v > std::numeric_limits<SKint16>::max())
-            return std::numeric_limits<SKint16>::max();
-        if (v < std::numeric_limits<SKint16>::min())
-            return std::numeric_limits<SKint16>::min();
-        return (SKint16)v;
-    }
+        return skParseSigned<SKint16>(in, length(in), base);
     return def;
 }
 
 SKint32 skChar::toInt32(const char* in, SKint32 def, int base)
 {
     if (in && *in)
-    {
-        const long long v = std::strtoll(in, nullptr, base);
-        if (v > std::numeric_limits<SKint32>::max())
-            return std::numeric_limits<SKint32>::max();
-        if (v < std::numeric_limits<SKint32>::min())
-            return std::numeric_limits<SKint32>::min();
-        return (SKint32)v;
-    }
+        return skParseSigned<SKint32>(in, length(in), base);
     return def;
 }
 
 SKint64 skChar::toInt64(const char* in, SKint64 def, int base)
 {
     if (in && *in)
-        return (SKint64)std::strtoll(in, nullptr, base);
+        return skParseSigned<SKint64>(in, length(in), base);
     return def;
 }
 
 SKuint16 skChar::toUint16(const char* in, SKuint16 def, int base)
 {
     if (in && *in)
-    {
-        const unsigned long long v = std::strtoull(in, nullptr, base);
-        if (v > std::numeric_limits<SKuint16>::max())
-            return std::numeric_limits<SKuint16>::max();
-        return (SKuint16)v;
-    }
+        return skParseUnsigned<SKuint16>(in, length(in), base);
     return def;
 }
 
 SKuint32 skChar::toUint32(const char* in, SKuint32 def, int base)
 {
     if (in && *in)
-    {
-        const unsigned long long v = std::strtoull(in, nullptr, base);
-        if (v > std::numeric_limits<SKuint32>::max())
-            return std::numeric_limits<SKuint32>::max();
-        return (SKuint32)v;
-    }
+        return skParseUnsigned<SKuint32>(in, length(in), base);
     return def;
 }
 
 SKuint64 skChar::toUint64(const char* in, SKuint64 def, int base)
 {
     if (in && *in)
-        return (SKuint64)std::strtoull(in, nullptr, base);
+        return skParseUnsigned<SKuint64>(in, length(in), base);
     return def;
 }
 
 SKint16 skChar::toInt16(const skString& in, SKint16 def, int base)
 {
-    return toInt16(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseSigned<SKint16>(in.c_str(), in.size(), base);
+    return def;
 }
 
 SKint32 skChar::toInt32(const skString& in, SKint32 def, int base)
 {
-    return toInt32(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseSigned<SKint32>(in.c_str(), in.size(), base);
+    return def;
 }
 
 SKint64 skChar::toInt64(const skString& in, SKint64 def, int base)
 {
-    return toInt64(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseSigned<SKint64>(in.c_str(), in.size(), base);
+    return def;
 }
 
 SKuint16 skChar::toUint16(const skString& in, SKuint16 def, int base)
 {
-    return toUint16(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseUnsigned<SKuint16>(in.c_str(), in.size(), base);
+    return def;
 }
 
 SKuint32 skChar::toUint32(const skString& in, SKuint32 def, int base)
 {
-    return toUint32(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseUnsigned<SKuint32>(in.c_str(), in.size(), base);
+    return def;
 }
 
 SKuint64 skChar::toUint64(const skString& in, SKuint64 def, int base)
 {
-    return toUint64(in.c_str(), def, base);
+    if (!in.empty())
+        return skParseUnsigned<SKuint64>(in.c_str(), in.size(), base);
+    return def;
+}
+
+SKint16 skChar::toInt16(const skStringView& in, SKint16 def, int base)
+{
+    if (!in.empty())
+        return skParseSigned<SKint16>(in.ptr(), in.size(), base);
+    return def;
+}
+
+SKint32 skChar::toInt32(const skStringView& in, SKint32 def, int base)
+{
+    if (!in.empty())
+        return skParseSigned<SKint32>(in.ptr(), in.size(), base);
+    return def;
+}
+
+SKint64 skChar::toInt64(const skStringView& in, SKint64 def, int base)
+{
+    if (!in.empty())
+        return skParseSigned<SKint64>(in.ptr(), in.size(), base);
+    return def;
+}
+
+SKuint16 skChar::toUint16(const skStringView& in, SKuint16 def, int base)
+{
+    if (!in.empty())
+        return skParseUnsigned<SKuint16>(in.ptr(), in.size(), base);
+    return def;
+}
+
+SKuint32 skChar::toUint32(const skStringView& in, SKuint32 def, int base)
+{
+    if (!in.empty())
+        return skParseUnsigned<SKuint32>(in.ptr(), in.size(), base);
+    return def;
+}
+
+SKuint64 skChar::toUint64(const skStringView& in, SKuint64 def, int base)
+{
+    if (!in.empty())
+        return skParseUnsigned<SKuint64>(in.ptr(), in.size(), base);
+    return def;
 }
 
 bool skChar::isNullOrEmpty(const char* in)
@@ -203,14 +247,22 @@ bool skChar::toBool(const char* in)
 float skChar::toFloat(const char* in, const float& def)
 {
     if (in && *in)
-        return std::strtof(in, nullptr);
+    {
+        float v;
+        parse(in, length(in), v);
+        return v;
+    }
     return def;
 }
 
 double skChar::toDouble(const char* in, const double& def)
 {
     if (in && *in)
-        return std::strtod(in, nullptr);
+    {
+        double v;
+        parse(in, length(in), v);
+        return v;
+    }
     return def;
 }
 
@@ -221,29 +273,67 @@ bool skChar::toBool(const skString& in)
 
 float skChar::toFloat(const skString& in, const float& def)
 {
-    return toFloat(in.c_str(), def);
+    if (!in.empty())
+    {
+        float v;
+        parse(in.c_str(), in.size(), v);
+        return v;
+    }
+    return def;
 }
 
 double skChar::toDouble(const skString& in, const double& def)
 {
-    return toDouble(in.c_str(), def);
+    if (!in.empty())
+    {
+        double v;
+        parse(in.c_str(), in.size(), v);
+        return v;
+    }
+    return def;
+}
+
+bool skChar::toBool(const skStringView& in)
+{
+    return in.startsWith(skStringView("true", 4)) ||
+           in.startsWith(skStringView("yes", 3)) ||
+           in.startsWith(skStringView("1", 1));
+}
+
+float skChar::toFloat(const skStringView& in, const float& def)
+{
+    if (!in.empty())
+    {
+        float v;
+        parse(in.ptr(), in.size(), v);
+        return v;
+    }
+    return def;
+}
+
+double skChar::toDouble(const skStringView& in, const double& def)
+{
+    if (!in.empty())
+    {
+        double v;
+        parse(in.ptr(), in.size(), v);
+        return v;
+    }
+    return def;
 }
 
 void skChar::toString(skString& dest, float v)
 {
-    const double d = (double)v;
-    dest.reserve(32);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%f", d);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxFloatChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, v));
 }
 
 void skChar::toString(skString& dest, double v)
 {
-    dest.reserve(32);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%f", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxFloatChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, v));
 }
 
 void skChar::toString(skString& dest, bool v)
@@ -258,50 +348,44 @@ void skChar::toString(skString& dest, bool v)
 
 void skChar::toString(skString& dest, SKint16 v)
 {
-    dest.reserve(7);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%d", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKint64)v));
 }
 
 void skChar::toString(skString& dest, SKint32 v)
 {
-    dest.reserve(12);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%d", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKint64)v));
 }
 
 void skChar::toString(skString& dest, SKint64 v)
 {
-    dest.reserve(21);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%lld", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKint64)v));
 }
 
 void skChar::toString(skString& dest, SKuint16 v)
 {
-    dest.reserve(16);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%u", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKuint64)v));
 }
 
 void skChar::toString(skString& dest, SKuint32 v)
 {
-    dest.reserve(24);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%u", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKuint64)v));
 }
 
 void skChar::toString(skString& dest, SKuint64 v)
 {
-    dest.reserve(32);
-    const int size = snprintf(dest.ptr(), dest.capacity(), "%llu", v);
-    if (size < (int)dest.capacity() && size > 0)
-        dest.resize(size);
+    char buf[MaxIntegerChars];
+    dest.resize(0);
+    dest.append(buf, toChars(buf, (SKuint64)v));
 }
 
 skString skChar::toString(float v)
@@ -29,10 +29,29 @@
 #include "Utils/Config/skConfig.h"
 
 class skString;
+class skStringView;
 
 class skChar
 {
 public:
+    // Instruction sets the search and compare kernels can dispatch to.
+    enum SimdLevel
+    {
+        SL_SCALAR,
+        SL_SSE2,
+        SL_AVX2,
+    };
+
+    // Returns the best level the running CPU supports.
+    static SimdLevel supportedSimdLevel();
+
+    // Returns the level the kernels currently dispatch to.
+    static SimdLevel simdLevel();
+
+    // Lowers the kernel level, clamped to supportedSimdLevel().
+    // Intended for testing and benchmarking each code path.
+    static void setSimdLevel(SimdLevel level);
+
     static SKsize length(const char* in);
 
     static void copy(char* dest, const char* src);
@@ -43,6 +62,68 @@ public:
 
     static SKsize equalsn(const char* a, const char* b, SKsize max);
 
+    // Returns the offset of the first ch in str[0, len), or SK_NPOS.
+    static SKsize find(const char* str, SKsize len, char ch);
+
+    // Returns the offset of the first sub[0, subLen) in str[0, len), or SK_NPOS.
+    // An empty sub is found at zero.
+    static SKsize find(const char* str, SKsize len, const char* sub, SKsize subLen);
+
+    // Orders len bytes the same way memcmp does.
+    static int compare(const char* a, const char* b, SKsize len);
+
+    // Like compare, with ASCII letters folded to lower case.
+    static int compareNoCase(const char* a, const char* b, SKsize len);
+
+    // Outcome of the parse functions.
+    enum ParseResult
+    {
+        PR_OK,
+        PR_EMPTY,     // No digits were found, the value is zero.
+        PR_OVERFLOW,  // The value did not fit and was saturated.
+    };
+
+    // The most characters toChars writes for an integer or a float.
+    enum
+    {
+        MaxIntegerChars = 20,
+        MaxFloatChars   = 32,
+    };
+
+    // Parses an integer in the given base from str[0, len) without any
+    // locale handling. Leading white space, a sign and, in base 16, a 0x
+    // prefix are accepted, and base 0 picks the base from the prefix as
+    // strtoll does. Parsing stops at the first character that is not a
+    // digit; when end is given it receives that offset.
+    static ParseResult parse(const char* str, SKsize len, SKint64& dest, int base = 10, SKsize* end = nullptr);
+
+    // Like the signed parse. A leading minus negates the value modulo
+    // 2^64, as strtoull does.
+    static ParseResult parse(const char* str, SKsize len, SKuint64& dest, int base = 10, SKsize* end = nullptr);
+
+    // Writes the decimal digits of v to dest, which must have room for
+    // MaxIntegerChars characters, and returns how many were written. The
+    // result is not terminated.
+    static SKsize toChars(char* dest, SKuint64 v);
+
+    static SKsize toChars(char* dest, SKint64 v);
+
+    // Parses a floating point number from str[0, len) without any locale
+    // handling: white space, a sign, digits with an optional '.', an
+    // optional exponent, a hexadecimal float such as 0x1.8p3, or inf,
+    // infinity and nan in any case. The result is the correctly rounded
+    // nearest value. Out of range values give an infinity and PR_OVERFLOW.
+    static ParseResult parse(const char* str, SKsize len, double& dest, SKsize* end = nullptr);
+
+    static ParseResult parse(const char* str, SKsize len, float& dest, SKsize* end = nullptr);
+
+    // Writes the fewest digits that parse back to exactly v, in plain
+    // notation for moderate exponents and as d.ddde+x otherwise. dest
+    // must have room for MaxFloatChars characters and is not terminated.
+    static SKsize toChars(char* dest, double v);
+
+    static SKsize toChars(char* dest, float v);
+
     [[deprecated]] static SKint32 toInt(const char* in, SKint32 def = -1, int base = 10)
     {
         return toInt32(in, def, base);
@@ -77,6 +158,18 @@ public:
 
     static SKuint64 toUint64(const skString& in, SKuint64 def = SK_NPOS, int base = 10);
 
+    static SKint16 toInt16(const skStringView& in, SKint16 def = -1, int base = 10);
+
+    static SKint32 toInt32(const skStringView& in, SKint32 def = -1, int base = 10);
+
+    static SKint64 toInt64(const skStringView& in, SKint64 def = -1, int base = 10);
+
+    static SKuint16 toUint16(const skStringView& in, SKuint16 def = SK_NPOS16, int base = 10);
+
+    static SKuint32 toUint32(const skStringView& in, SKuint32 def = SK_NPOS32, int base = 10);
+
+    static SKuint64 toUint64(const skStringView& in, SKuint64 def = SK_NPOS, int base = 10);
+
     static bool isNullOrEmpty(const char* in);
 
     static bool toBool(const char* in);
@@ -91,6 +184,12 @@ public:
 
     static double toDouble(const skString& in, const double& def = 0.0);
 
+    static bool toBool(const skStringView& in);
+
+    static float toFloat(const skStringView& in, const float& def = 0.f);
+
+    static double toDouble(const skStringView& in, const double& def = 0.0);
+
     static void toString(skString& dest, float v);
 
     static void toString(skString& dest, double v);
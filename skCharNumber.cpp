@@ -0,0 +1,294 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstring>
+#include "Utils/skChar.h"
+#include "Utils/skMinMax.h"
+
+namespace
+{
+    // Two characters for each value in [0, 100).
+    const char DigitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    const SKuint64 PowersOf10[20] = {
+        0,  // Makes countDigits(0) come out as one.
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+        10000000000ULL,
+        100000000000ULL,
+        1000000000000ULL,
+        10000000000000ULL,
+        100000000000000ULL,
+        1000000000000000ULL,
+        10000000000000000ULL,
+        100000000000000000ULL,
+        1000000000000000000ULL,
+        10000000000000000000ULL,
+    };
+
+    // The value of each character as a digit, or 0xFF.
+    struct DigitTable
+    {
+        SKuint8 value[256];
+
+        DigitTable()
+        {
+            memset(value, 0xFF, sizeof value);
+            for (int i = 0; i < 10; ++i)
+                value['0' + i] = (SKuint8)i;
+            for (int i = 0; i < 26; ++i)
+                value['a' + i] = value['A' + i] = (SKuint8)(10 + i);
+        }
+    };
+
+    const DigitTable Digits;
+
+    SKuint32 digitValue(char ch)
+    {
+        return Digits.value[(SKuint8)ch];
+    }
+
+    SKsize countDigits(SKuint64 v)
+    {
+        // log10(2) ~= 1233 / 4096 gives the count to within one.
+        const SKuint32 t = ((64 - skLeadingZeros(v | 1)) * 1233) >> 12;
+        return t - (v < PowersOf10[t]) + 1;
+    }
+
+    // Writes the digits of v so that the last one lands before end.
+    void writeDigits(char* end, SKuint64 v)
+    {
+        while (v >= 100)
+        {
+            const SKuint32 pair = (SKuint32)(v % 100) * 2;
+            v /= 100;
+            *--end = DigitPairs[pair + 1];
+            *--end = DigitPairs[pair];
+        }
+
+        if (v >= 10)
+        {
+            const SKuint32 pair = (SKuint32)v * 2;
+            *--end = DigitPairs[pair + 1];
+            *--end = DigitPairs[pair];
+        }
+        else
+            *--end = (char)('0' + v);
+    }
+
+#if SK_ENDIAN == SK_ENDIAN_LITTLE
+    SKuint64 load8(const char* str)
+    {
+        SKuint64 v;
+        memcpy(&v, str, sizeof v);
+        return v;
+    }
+
+    // True when all eight bytes are in ['0', '9'].
+    bool isEightDigits(SKuint64 v)
+    {
+        return ((v & 0xF0F0F0F0F0F0F0F0ULL) |
+                (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+               0x3333333333333333ULL;
+    }
+
+    // Combines eight digits, first one in the lowest byte, by joining
+    // neighbouring pairs, then quads, then halves.
+    SKuint32 parseEightDigits(SKuint64 v)
+    {
+        v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+        v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+        v = ((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+        return (SKuint32)v;
+    }
+#endif
+
+    bool isSpace(char ch)
+    {
+        return ch == ' ' || (ch >= '\t' && ch <= '\r');
+    }
+
+    // Parses the magnitude after white space, a sign and a base prefix.
+    skChar::ParseResult parseMagnitude(const char* str,
+                                       SKsize      len,
+                                       SKuint64&   dest,
+                                       bool&       negative,
+                                       int         base,
+                                       SKsize*     end)
+    {
+        dest     = 0;
+        negative = false;
+
+        SKsize i = 0;
+        while (i < len && isSpace(str[i]))
+            ++i;
+
+        if (i < len && (str[i] == '-' || str[i] == '+'))
+            negative = str[i++] == '-';
+
+        const bool hasPrefix = len - i > 2 && str[i] == '0' &&
+                               (str[i + 1] | 0x20) == 'x' && digitValue(str[i + 2]) < 16;
+
+        if (base == 0)
+            base = hasPrefix ? 16 : i < len && str[i] == '0' ? 8 : 10;
+        if (base == 16 && hasPrefix)
+            i += 2;
+
+        if (base < 2 || base > 36)
+        {
+            if (end)
+                *end = 0;
+            return skChar::PR_EMPTY;
+        }
+
+        const SKsize first = i;
+        SKuint64     v     = 0;
+
+#if SK_ENDIAN == SK_ENDIAN_LITTLE
+        if (base == 10)
+        {
+            // Below 10^11, adding eight more digits stays under 10^19.
+            while (len - i >= 8 && v < 100000000000ULL)
+            {
+                const SKuint64 chunk = load8(str + i);
+                if (!isEightDigits(chunk))
+                    break;
+                v = v * 100000000 + parseEightDigits(chunk);
+                i += 8;
+            }
+        }
+#endif
+
+        const SKuint64 limit    = (SKuint64)-1 / (SKuint32)base;
+        const SKuint32 limitRem = (SKuint32)((SKuint64)-1 % (SKuint32)base);
+        bool           overflow = false;
+
+        SKuint32 d;
+        while (i < len && (d = digitValue(str[i])) < (SKuint32)base)
+        {
+            if (v > limit || (v == limit && d > limitRem))
+                overflow = true;
+            else
+                v = v * (SKuint32)base + d;
+            ++i;
+        }
+
+        if (end)
+            *end = i == first ? 0 : i;
+
+        if (i == first)
+            return skChar::PR_EMPTY;
+
+        if (overflow)
+        {
+            dest = (SKuint64)-1;
+            return skChar::PR_OVERFLOW;
+        }
+
+        dest = v;
+        return skChar::PR_OK;
+    }
+}  // namespace
+
+skChar::ParseResult skChar::parse(const char* str, SKsize len, SKint64& dest, int base, SKsize* end)
+{
+    SKuint64 magnitude;
+    bool     negative;
+
+    dest = 0;
+    if (!str)
+    {
+        if (end)
+            *end = 0;
+        return PR_EMPTY;
+    }
+
+    ParseResult result = parseMagnitude(str, len, magnitude, negative, base, end);
+    if (result == PR_EMPTY)
+        return result;
+
+    const SKuint64 limit = negative ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL;
+    if (result == PR_OVERFLOW || magnitude > limit)
+    {
+        magnitude = limit;
+        result    = PR_OVERFLOW;
+    }
+
+    // Negating in unsigned arithmetic keeps the smallest value.
+    dest = negative ? (SKint64)(0 - magnitude) : (SKint64)magnitude;
+    return result;
+}
+
+skChar::ParseResult skChar::parse(const char* str, SKsize len, SKuint64& dest, int base, SKsize* end)
+{
+    bool negative;
+
+    dest = 0;
+    if (!str)
+    {
+        if (end)
+            *end = 0;
+        return PR_EMPTY;
+    }
+
+    const ParseResult result = parseMagnitude(str, len, dest, negative, base, end);
+    if (result == PR_OK && negative)
+        dest = 0 - dest;
+    return result;
+}
+
+SKsize skChar::toChars(char* dest, SKuint64 v)
+{
+    const SKsize len = countDigits(v);
+    writeDigits(dest + len, v);
+    return len;
+}
+
+SKsize skChar::toChars(char* dest, SKint64 v)
+{
+    if (v < 0)
+    {
+        *dest = '-';
+        return toChars(dest + 1, 0 - (SKuint64)v) + 1;
+    }
+    return toChars(dest, (SKuint64)v);
+}
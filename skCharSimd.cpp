@@ -0,0 +1,722 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <atomic>
+#include <cstring>
+#include "Utils/skChar.h"
+#include "Utils/skMinMax.h"
+
+#if defined(SK_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define SK_AVX2_DISPATCH 1
+#include <immintrin.h>
+#elif defined(SK_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SK_TARGET_AVX2 __attribute__((target("avx2")))
+#define SK_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define SK_TARGET_AVX2
+#define SK_NO_SANITIZE
+#endif
+
+// The length kernels read whole aligned vectors and may look at bytes
+// past the terminator. Aligned reads never cross into the next page, so
+// they cannot fault, but the address sanitizer still reports them;
+// SK_NO_SANITIZE opts those kernels out.
+
+struct skCharKernels
+{
+    SKsize (*length)(const char* in);
+    SKsize (*findChar)(const char* str, SKsize len, char ch);
+    SKsize (*findString)(const char* str, SKsize len, const char* sub, SKsize subLen);
+    int (*compare)(const char* a, const char* b, SKsize len);
+    int (*compareNoCase)(const char* a, const char* b, SKsize len);
+};
+
+static SK_INLINE int skFold(SKuint8 c)
+{
+    return c >= 'A' && c <= 'Z' ? c | 0x20 : c;
+}
+
+static SK_INLINE int skByteDifference(const char* a, const char* b, SKsize i)
+{
+    return (int)(SKuint8)a[i] - (int)(SKuint8)b[i];
+}
+
+// ----------------------------------------------------------------------------
+// Scalar kernels, the C library where it has an equivalent.
+
+static SKsize skLengthScalar(const char* in)
+{
+    return (SKsize)strlen(in);
+}
+
+static SKsize skFindCharScalar(const char* str, SKsize len, char ch)
+{
+    const void* ptr = memchr(str, (int)(SKuint8)ch, len);
+    return ptr ? (SKsize)((const char*)ptr - str) : SK_NPOS;
+}
+
+// Searches from start onward. Shared with the vector kernels, which use
+// it for the tail they cannot cover with whole loads.
+static SKsize skFindStringFrom(const char* str, SKsize len, const char* sub, SKsize subLen, SKsize start)
+{
+    const SKsize last = len - subLen;
+    for (SKsize i = start; i <= last;)
+    {
+        const void* ptr = memchr(str + i, (int)(SKuint8)sub[0], last - i + 1);
+        if (!ptr)
+            break;
+
+        i = (SKsize)((const char*)ptr - str);
+        if (memcmp(str + i + 1, sub + 1, subLen - 1) == 0)
+            return i;
+        ++i;
+    }
+    return SK_NPOS;
+}
+
+static SKsize skFindStringScalar(const char* str, SKsize len, const char* sub, SKsize subLen)
+{
+    return skFindStringFrom(str, len, sub, subLen, 0);
+}
+
+static int skCompareScalar(const char* a, const char* b, SKsize len)
+{
+    return memcmp(a, b, len);
+}
+
+static int skCompareNoCaseFrom(const char* a, const char* b, SKsize len, SKsize start)
+{
+    for (SKsize i = start; i < len; ++i)
+    {
+        const int d = skFold((SKuint8)a[i]) - skFold((SKuint8)b[i]);
+        if (d != 0)
+            return d;
+    }
+    return 0;
+}
+
+static int skCompareNoCaseScalar(const char* a, const char* b, SKsize len)
+{
+    return skCompareNoCaseFrom(a, b, len, 0);
+}
+
+static const skCharKernels ScalarKernels = {
+    skLengthScalar,
+    skFindCharScalar,
+    skFindStringScalar,
+    skCompareScalar,
+    skCompareNoCaseScalar,
+};
+
+#ifdef SK_SSE2
+
+// ----------------------------------------------------------------------------
+// SSE2 kernels, 16 bytes per compare.
+
+static SK_INLINE SKuint32 skMask(__m128i v)
+{
+    return (SKuint32)_mm_movemask_epi8(v);
+}
+
+// Sets 0x20 in the bytes holding 'A' through 'Z'. Adding 0x80 - 'A'
+// moves the upper case range to the bottom of the signed range, so a
+// single signed compare selects it.
+static SK_INLINE __m128i skFoldSse2(__m128i v)
+{
+    const __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    const __m128i upper   = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+SK_NO_SANITIZE static SKsize skLengthSse2(const char* in)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    // Aligned loads never straddle a page.
+    const SKuint32 offs  = (SKuint32)((SKuintPtr)in & 15);
+    const char*    block = in - offs;
+
+    SKuint32 mask = skMask(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)block), zero)) >> offs;
+    if (mask)
+        return skTrailingZeros(mask);
+
+    for (block += 16; (SKuintPtr)block & 63; block += 16)
+    {
+        mask = skMask(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)block), zero));
+        if (mask)
+            return (SKsize)(block - in) + skTrailingZeros(mask);
+    }
+
+    for (;; block += 64)
+    {
+        const __m128i a = _mm_load_si128((const __m128i*)block);
+        const __m128i b = _mm_load_si128((const __m128i*)(block + 16));
+        const __m128i c = _mm_load_si128((const __m128i*)(block + 32));
+        const __m128i d = _mm_load_si128((const __m128i*)(block + 48));
+
+        const __m128i low = _mm_min_epu8(_mm_min_epu8(a, b), _mm_min_epu8(c, d));
+        if (skMask(_mm_cmpeq_epi8(low, zero)))
+        {
+            const SKuint64 bits = (SKuint64)skMask(_mm_cmpeq_epi8(a, zero)) |
+                                  (SKuint64)skMask(_mm_cmpeq_epi8(b, zero)) << 16 |
+                                  (SKuint64)skMask(_mm_cmpeq_epi8(c, zero)) << 32 |
+                                  (SKuint64)skMask(_mm_cmpeq_epi8(d, zero)) << 48;
+            return (SKsize)(block - in) + skTrailingZeros(bits);
+        }
+    }
+}
+
+static SKsize skFindCharSse2(const char* str, SKsize len, char ch)
+{
+    if (len < 16)
+        return skFindCharScalar(str, len, ch);
+
+    const __m128i needle = _mm_set1_epi8(ch);
+
+    SKsize i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        const __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i)), needle);
+        const __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i + 16)), needle);
+        const __m128i c = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i + 32)), needle);
+        const __m128i d = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i + 48)), needle);
+
+        if (skMask(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+        {
+            const SKuint64 bits = (SKuint64)skMask(a) |
+                                  (SKuint64)skMask(b) << 16 |
+                                  (SKuint64)skMask(c) << 32 |
+                                  (SKuint64)skMask(d) << 48;
+            return i + skTrailingZeros(bits);
+        }
+    }
+
+    for (; i + 16 <= len; i += 16)
+    {
+        const SKuint32 mask = skMask(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + i)), needle));
+        if (mask)
+            return i + skTrailingZeros(mask);
+    }
+
+    if (i < len)
+    {
+        // Reload the last 16 bytes, dropping the ones already searched.
+        const SKuint32 mask = skMask(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + len - 16)), needle)) >> (16 - (len - i));
+        if (mask)
+            return i + skTrailingZeros(mask);
+    }
+    return SK_NPOS;
+}
+
+// Compares the first and last byte of sub at 16 positions at a time,
+// and only checks the middle where both match.
+static SKsize skFindStringSse2(const char* str, SKsize len, const char* sub, SKsize subLen)
+{
+    const __m128i first = _mm_set1_epi8(sub[0]);
+    const __m128i last  = _mm_set1_epi8(sub[subLen - 1]);
+
+    SKsize i = 0;
+    for (; i + subLen - 1 + 16 <= len; i += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(str + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(str + i + subLen - 1));
+
+        SKuint32 mask = skMask(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+        while (mask)
+        {
+            const SKsize pos = i + skTrailingZeros(mask);
+            if (memcmp(str + pos + 1, sub + 1, subLen - 2) == 0)
+                return pos;
+            mask &= mask - 1;
+        }
+    }
+    return skFindStringFrom(str, len, sub, subLen, i);
+}
+
+// Returns a mask of the differing bytes in the 16 at a and b.
+static SK_INLINE SKuint32 skDifferSse2(const char* a, const char* b)
+{
+    const __m128i x = _mm_loadu_si128((const __m128i*)a);
+    const __m128i y = _mm_loadu_si128((const __m128i*)b);
+    return skMask(_mm_cmpeq_epi8(x, y)) ^ 0xFFFF;
+}
+
+static SK_INLINE SKuint32 skDifferNoCaseSse2(const char* a, const char* b)
+{
+    const __m128i x = skFoldSse2(_mm_loadu_si128((const __m128i*)a));
+    const __m128i y = skFoldSse2(_mm_loadu_si128((const __m128i*)b));
+    return skMask(_mm_cmpeq_epi8(x, y)) ^ 0xFFFF;
+}
+
+static int skCompareSse2(const char* a, const char* b, SKsize len)
+{
+    if (len < 16)
+        return memcmp(a, b, len);
+
+    SKsize i = 0;
+    for (; i + 64 <= len; i += 64)
+    {
+        const __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+        const __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i + 16)), _mm_loadu_si128((const __m128i*)(b + i + 16)));
+        const __m128i e2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i + 32)), _mm_loadu_si128((const __m128i*)(b + i + 32)));
+        const __m128i e3 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i + 48)), _mm_loadu_si128((const __m128i*)(b + i + 48)));
+
+        if (skMask(_mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3))) != 0xFFFF)
+        {
+            const SKuint64 bits = ~((SKuint64)skMask(e0) |
+                                    (SKuint64)skMask(e1) << 16 |
+                                    (SKuint64)skMask(e2) << 32 |
+                                    (SKuint64)skMask(e3) << 48);
+            return skByteDifference(a, b, i + skTrailingZeros(bits));
+        }
+    }
+
+    for (; i + 16 <= len; i += 16)
+    {
+        const SKuint32 mask = skDifferSse2(a + i, b + i);
+        if (mask)
+            return skByteDifference(a, b, i + skTrailingZeros(mask));
+    }
+
+    // The last 16 bytes overlap ones that already matched, so the
+    // first difference found is still the first overall.
+    if (i < len)
+    {
+        const SKuint32 mask = skDifferSse2(a + len - 16, b + len - 16);
+        if (mask)
+            return skByteDifference(a, b, len - 16 + skTrailingZeros(mask));
+    }
+    return 0;
+}
+
+static int skCompareNoCaseSse2(const char* a, const char* b, SKsize len)
+{
+    if (len < 16)
+        return skCompareNoCaseFrom(a, b, len, 0);
+
+    SKsize i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        const SKuint32 mask = skDifferNoCaseSse2(a + i, b + i);
+        if (mask)
+            return skCompareNoCaseFrom(a, b, len, i + skTrailingZeros(mask));
+    }
+
+    if (i < len)
+    {
+        const SKuint32 mask = skDifferNoCaseSse2(a + len - 16, b + len - 16);
+        if (mask)
+            return skCompareNoCaseFrom(a, b, len, len - 16 + skTrailingZeros(mask));
+    }
+    return 0;
+}
+
+static const skCharKernels Sse2Kernels = {
+    skLengthSse2,
+    skFindCharSse2,
+    skFindStringSse2,
+    skCompareSse2,
+    skCompareNoCaseSse2,
+};
+
+#endif
+
+#ifdef SK_AVX2_DISPATCH
+
+// ----------------------------------------------------------------------------
+// AVX2 kernels, 32 bytes per compare. These are compiled for AVX2 on
+// their own and only selected when the CPU reports support. Inputs too
+// short for one 256-bit load use 128-bit loads within the same function,
+// rather than calling the SSE2 kernels, so no legacy SSE code runs with
+// the upper register halves dirty.
+
+SK_TARGET_AVX2 static SK_INLINE SKuint32 skMask(__m256i v)
+{
+    return (SKuint32)_mm256_movemask_epi8(v);
+}
+
+SK_TARGET_AVX2 static SK_INLINE __m256i skFoldAvx2(__m256i v)
+{
+    const __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+    const __m256i upper   = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+SK_TARGET_AVX2 SK_NO_SANITIZE static SKsize skLengthAvx2(const char* in)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    const SKuint32 offs  = (SKuint32)((SKuintPtr)in & 31);
+    const char*    block = in - offs;
+
+    SKuint32 mask = skMask(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)block), zero)) >> offs;
+    if (mask)
+        return skTrailingZeros(mask);
+
+    for (block += 32; (SKuintPtr)block & 127; block += 32)
+    {
+        mask = skMask(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)block), zero));
+        if (mask)
+            return (SKsize)(block - in) + skTrailingZeros(mask);
+    }
+
+    for (;; block += 128)
+    {
+        const __m256i a = _mm256_load_si256((const __m256i*)block);
+        const __m256i b = _mm256_load_si256((const __m256i*)(block + 32));
+        const __m256i c = _mm256_load_si256((const __m256i*)(block + 64));
+        const __m256i d = _mm256_load_si256((const __m256i*)(block + 96));
+
+        const __m256i low = _mm256_min_epu8(_mm256_min_epu8(a, b), _mm256_min_epu8(c, d));
+        if (skMask(_mm256_cmpeq_epi8(low, zero)))
+        {
+            const SKuint64 lo = (SKuint64)skMask(_mm256_cmpeq_epi8(a, zero)) |
+                                (SKuint64)skMask(_mm256_cmpeq_epi8(b, zero)) << 32;
+            if (lo)
+                return (SKsize)(block - in) + skTrailingZeros(lo);
+
+            const SKuint64 hi = (SKuint64)skMask(_mm256_cmpeq_epi8(c, zero)) |
+                                (SKuint64)skMask(_mm256_cmpeq_epi8(d, zero)) << 32;
+            return (SKsize)(block - in) + 64 + skTrailingZeros(hi);
+        }
+    }
+}
+
+SK_TARGET_AVX2 static SKsize skFindCharAvx2(const char* str, SKsize len, char ch)
+{
+    if (len < 32)
+    {
+        if (len < 16)
+            return skFindCharScalar(str, len, ch);
+
+        const __m128i  needle = _mm_set1_epi8(ch);
+        const SKuint32 lo     = (SKuint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)str), needle));
+        const SKuint32 hi     = (SKuint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(str + len - 16)), needle));
+
+        const SKuint32 mask = lo | hi << (len - 16);
+        return mask ? skTrailingZeros(mask) : SK_NPOS;
+    }
+
+    const __m256i needle = _mm256_set1_epi8(ch);
+
+    SKsize i = 0;
+    for (; i + 128 <= len; i += 128)
+    {
+        const __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i)), needle);
+        const __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i + 32)), needle);
+        const __m256i c = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i + 64)), needle);
+        const __m256i d = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i + 96)), needle);
+
+        if (skMask(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))))
+        {
+            const SKuint64 lo = (SKuint64)skMask(a) | (SKuint64)skMask(b) << 32;
+            if (lo)
+                return i + skTrailingZeros(lo);
+            return i + 64 + skTrailingZeros((SKuint64)skMask(c) | (SKuint64)skMask(d) << 32);
+        }
+    }
+
+    for (; i + 32 <= len; i += 32)
+    {
+        const SKuint32 mask = skMask(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + i)), needle));
+        if (mask)
+            return i + skTrailingZeros(mask);
+    }
+
+    if (i < len)
+    {
+        const SKuint32 mask = skMask(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(str + len - 32)), needle)) >> (32 - (len - i));
+        if (mask)
+            return i + skTrailingZeros(mask);
+    }
+    return SK_NPOS;
+}
+
+SK_TARGET_AVX2 static SKsize skFindStringAvx2(const char* str, SKsize len, const char* sub, SKsize subLen)
+{
+    const __m256i first = _mm256_set1_epi8(sub[0]);
+    const __m256i last  = _mm256_set1_epi8(sub[subLen - 1]);
+
+    SKsize i = 0;
+    for (; i + subLen - 1 + 32 <= len; i += 32)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(str + i));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(str + i + subLen - 1));
+
+        SKuint32 mask = skMask(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+        while (mask)
+        {
+            const SKsize pos = i + skTrailingZeros(mask);
+            if (memcmp(str + pos + 1, sub + 1, subLen - 2) == 0)
+                return pos;
+            mask &= mask - 1;
+        }
+    }
+    return skFindStringFrom(str, len, sub, subLen, i);
+}
+
+SK_TARGET_AVX2 static SK_INLINE SKuint32 skDifferAvx2(const char* a, const char* b)
+{
+    const __m256i x = _mm256_loadu_si256((const __m256i*)a);
+    const __m256i y = _mm256_loadu_si256((const __m256i*)b);
+    return ~skMask(_mm256_cmpeq_epi8(x, y));
+}
+
+SK_TARGET_AVX2 static SK_INLINE SKuint32 skDifferNoCaseAvx2(const char* a, const char* b)
+{
+    const __m256i x = skFoldAvx2(_mm256_loadu_si256((const __m256i*)a));
+    const __m256i y = skFoldAvx2(_mm256_loadu_si256((const __m256i*)b));
+    return ~skMask(_mm256_cmpeq_epi8(x, y));
+}
+
+// Mask of the differing bytes in the first 16 to 32 bytes at a and b,
+// from two overlapping 128-bit loads.
+SK_TARGET_AVX2 static SK_INLINE SKuint32 skDifferShortAvx2(const char* a, const char* b, SKsize len, bool noCase)
+{
+    __m128i x0 = _mm_loadu_si128((const __m128i*)a);
+    __m128i y0 = _mm_loadu_si128((const __m128i*)b);
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(a + len - 16));
+    __m128i y1 = _mm_loadu_si128((const __m128i*)(b + len - 16));
+    if (noCase)
+    {
+        x0 = skFoldSse2(x0), y0 = skFoldSse2(y0);
+        x1 = skFoldSse2(x1), y1 = skFoldSse2(y1);
+    }
+
+    const SKuint32 lo = (SKuint32)_mm_movemask_epi8(_mm_cmpeq_epi8(x0, y0)) ^ 0xFFFF;
+    const SKuint32 hi = (SKuint32)_mm_movemask_epi8(_mm_cmpeq_epi8(x1, y1)) ^ 0xFFFF;
+    return lo | hi << (len - 16);
+}
+
+SK_TARGET_AVX2 static int skCompareAvx2(const char* a, const char* b, SKsize len)
+{
+    if (len < 32)
+    {
+        if (len < 16)
+            return memcmp(a, b, len);
+
+        const SKuint32 mask = skDifferShortAvx2(a, b, len, false);
+        return mask ? skByteDifference(a, b, skTrailingZeros(mask)) : 0;
+    }
+
+    SKsize i = 0;
+    for (; i + 128 <= len; i += 128)
+    {
+        const __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+        const __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i + 32)), _mm256_loadu_si256((const __m256i*)(b + i + 32)));
+        const __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i + 64)), _mm256_loadu_si256((const __m256i*)(b + i + 64)));
+        const __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i + 96)), _mm256_loadu_si256((const __m256i*)(b + i + 96)));
+
+        if (~skMask(_mm256_and_si256(_mm256_and_si256(e0, e1), _mm256_and_si256(e2, e3))))
+        {
+            const SKuint64 lo = ~((SKuint64)skMask(e0) | (SKuint64)skMask(e1) << 32);
+            if (lo)
+                return skByteDifference(a, b, i + skTrailingZeros(lo));
+            const SKuint64 hi = ~((SKuint64)skMask(e2) | (SKuint64)skMask(e3) << 32);
+            return skByteDifference(a, b, i + 64 + skTrailingZeros(hi));
+        }
+    }
+
+    for (; i + 32 <= len; i += 32)
+    {
+        const SKuint32 mask = skDifferAvx2(a + i, b + i);
+        if (mask)
+            return skByteDifference(a, b, i + skTrailingZeros(mask));
+    }
+
+    if (i < len)
+    {
+        const SKuint32 mask = skDifferAvx2(a + len - 32, b + len - 32);
+        if (mask)
+            return skByteDifference(a, b, len - 32 + skTrailingZeros(mask));
+    }
+    return 0;
+}
+
+SK_TARGET_AVX2 static int skCompareNoCaseAvx2(const char* a, const char* b, SKsize len)
+{
+    if (len < 32)
+    {
+        if (len < 16)
+            return skCompareNoCaseFrom(a, b, len, 0);
+
+        const SKuint32 mask = skDifferShortAvx2(a, b, len, true);
+        return mask ? skCompareNoCaseFrom(a, b, len, skTrailingZeros(mask)) : 0;
+    }
+
+    SKsize i = 0;
+    for (; i + 32 <= len; i += 32)
+    {
+        const SKuint32 mask = skDifferNoCaseAvx2(a + i, b + i);
+        if (mask)
+            return skCompareNoCaseFrom(a, b, len, i + skTrailingZeros(mask));
+    }
+
+    if (i < len)
+    {
+        const SKuint32 mask = skDifferNoCaseAvx2(a + len - 32, b + len - 32);
+        if (mask)
+            return skCompareNoCaseFrom(a, b, len, len - 32 + skTrailingZeros(mask));
+    }
+    return 0;
+}
+
+static const skCharKernels Avx2Kernels = {
+    skLengthAvx2,
+    skFindCharAvx2,
+    skFindStringAvx2,
+    skCompareAvx2,
+    skCompareNoCaseAvx2,
+};
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Dispatch
+
+static skChar::SimdLevel skDetectSimdLevel()
+{
+#if defined(SK_AVX2_DISPATCH)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7)
+    {
+        __cpuid(info, 1);
+
+        // AVX2 needs the OS to save the upper halves of the registers.
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+        if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5))
+                return skChar::SL_AVX2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return skChar::SL_AVX2;
+#endif
+    return skChar::SL_SSE2;
+#elif defined(SK_SSE2)
+    return skChar::SL_SSE2;
+#else
+    return skChar::SL_SCALAR;
+#endif
+}
+
+static const skCharKernels* skSelectKernels(skChar::SimdLevel level)
+{
+    switch (level)
+    {
+#ifdef SK_AVX2_DISPATCH
+    case skChar::SL_AVX2:
+        return &Avx2Kernels;
+#endif
+#ifdef SK_SSE2
+    case skChar::SL_SSE2:
+        return &Sse2Kernels;
+#endif
+    default:
+        return &ScalarKernels;
+    }
+}
+
+// Starts out null, which is constant initialized, so the kernels are
+// usable from other static constructors.
+static std::atomic<const skCharKernels*> ActiveKernels(nullptr);
+static std::atomic<int>                  ActiveLevel(-1);
+
+static const skCharKernels* skKernels()
+{
+    const skCharKernels* kernels = ActiveKernels.load(std::memory_order_relaxed);
+    if (!kernels)
+    {
+        const skChar::SimdLevel level = skChar::supportedSimdLevel();
+
+        kernels = skSelectKernels(level);
+        ActiveLevel.store(level, std::memory_order_relaxed);
+        ActiveKernels.store(kernels, std::memory_order_relaxed);
+    }
+    return kernels;
+}
+
+skChar::SimdLevel skChar::supportedSimdLevel()
+{
+    static const SimdLevel level = skDetectSimdLevel();
+    return level;
+}
+
+skChar::SimdLevel skChar::simdLevel()
+{
+    skKernels();
+    return (SimdLevel)ActiveLevel.load(std::memory_order_relaxed);
+}
+
+void skChar::setSimdLevel(SimdLevel level)
+{
+    level = skMin(level, supportedSimdLevel());
+    ActiveLevel.store(level, std::memory_order_relaxed);
+    ActiveKernels.store(skSelectKernels(level), std::memory_order_relaxed);
+}
+
+SKsize skChar::length(const char* in)
+{
+    return in && *in ? skKernels()->length(in) : 0;
+}
+
+SKsize skChar::find(const char* str, SKsize len, char ch)
+{
+    if (!str || !len)
+        return SK_NPOS;
+    return skKernels()->findChar(str, len, ch);
+}
+
+SKsize skChar::find(const char* str, SKsize len, const char* sub, SKsize subLen)
+{
+    if (subLen == 0)
+        return 0;
+    if (!str || !sub || subLen > len)
+        return SK_NPOS;
+    if (subLen == 1)
+        return skKernels()->findChar(str, len, sub[0]);
+    return skKernels()->findString(str, len, sub, subLen);
+}
+
+int skChar::compare(const char* a, const char* b, SKsize len)
+{
+    return len > 0 ? skKernels()->compare(a, b, len) : 0;
+}
+
+int skChar::compareNoCase(const char* a, const char* b, SKsize len)
+{
+    return len > 0 ? skKernels()->compareNoCase(a, b, len) : 0;
+}
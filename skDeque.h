@@ -26,8 +26,483 @@
 #ifndef _skDeque_h_
 #define _skDeque_h_
 
-#include "skList.h"
+#include <cstring>
+#include "skAllocator.h"
+#include "skArray.h"
 
-#define skDeque skList
+template <typename T>
+class skDequeIncrementIterator
+{
+public:
+    SK_DECLARE_REF_TYPE(T)
+    typedef typename T::SizeType SizeType;
+
+protected:
+    T*               m_deque;
+    mutable SizeType m_index;
+
+public:
+    skDequeIncrementIterator() :
+        m_deque(nullptr),
+        m_index(0)
+    {
+    }
+
+    explicit skDequeIncrementIterator(T* v) :
+        m_deque(v),
+        m_index(0)
+    {
+    }
+
+    skDequeIncrementIterator(const skDequeIncrementIterator& rhs) :
+        m_deque(rhs.m_deque),
+        m_index(rhs.m_index)
+    {
+    }
+
+    skDequeIncrementIterator& operator=(const skDequeIncrementIterator& rhs)
+    {
+        if (this != &rhs)
+        {
+            m_deque = rhs.m_deque;
+            m_index = rhs.m_index;
+        }
+        return *this;
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_deque && m_index < m_deque->size();
+    }
+
+    ReferenceType getNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index++];
+    }
+
+    ConstReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index++];
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ++m_index;
+    }
+
+    ReferenceType peekNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index];
+    }
+
+    ConstReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index];
+    }
+};
+
+template <typename T>
+class skDequeDecrementIterator
+{
+public:
+    SK_DECLARE_REF_TYPE(T)
+    typedef typename T::SizeType SizeType;
+
+protected:
+    T*               m_deque;
+    mutable SizeType m_index;
+
+public:
+    skDequeDecrementIterator() :
+        m_deque(nullptr),
+        m_index(0)
+    {
+    }
+
+    explicit skDequeDecrementIterator(T* v) :
+        m_deque(v),
+        m_index(v ? v->size() : 0)
+    {
+    }
+
+    skDequeDecrementIterator(const skDequeDecrementIterator& rhs) :
+        m_deque(rhs.m_deque),
+        m_index(rhs.m_index)
+    {
+    }
+
+    skDequeDecrementIterator& operator=(const skDequeDecrementIterator& rhs)
+    {
+        if (this != &rhs)
+        {
+            m_deque = rhs.m_deque;
+            m_index = rhs.m_index;
+        }
+        return *this;
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_deque && m_index > 0;
+    }
+
+    ReferenceType getNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[--m_index];
+    }
+
+    ConstReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[--m_index];
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        --m_index;
+    }
+
+    ReferenceType peekNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index - 1];
+    }
+
+    ConstReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return (*m_deque)[m_index - 1];
+    }
+};
+
+// Segmented double ended queue.
+//
+// Elements live in fixed size blocks that are referenced from a block map.
+// Pushing to either end only touches the first or last block, so
+// elements never move once inserted and indexing is two lookups.
+// Blocks emptied by pops are kept on a free list and reused.
+template <typename T, typename Allocator = skAllocator<T, SKuint32> >
+class skDeque
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skDeque<T, Allocator>                    SelfType;
+    typedef typename Allocator::SizeType             SizeType;
+    typedef skDequeIncrementIterator<SelfType>       Iterator;
+    typedef const skDequeIncrementIterator<SelfType> ConstIterator;
+    typedef skDequeDecrementIterator<SelfType>       ReverseIterator;
+    typedef const skDequeDecrementIterator<SelfType> ConstReverseIterator;
+
+    // Blocks hold a power of two number of elements, about 4k bytes.
+    enum
+    {
+        BlockBits = sizeof(T) <= 8 ? 9 : sizeof(T) <= 32 ? 7 : sizeof(T) <= 128 ? 5 : 3,
+        BlockSize = 1 << BlockBits,
+        BlockMask = BlockSize - 1,
+    };
+
+    static const SizeType npos;
+
+private:
+    PointerType*         m_map;
+    SizeType             m_mapSize;
+    SizeType             m_first;
+    SizeType             m_size;
+    skArray<PointerType> m_free;
+    Allocator            m_alloc;
+
+public:
+    skDeque() :
+        m_map(nullptr),
+        m_mapSize(0),
+        m_first(0),
+        m_size(0)
+    {
+    }
+
+    skDeque(const skDeque& rhs) :
+        m_map(nullptr),
+        m_mapSize(0),
+        m_first(0),
+        m_size(0)
+    {
+        replicate(rhs);
+    }
+
+    ~skDeque()
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        for (SizeType i = 0; i < m_mapSize; ++i)
+        {
+            if (m_map[i])
+                m_alloc.array_deallocate(m_map[i], BlockSize);
+        }
+
+        for (SizeType i = 0; i < m_free.size(); ++i)
+            m_alloc.array_deallocate(m_free[i], BlockSize);
+
+        delete[] m_map;
+        m_free.clear();
+
+        m_map     = nullptr;
+        m_mapSize = 0;
+        m_first   = 0;
+        m_size    = 0;
+    }
+
+    void push_back(ConstReferenceType v)
+    {
+        if (m_size >= m_alloc.limit)
+            throw m_alloc.limit;
+
+        SizeType pos = m_first + m_size;
+        if (pos >= m_mapSize * BlockSize)
+        {
+            makeRoom();
+            pos = m_first + m_size;
+        }
+
+        PointerType& block = m_map[pos >> BlockBits];
+        if (!block)
+            block = acquireBlock();
+
+        block[pos & BlockMask] = v;
+        ++m_size;
+    }
+
+    void push_front(ConstReferenceType v)
+    {
+        if (m_size >= m_alloc.limit)
+            throw m_alloc.limit;
+
+        if (m_first == 0)
+            makeRoom();
+
+        const SizeType pos   = m_first - 1;
+        PointerType&   block = m_map[pos >> BlockBits];
+        if (!block)
+            block = acquireBlock();
+
+        block[pos & BlockMask] = v;
+        m_first                = pos;
+        ++m_size;
+    }
+
+    void pop_back(void)
+    {
+        if (m_size == 0)
+            return;
+
+        --m_size;
+
+        // Reset the slot so it does not hold on to resources.
+        const SizeType pos                       = m_first + m_size;
+        m_map[pos >> BlockBits][pos & BlockMask] = T();
+
+        if ((pos & BlockMask) == 0 || m_size == 0)
+            releaseBlock(pos >> BlockBits);
+
+        if (m_size == 0)
+            m_first = (m_mapSize * BlockSize) / 2;
+    }
+
+    void pop_front(void)
+    {
+        if (m_size == 0)
+            return;
+
+        const SizeType pos                       = m_first;
+        m_map[pos >> BlockBits][pos & BlockMask] = T();
+        ++m_first;
+        --m_size;
+
+        if ((m_first & BlockMask) == 0 || m_size == 0)
+            releaseBlock(pos >> BlockBits);
+
+        if (m_size == 0)
+            m_first = (m_mapSize * BlockSize) / 2;
+    }
+
+    SizeType find(ConstReferenceType v) const
+    {
+        for (SizeType i = 0; i < m_size; ++i)
+        {
+            if ((*this)[i] == v)
+                return i;
+        }
+        return npos;
+    }
+
+    SK_INLINE ReferenceType operator[](SizeType idx)
+    {
+        SK_ASSERT(idx < m_size);
+        const SizeType pos = m_first + idx;
+        return m_map[pos >> BlockBits][pos & BlockMask];
+    }
+
+    SK_INLINE ConstReferenceType operator[](SizeType idx) const
+    {
+        SK_ASSERT(idx < m_size);
+        const SizeType pos = m_first + idx;
+        return m_map[pos >> BlockBits][pos & BlockMask];
+    }
+
+    SK_INLINE ReferenceType at(SizeType idx)
+    {
+        return (*this)[idx];
+    }
+
+    SK_INLINE ConstReferenceType at(SizeType idx) const
+    {
+        return (*this)[idx];
+    }
+
+    SK_INLINE ReferenceType front(void)
+    {
+        SK_ASSERT(m_size > 0);
+        return (*this)[0];
+    }
+
+    SK_INLINE ConstReferenceType front(void) const
+    {
+        SK_ASSERT(m_size > 0);
+        return (*this)[0];
+    }
+
+    SK_INLINE ReferenceType back(void)
+    {
+        SK_ASSERT(m_size > 0);
+        return (*this)[m_size - 1];
+    }
+
+    SK_INLINE ConstReferenceType back(void) const
+    {
+        SK_ASSERT(m_size > 0);
+        return (*this)[m_size - 1];
+    }
+
+    SK_INLINE SizeType size(void) const
+    {
+        return m_size;
+    }
+
+    SK_INLINE bool empty(void) const
+    {
+        return m_size == 0;
+    }
+
+    Iterator iterator(void)
+    {
+        return Iterator(this);
+    }
+
+    ConstIterator iterator(void) const
+    {
+        return ConstIterator(const_cast<SelfType*>(this));
+    }
+
+    ReverseIterator reverseIterator(void)
+    {
+        return ReverseIterator(this);
+    }
+
+    ConstReverseIterator reverseIterator(void) const
+    {
+        return ConstReverseIterator(const_cast<SelfType*>(this));
+    }
+
+    skDeque& operator=(const skDeque& rhs)
+    {
+        if (this != &rhs)
+            replicate(rhs);
+        return *this;
+    }
+
+private:
+    PointerType acquireBlock(void)
+    {
+        if (!m_free.empty())
+        {
+            PointerType block = m_free.back();
+            m_free.resize(m_free.size() - 1);
+            return block;
+        }
+        return m_alloc.array_allocate(BlockSize);
+    }
+
+    void releaseBlock(SizeType index)
+    {
+        if (m_map[index])
+        {
+            m_free.push_back(m_map[index]);
+            m_map[index] = nullptr;
+        }
+    }
+
+    // Makes room for one more block at both the front and the back.
+    // If the map is less than half full the used blocks are re-centered,
+    // otherwise the map doubles. Only block pointers are moved.
+    void makeRoom(void)
+    {
+        const SizeType firstBlock = m_first >> BlockBits;
+        const SizeType usedBlocks = m_size > 0 ? ((m_first + m_size - 1) >> BlockBits) - firstBlock + 1 : 0;
+
+        SizeType newSize = m_mapSize;
+        if (m_mapSize == 0 || (usedBlocks + 2) * 2 > m_mapSize)
+            newSize = m_mapSize == 0 ? SKInitalCap : m_mapSize * 2;
+
+        const SizeType newFirstBlock = (newSize - usedBlocks) / 2;
+
+        if (newSize != m_mapSize)
+        {
+            PointerType* newMap = new PointerType[newSize];
+            skMemset(newMap, 0, sizeof(PointerType) * newSize);
+
+            if (usedBlocks > 0)
+                skMemcpy(newMap + newFirstBlock, m_map + firstBlock, sizeof(PointerType) * usedBlocks);
+
+            delete[] m_map;
+            m_map     = newMap;
+            m_mapSize = newSize;
+        }
+        else if (newFirstBlock != firstBlock)
+        {
+            ::memmove(m_map + newFirstBlock, m_map + firstBlock, sizeof(PointerType) * usedBlocks);
+
+            // clear the slots that are no longer part of the used range
+            for (SizeType i = firstBlock; i < firstBlock + usedBlocks; ++i)
+            {
+                if (i < newFirstBlock || i >= newFirstBlock + usedBlocks)
+                    m_map[i] = nullptr;
+            }
+        }
+
+        m_first = newFirstBlock * BlockSize + (m_first & BlockMask);
+        if (m_size == 0)
+            m_first = newFirstBlock * BlockSize;
+    }
+
+    void replicate(const skDeque& rhs)
+    {
+        clear();
+        for (SizeType i = 0; i < rhs.size(); ++i)
+            push_back(rhs[i]);
+    }
+};
+
+template <typename T, typename Allocator>
+const typename skDeque<T, Allocator>::SizeType skDeque<T, Allocator>::npos = Allocator::npos;
 
 #endif  //_skDeque_h_
@@ -28,6 +28,7 @@
 
 #include "Config/skConfig.h"
 #include "Utils/skArray.h"
+#include "Utils/skSortNetwork.h"
 
 template <typename T, const SKuint16 L>
 class skFixedArray
@@ -40,7 +41,7 @@ public:
     typedef const skPointerDecrementIterator<SelfType> ConstReverseIterator;
 
     SK_DECLARE_TYPE(T)
-    SK_IMPLEMENT_QSORT(T, SelfType, SKuint16)
+    SK_IMPLEMENT_NETWORK_SORT(T, SelfType, SKuint16, L)
 
     const SKuint16 limit = L;
     const SKuint16 npos  = SK_NPOS16;
@@ -95,26 +95,18 @@ public:
 
     void split(skArray<skFixedString<L> >& destination, char condition1, char condition2 = '\0') const
     {
-        SKuint16 i, p = 0, t;
+        SKuint16 i, p = 0;
         for (i = 0; i < L && i < m_size; ++i)
         {
             if (m_buffer[i] == condition1 || m_buffer[i] == condition2)
             {
-                skFixedString<L> copy;
-                for (t = p; t < i; ++t)
-                    copy.push_back(m_buffer[t]);
-                destination.push_back(copy);
+                destination.push_back(skFixedString<L>(m_buffer + p, i - p));
                 p = i + 1;
             }
         }
 
         if (p != i)
-        {
-            skFixedString<L> copy;
-            for (t = p; t < i; ++t)
-                copy.push_back(m_buffer[t]);
-            destination.push_back(copy);
-        }
+            destination.push_back(skFixedString<L>(m_buffer + p, i - p));
     }
 
     void append(const char* str)
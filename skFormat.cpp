@@ -0,0 +1,429 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/skFormat.h"
+#include <cstdio>
+#include "Utils/skMemoryUtils.h"
+
+namespace
+{
+    struct Spec
+    {
+        char   fill;
+        char   align;
+        char   type;
+        bool   zero;
+        SKsize width;
+        int    precision;
+    };
+
+    // Collects output in a stack buffer and passes it on when full.
+    class Output
+    {
+    private:
+        skFormatWriter& m_out;
+        char            m_buffer[256];
+        SKsize          m_size;
+        SKsize          m_total;
+
+    public:
+        explicit Output(skFormatWriter& out) :
+            m_out(out),
+            m_size(0),
+            m_total(0)
+        {
+        }
+
+        void flush()
+        {
+            if (m_size > 0)
+            {
+                m_out.write(m_buffer, m_size);
+                m_size = 0;
+            }
+        }
+
+        void put(char ch)
+        {
+            if (m_size == sizeof m_buffer)
+                flush();
+            m_buffer[m_size++] = ch;
+            ++m_total;
+        }
+
+        void put(const char* src, SKsize len)
+        {
+            if (len == 0)
+                return;
+
+            if (m_size + len > sizeof m_buffer)
+            {
+                flush();
+                if (len > sizeof m_buffer)
+                {
+                    m_out.write(src, len);
+                    m_total += len;
+                    return;
+                }
+            }
+            skMemcpy(m_buffer + m_size, src, len);
+            m_size += len;
+            m_total += len;
+        }
+
+        void fill(char ch, SKsize nr)
+        {
+            while (nr-- > 0)
+                put(ch);
+        }
+
+        SKsize total() const
+        {
+            return m_total;
+        }
+    };
+
+    SKsize parseNumber(const char*& fmt)
+    {
+        SKsize v = 0;
+        while (*fmt >= '0' && *fmt <= '9')
+            v = v * 10 + (SKsize)(*fmt++ - '0');
+        return v;
+    }
+
+    bool isAlign(char ch)
+    {
+        return ch == '<' || ch == '>' || ch == '^';
+    }
+
+    // Parses [[fill]align][0][width][.precision][type] up to the closing
+    // brace. Anything else in the spec is skipped.
+    void parseSpec(const char*& fmt, Spec& spec)
+    {
+        if (fmt[0] && fmt[0] != '}' && isAlign(fmt[1]))
+        {
+            spec.fill  = fmt[0];
+            spec.align = fmt[1];
+            fmt += 2;
+        }
+        else if (isAlign(fmt[0]))
+            spec.align = *fmt++;
+
+        if (*fmt == '0')
+        {
+            spec.zero = true;
+            ++fmt;
+        }
+
+        spec.width = parseNumber(fmt);
+
+        if (*fmt == '.')
+        {
+            ++fmt;
+            spec.precision = (int)skMin<SKsize>(parseNumber(fmt), 64);
+        }
+
+        if (*fmt && *fmt != '}')
+            spec.type = *fmt++;
+
+        while (*fmt && *fmt != '}')
+            ++fmt;
+    }
+
+    // Writes the digits of v in the given base to the end of buf and
+    // returns the first one.
+    char* formatUnsigned(char* end, SKuint64 v, unsigned base, bool upper)
+    {
+        const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        do
+        {
+            *--end = digits[v % base];
+            v /= base;
+        } while (v != 0);
+        return end;
+    }
+
+    unsigned baseOf(char type)
+    {
+        switch (type)
+        {
+        case 'x':
+        case 'X':
+        case 'p':
+            return 16;
+        case 'o':
+            return 8;
+        case 'b':
+            return 2;
+        default:
+            return 10;
+        }
+    }
+
+    void writePadded(Output& out, const Spec& spec, const char* sign, const char* str, SKsize len, char defaultAlign)
+    {
+        const SKsize signLen = skChar::length(sign);
+        const SKsize total   = signLen + len;
+        const SKsize pad     = spec.width > total ? spec.width - total : 0;
+
+        if (spec.zero && !spec.align)
+        {
+            out.put(sign, signLen);
+            out.fill('0', pad);
+            out.put(str, len);
+            return;
+        }
+
+        const char align = spec.align ? spec.align : defaultAlign;
+
+        SKsize before = 0;
+        if (align == '>')
+            before = pad;
+        else if (align == '^')
+            before = pad / 2;
+
+        out.fill(spec.fill, before);
+        out.put(sign, signLen);
+        out.put(str, len);
+        out.fill(spec.fill, pad - before);
+    }
+
+    void writeInteger(Output& out, const Spec& spec, SKuint64 magnitude, bool negative)
+    {
+        if (spec.type == 'c')
+        {
+            const char ch = (char)magnitude;
+            writePadded(out, spec, "", &ch, 1, '<');
+            return;
+        }
+
+        const char*    sign = negative ? "-" : "";
+        const unsigned base = baseOf(spec.type);
+        if (base == 10)
+        {
+            char buf[skChar::MaxIntegerChars];
+            writePadded(out, spec, sign, buf, skChar::toChars(buf, magnitude), '>');
+            return;
+        }
+
+        char        buf[72];
+        char*       end   = buf + sizeof buf;
+        const char* start = formatUnsigned(end, magnitude, base, spec.type == 'X');
+        writePadded(out, spec, sign, start, (SKsize)(end - start), '>');
+    }
+
+    // Single precision values are shortened as floats, so 0.1f reads 0.1.
+    void writeDouble(Output& out, const Spec& spec, double v, bool single)
+    {
+        char type = spec.type;
+        if (type != 'f' && type != 'e' && type != 'g')
+        {
+            if (spec.precision < 0)
+            {
+                // Without a precision, the shortest text that reads back
+                // to v.
+                char         buf[skChar::MaxFloatChars];
+                const SKsize len      = single ? skChar::toChars(buf, (float)v) : skChar::toChars(buf, v);
+                const bool   negative = buf[0] == '-';
+                writePadded(out, spec, negative ? "-" : "", buf + negative, len - negative, '>');
+                return;
+            }
+            type = 'g';
+        }
+
+        // Room for the widest %f value with the largest precision.
+        char buf[400];
+        char fmt[5] = {'%', '.', '*', type, 0};
+
+        int len = snprintf(buf, sizeof buf, fmt, spec.precision < 0 ? 6 : spec.precision, v);
+        if (len < 0)
+            return;
+        len = skMin<int>(len, (int)sizeof buf - 1);
+
+        const bool negative = buf[0] == '-';
+        writePadded(out,
+                    spec,
+                    negative ? "-" : "",
+                    buf + (negative ? 1 : 0),
+                    (SKsize)len - (negative ? 1 : 0),
+                    '>');
+    }
+
+    void writeArg(Output& out, const Spec& spec, const skFormatArg& arg)
+    {
+        switch (arg.type())
+        {
+        case skFormatArg::FA_BOOL:
+            if (spec.type == 0 || spec.type == 's')
+            {
+                const bool v = arg.toBool();
+                writePadded(out, spec, "", v ? "true" : "false", v ? 4 : 5, '<');
+            }
+            else
+                writeInteger(out, spec, arg.toBool() ? 1 : 0, false);
+            break;
+        case skFormatArg::FA_CHAR:
+            if (spec.type == 0 || spec.type == 'c' || spec.type == 's')
+            {
+                const char ch = arg.toChar();
+                writePadded(out, spec, "", &ch, 1, '<');
+            }
+            else
+                writeInteger(out, spec, (SKuint8)arg.toChar(), false);
+            break;
+        case skFormatArg::FA_INT:
+        {
+            const SKint64 v = arg.toInt();
+            // Negating in unsigned arithmetic keeps the smallest value.
+            writeInteger(out, spec, v < 0 ? 0 - (SKuint64)v : (SKuint64)v, v < 0);
+            break;
+        }
+        case skFormatArg::FA_UINT:
+            writeInteger(out, spec, arg.toUint(), false);
+            break;
+        case skFormatArg::FA_FLOAT:
+            writeDouble(out, spec, arg.toDouble(), true);
+            break;
+        case skFormatArg::FA_DOUBLE:
+            writeDouble(out, spec, arg.toDouble(), false);
+            break;
+        case skFormatArg::FA_STRING:
+        {
+            const skStringView str = arg.toString();
+
+            SKsize len = str.size();
+            if (spec.precision >= 0)
+                len = skMin<SKsize>(len, (SKsize)spec.precision);
+            writePadded(out, spec, "", str.ptr(), len, '<');
+            break;
+        }
+        case skFormatArg::FA_POINTER:
+        {
+            char        buf[24];
+            char*       end   = buf + sizeof buf;
+            const char* start = formatUnsigned(end, (SKuint64)(SKuintPtr)arg.toPointer(), 16, false);
+            writePadded(out, spec, "0x", start, (SKsize)(end - start), '>');
+            break;
+        }
+        case skFormatArg::FA_NONE:
+            break;
+        }
+    }
+}  // namespace
+
+SKsize skFormatArgs(skFormatWriter& out, const char* fmt, const skFormatArg* args, SKsize nr)
+{
+    if (!fmt)
+        return 0;
+
+    Output buffer(out);
+    SKsize next = 0;
+
+    while (*fmt)
+    {
+        // Copy the literal text up to the next brace in one piece.
+        const char* text = fmt;
+        while (*fmt && *fmt != '{' && *fmt != '}')
+            ++fmt;
+        if (fmt != text)
+            buffer.put(text, (SKsize)(fmt - text));
+
+        if (!*fmt)
+            break;
+
+        if (fmt[0] == fmt[1])
+        {
+            buffer.put(*fmt);
+            fmt += 2;
+            continue;
+        }
+
+        if (*fmt == '}')
+        {
+            buffer.put(*fmt++);
+            continue;
+        }
+
+        const char* open = fmt++;
+
+        SKsize index = next;
+        if (*fmt >= '0' && *fmt <= '9')
+            index = parseNumber(fmt);
+        else
+            ++next;
+
+        Spec spec = {' ', 0, 0, false, 0, -1};
+        if (*fmt == ':')
+            parseSpec(++fmt, spec);
+
+        if (*fmt != '}')
+        {
+            // An unterminated placeholder is written as it is.
+            buffer.put(open, (SKsize)(fmt - open));
+            continue;
+        }
+        ++fmt;
+
+        if (index < nr)
+            writeArg(buffer, spec, args[index]);
+    }
+
+    buffer.flush();
+    return buffer.total();
+}
+
+SKsize skFormatPrintf(skFormatWriter& out, const char* fmt, va_list args)
+{
+    if (!fmt)
+        return 0;
+
+    char    buffer[512];
+    va_list copy;
+
+    va_copy(copy, args);
+    const int len = std::vsnprintf(buffer, sizeof buffer, fmt, copy);
+    va_end(copy);
+
+    if (len <= 0)
+        return 0;
+
+    if ((SKsize)len < sizeof buffer)
+    {
+        out.write(buffer, (SKsize)len);
+        return (SKsize)len;
+    }
+
+    char* heap = (char*)skMalloc((SKsize)len + 1);
+    if (!heap)
+        return 0;
+
+    va_copy(copy, args);
+    std::vsnprintf(heap, (SKsize)len + 1, fmt, copy);
+    va_end(copy);
+
+    out.write(heap, (SKsize)len);
+    skFree(heap);
+    return (SKsize)len;
+}
@@ -0,0 +1,353 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skFormat_h_
+#define _skFormat_h_
+
+#include <cstdarg>
+#include "Utils/skStreams.h"
+#include "Utils/skString.h"
+#include "Utils/skStringBuilder.h"
+
+// Receives the formatted output in chunks.
+class skFormatWriter
+{
+public:
+    skFormatWriter()          = default;
+    virtual ~skFormatWriter() = default;
+
+    virtual void write(const char* src, SKsize len) = 0;
+};
+
+class skStringFormatWriter : public skFormatWriter
+{
+private:
+    skString& m_dest;
+
+public:
+    explicit skStringFormatWriter(skString& dest) :
+        m_dest(dest)
+    {
+    }
+
+    void write(const char* src, SKsize len) override
+    {
+        m_dest.append(src, len);
+    }
+};
+
+class skStringBuilderFormatWriter : public skFormatWriter
+{
+private:
+    skStringBuilder& m_dest;
+
+public:
+    explicit skStringBuilderFormatWriter(skStringBuilder& dest) :
+        m_dest(dest)
+    {
+    }
+
+    void write(const char* src, SKsize len) override
+    {
+        m_dest.write(src, len);
+    }
+};
+
+class skStreamFormatWriter : public skFormatWriter
+{
+private:
+    skStream& m_dest;
+    SKsize    m_written;
+
+public:
+    explicit skStreamFormatWriter(skStream& dest) :
+        m_dest(dest),
+        m_written(0)
+    {
+    }
+
+    void write(const char* src, SKsize len) override
+    {
+        if (m_written == SK_NPOS)
+            return;
+
+        const SKsize bw = m_dest.write(src, len);
+        m_written       = bw == SK_NPOS ? SK_NPOS : m_written + bw;
+    }
+
+    // The number of bytes the stream accepted, or SK_NPOS if a write
+    // failed.
+    SKsize written() const
+    {
+        return m_written;
+    }
+};
+
+// One argument of skFormat, with its type recorded so that the
+// formatter never has to trust the format string.
+class skFormatArg
+{
+public:
+    enum Type
+    {
+        FA_NONE,
+        FA_BOOL,
+        FA_CHAR,
+        FA_INT,
+        FA_UINT,
+        FA_FLOAT,
+        FA_DOUBLE,
+        FA_STRING,
+        FA_POINTER,
+    };
+
+private:
+    union
+    {
+        bool        m_bool;
+        char        m_char;
+        SKint64     m_int;
+        SKuint64    m_uint;
+        double      m_double;
+        const void* m_pointer;
+        struct
+        {
+            const char* data;
+            SKsize      size;
+        } m_string;
+    };
+
+    Type m_type;
+
+public:
+    skFormatArg() :
+        m_int(0),
+        m_type(FA_NONE)
+    {
+    }
+
+    skFormatArg(bool v) :
+        m_bool(v),
+        m_type(FA_BOOL)
+    {
+    }
+
+    skFormatArg(char v) :
+        m_char(v),
+        m_type(FA_CHAR)
+    {
+    }
+
+    skFormatArg(signed char v) :
+        m_int(v),
+        m_type(FA_INT)
+    {
+    }
+
+    skFormatArg(short v) :
+        m_int(v),
+        m_type(FA_INT)
+    {
+    }
+
+    skFormatArg(int v) :
+        m_int(v),
+        m_type(FA_INT)
+    {
+    }
+
+    skFormatArg(long v) :
+        m_int(v),
+        m_type(FA_INT)
+    {
+    }
+
+    skFormatArg(long long v) :
+        m_int(v),
+        m_type(FA_INT)
+    {
+    }
+
+    skFormatArg(unsigned char v) :
+        m_uint(v),
+        m_type(FA_UINT)
+    {
+    }
+
+    skFormatArg(unsigned short v) :
+        m_uint(v),
+        m_type(FA_UINT)
+    {
+    }
+
+    skFormatArg(unsigned int v) :
+        m_uint(v),
+        m_type(FA_UINT)
+    {
+    }
+
+    skFormatArg(unsigned long v) :
+        m_uint(v),
+        m_type(FA_UINT)
+    {
+    }
+
+    skFormatArg(unsigned long long v) :
+        m_uint(v),
+        m_type(FA_UINT)
+    {
+    }
+
+    skFormatArg(float v) :
+        m_double(v),
+        m_type(FA_FLOAT)
+    {
+    }
+
+    skFormatArg(double v) :
+        m_double(v),
+        m_type(FA_DOUBLE)
+    {
+    }
+
+    skFormatArg(const char* v) :
+        m_type(FA_STRING)
+    {
+        m_string.data = v;
+        m_string.size = skChar::length(v);
+    }
+
+    skFormatArg(const skString& v) :
+        m_type(FA_STRING)
+    {
+        m_string.data = v.c_str();
+        m_string.size = v.size();
+    }
+
+    skFormatArg(const skStringView& v) :
+        m_type(FA_STRING)
+    {
+        m_string.data = v.ptr();
+        m_string.size = v.size();
+    }
+
+    skFormatArg(const void* v) :
+        m_pointer(v),
+        m_type(FA_POINTER)
+    {
+    }
+
+    Type type() const
+    {
+        return m_type;
+    }
+
+    bool toBool() const
+    {
+        return m_bool;
+    }
+
+    char toChar() const
+    {
+        return m_char;
+    }
+
+    SKint64 toInt() const
+    {
+        return m_int;
+    }
+
+    SKuint64 toUint() const
+    {
+        return m_uint;
+    }
+
+    double toDouble() const
+    {
+        return m_double;
+    }
+
+    const void* toPointer() const
+    {
+        return m_pointer;
+    }
+
+    skStringView toString() const
+    {
+        return skStringView(m_string.data, m_string.size);
+    }
+};
+
+// Formats args into out and returns the number of characters written.
+//
+// Each {} in fmt is replaced by the next argument, and {n} by argument n.
+// A placeholder may carry a spec after a colon, [[fill]align][0][width]
+// [.precision][type], where align is one of < > ^ and type one of
+//
+//     d        decimal
+//     x X o b  hexadecimal, octal or binary
+//     c        character
+//     f e g    fixed, exponent or general floating point
+//     s        string
+//     p        pointer
+//
+// {{ and }} write a single brace. Placeholders without a matching
+// argument are left out. Output is collected in a stack buffer and
+// handed to out in chunks, so the arguments are visited once.
+extern SKsize skFormatArgs(skFormatWriter& out, const char* fmt, const skFormatArg* args, SKsize nr);
+
+// Writes a printf style format to out. The text is formatted straight
+// into a stack buffer; only output that does not fit it is formatted a
+// second time into a heap buffer.
+extern SKsize skFormatPrintf(skFormatWriter& out, const char* fmt, va_list args);
+
+// Appends the formatted text to dst and returns its length. The
+// skStream overload returns what the stream reports instead.
+template <typename... Args>
+SKsize skFormat(skString& dst, const char* fmt, const Args&... args)
+{
+    const skFormatArg    list[] = {skFormatArg(args)..., skFormatArg()};
+    skStringFormatWriter out(dst);
+    return skFormatArgs(out, fmt, list, sizeof...(Args));
+}
+
+template <typename... Args>
+SKsize skFormat(skStringBuilder& dst, const char* fmt, const Args&... args)
+{
+    const skFormatArg           list[] = {skFormatArg(args)..., skFormatArg()};
+    skStringBuilderFormatWriter out(dst);
+    return skFormatArgs(out, fmt, list, sizeof...(Args));
+}
+
+template <typename... Args>
+SKsize skFormat(skStream& dst, const char* fmt, const Args&... args)
+{
+    const skFormatArg    list[] = {skFormatArg(args)..., skFormatArg()};
+    skStreamFormatWriter out(dst);
+    skFormatArgs(out, fmt, list, sizeof...(Args));
+    return out.written();
+}
+
+#endif  //_skFormat_h_
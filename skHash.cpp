@@ -59,7 +59,7 @@ SKhash skHash(const char* key, SKsize len)
     SKsize i;
     SKhash hash = (SKhash)_SK_INITIAL_FNV;
 
-    for (i = 0; key[i] && i < len; i++)
+    for (i = 0; i < len && key[i]; i++)
     {
         hash = hash ^ (key[i]);          // xor the low 8 bits
         hash = hash * _SK_MULTIPLE_FNV;  // multiply by the magic number
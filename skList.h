@@ -637,6 +637,25 @@ public:
         return true;
     }
 
+    // Moves all links of other to the back of this list in O(1).
+    void splice_back(skListBase& other)
+    {
+        if (this == &other || other.m_size == 0)
+            return;
+
+        if (m_last)
+        {
+            m_last->m_next        = other.m_first;
+            other.m_first->m_prev = m_last;
+        }
+        else
+            m_first = other.m_first;
+
+        m_last = other.m_last;
+        m_size += other.m_size;
+        other.clear();
+    }
+
     LinkPointerType first(void)
     {
         return m_first;
@@ -826,6 +845,13 @@ public:
         erase(m_list.m_first);
     }
 
+    // Moves every element of other to the back of this list
+    // without copying or allocating.
+    void splice(SelfType& other)
+    {
+        m_list.splice_back(other.m_list);
+    }
+
     bool empty(void) const
     {
         return m_list.m_size <= 0;
@@ -1115,4 +1141,291 @@ private:
     mutable BaseType m_list;
 };
 
+// Link storage for intrusive lists.
+//
+// Embed one skListHook member per list that an object should be able to
+// join, then declare the list with a pointer to that member:
+//
+//     struct Session
+//     {
+//         skListHook active;
+//         skListHook timeout;
+//     };
+//
+//     skIntrusiveList<Session, &Session::active>  activeSessions;
+//     skIntrusiveList<Session, &Session::timeout> timeoutSessions;
+//
+// The list never allocates or deletes; the object owns its hooks and must
+// be removed from every list before it is destroyed. An object can only be
+// in one list per hook.
+class skListHook
+{
+public:
+    skListHook() :
+        m_next(this),
+        m_prev(this)
+    {
+    }
+
+    // Hooks are never copied with the object that holds them.
+    skListHook(const skListHook&) :
+        m_next(this),
+        m_prev(this)
+    {
+    }
+
+    skListHook& operator=(const skListHook&)
+    {
+        return *this;
+    }
+
+    bool isLinked(void) const
+    {
+        return m_next != this;
+    }
+
+    skListHook* getNext(void)
+    {
+        return m_next;
+    }
+
+    skListHook* getPrev(void)
+    {
+        return m_prev;
+    }
+
+private:
+    template <typename, typename, class>
+    friend class skListBase;
+
+    template <typename T, skListHook T::*>
+    friend class skIntrusiveList;
+
+    void reset(void)
+    {
+        m_next = this;
+        m_prev = this;
+    }
+
+    skListHook* m_next;
+    skListHook* m_prev;
+};
+
+template <typename T>
+class skIntrusiveListIterator
+{
+public:
+    typedef typename T::ValueType     ValueType;
+    typedef typename T::ReferenceType ReferenceType;
+
+private:
+    mutable skListHook* m_cur;
+    bool                m_reverse;
+
+public:
+    skIntrusiveListIterator() :
+        m_cur(nullptr),
+        m_reverse(false)
+    {
+    }
+
+    skIntrusiveListIterator(skListHook* first, bool reverse) :
+        m_cur(first),
+        m_reverse(reverse)
+    {
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_cur != nullptr;
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        m_cur = m_reverse ? m_cur->getPrev() : m_cur->getNext();
+    }
+
+    ReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ReferenceType ret = *T::owner(m_cur);
+        next();
+        return ret;
+    }
+
+    ReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return *T::owner(m_cur);
+    }
+};
+
+// Doubly linked list over skListHook members of T.
+// Every operation except clear is O(1) and nothing is virtual.
+template <typename T, skListHook T::*Hook>
+class skIntrusiveList
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skIntrusiveList<T, Hook>                 SelfType;
+    typedef skListHook*                              LinkPointerType;
+    typedef skListBase<T, LinkPointerType, SelfType> BaseType;
+    typedef skIntrusiveListIterator<SelfType>        Iterator;
+    typedef skIntrusiveListIterator<SelfType>        ReverseIterator;
+
+public:
+    skIntrusiveList() :
+        m_list()
+    {
+    }
+
+    ~skIntrusiveList()
+    {
+        clear();
+    }
+
+    // Unlinks every element. O(n), since each hook is reset.
+    void clear(void)
+    {
+        LinkPointerType node = m_list.m_first;
+        while (node)
+        {
+            LinkPointerType next = node->m_next;
+            node->reset();
+            node = next;
+        }
+        m_list.clear();
+    }
+
+    void push_back(PointerType v)
+    {
+        LinkPointerType link = hook(v);
+        SK_ASSERT(!link->isLinked());
+
+        link->m_next = nullptr;
+        link->m_prev = nullptr;
+        m_list.push_back(link);
+    }
+
+    void push_front(PointerType v)
+    {
+        LinkPointerType link = hook(v);
+        SK_ASSERT(!link->isLinked());
+
+        link->m_next = nullptr;
+        link->m_prev = nullptr;
+        m_list.push_front(link);
+    }
+
+    // Inserts v in front of pos, which must be in this list.
+    void insert_front(PointerType pos, PointerType v)
+    {
+        LinkPointerType link = hook(v);
+        SK_ASSERT(!link->isLinked() && hook(pos)->isLinked());
+
+        link->m_next = nullptr;
+        link->m_prev = nullptr;
+        m_list.insert_front(hook(pos), link);
+    }
+
+    // Removes v, which must be in this list, from wherever it is.
+    void erase(PointerType v)
+    {
+        LinkPointerType link = hook(v);
+        if (link->isLinked() && m_list.erase_link(link))
+            link->reset();
+    }
+
+    PointerType pop_front(void)
+    {
+        PointerType v = front();
+        if (v)
+            erase(v);
+        return v;
+    }
+
+    PointerType pop_back(void)
+    {
+        PointerType v = back();
+        if (v)
+            erase(v);
+        return v;
+    }
+
+    // Moves every element of other to the back of this list in O(1).
+    void splice(SelfType& other)
+    {
+        m_list.splice_back(other.m_list);
+    }
+
+    PointerType front(void)
+    {
+        return m_list.m_first ? owner(m_list.m_first) : nullptr;
+    }
+
+    PointerType back(void)
+    {
+        return m_list.m_last ? owner(m_list.m_last) : nullptr;
+    }
+
+    PointerType next(PointerType v)
+    {
+        LinkPointerType link = hook(v)->m_next;
+        return link ? owner(link) : nullptr;
+    }
+
+    PointerType prev(PointerType v)
+    {
+        LinkPointerType link = hook(v)->m_prev;
+        return link ? owner(link) : nullptr;
+    }
+
+    SKuint32 size(void) const
+    {
+        return m_list.size();
+    }
+
+    bool empty(void) const
+    {
+        return m_list.size() == 0;
+    }
+
+    Iterator iterator(void)
+    {
+        return Iterator(m_list.m_first, false);
+    }
+
+    ReverseIterator reverseIterator(void)
+    {
+        return ReverseIterator(m_list.m_last, true);
+    }
+
+    static LinkPointerType hook(PointerType v)
+    {
+        return &(v->*Hook);
+    }
+
+    static PointerType owner(LinkPointerType link)
+    {
+        return reinterpret_cast<PointerType>(reinterpret_cast<char*>(link) - offset());
+    }
+
+private:
+    friend class skListBase<T, LinkPointerType, SelfType>;
+
+    mutable BaseType m_list;
+
+    static SKsize offset(void)
+    {
+        // the address is never dereferenced, only used to find the member
+        PointerType base = reinterpret_cast<PointerType>(sizeof(SKsize) * 16);
+        return reinterpret_cast<SKsize>(&(base->*Hook)) - (SKsize)base;
+    }
+
+    skIntrusiveList(const skIntrusiveList&)            = delete;
+    skIntrusiveList& operator=(const skIntrusiveList&) = delete;
+};
+
 #endif  //_skList_h_
@@ -234,34 +234,23 @@ void skLogf(SKint32 detail, const char* format, ...)
 
     if (format && doFormat)
     {
+        // Messages longer than the buffer are truncated.
+        char    buffer[4096];
         va_list l1;
-        char*   buffer = nullptr;
         va_start(l1, format);
-        int size = std::vsnprintf(buffer, 0, format, l1);
+        int size = std::vsnprintf(buffer, sizeof buffer, format, l1);
         va_end(l1);
 
         if (size > 0)
         {
-            size   = skMin(size, 4095);
-            buffer = (char*)::malloc((SKsize)size + 1);
-
-            if (buffer)
-            {
-                va_start(l1, format);
-                size = std::vsnprintf(buffer, (SKsize)size + 1, format, l1);
-                va_end(l1);
-
-                if (log)
-                    log->logMessage(detail, buffer, size);
-                else
-                    skLogger::logStandard(detail, buffer);
-
-                ::free(buffer);
-            }
+            size = skMin(size, (int)sizeof buffer - 1);
+
+            if (log)
+                log->logMessage(detail, buffer, size);
             else
-                printf("Failed to allocate buffer\n");
+                skLogger::logStandard(detail, buffer);
         }
-        else
+        else if (size < 0)
             printf("Error: Log string length is < 0\n");
     }
 }
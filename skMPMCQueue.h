@@ -0,0 +1,351 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skMPMCQueue_h_
+#define _skMPMCQueue_h_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Config/skConfig.h"
+#include "skMinMax.h"
+#include "skTraits.h"
+
+// Bounded multi-producer multi-consumer queue.
+//
+// Each slot carries a sequence number that tells producers and consumers
+// whether the slot is ready for them, so the only contended state is the
+// pair of enqueue/dequeue counters. (D. Vyukov's bounded MPMC queue)
+//
+// The try calls never block. The blocking calls spin and yield briefly,
+// then sleep on a condition variable until the other side makes progress. Waiters
+// are counted, so the mutex is only taken while a thread is asleep.
+//
+// The capacity is rounded up to a power of two.
+template <typename T>
+class skMPMCQueue
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skMPMCQueue<T> SelfType;
+
+private:
+    struct Cell
+    {
+        std::atomic<SKsize> sequence;
+        ValueType           data;
+    };
+
+    typedef std::atomic<SKsize> Counter;
+
+    // A blocking call retries SpinCount times, then yields between up to
+    // YieldCount more tries so a busy queue rarely sleeps, then sleeps.
+    enum
+    {
+        SpinCount  = 64,
+        YieldCount = 16,
+    };
+
+    Cell*  m_buffer;
+    SKsize m_mask;
+
+    alignas(SK_CACHE_LINE) Counter m_enqueuePos;
+    alignas(SK_CACHE_LINE) Counter m_dequeuePos;
+    char m_pad[SK_CACHE_LINE - sizeof(Counter)];
+
+    // Only used by the blocking calls once they stop spinning.
+    std::mutex              m_lock;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::atomic<SKuint32>   m_waitingConsumers;
+    std::atomic<SKuint32>   m_waitingProducers;
+
+public:
+    explicit skMPMCQueue(SKsize capacity) :
+        m_buffer(nullptr),
+        m_mask(0),
+        m_enqueuePos(0),
+        m_dequeuePos(0),
+        m_waitingConsumers(0),
+        m_waitingProducers(0)
+    {
+        SKsize size = 2;
+        while (size < capacity && size < SK_NPOSH)
+            size <<= 1;
+
+        m_buffer = new Cell[size];
+        m_mask   = size - 1;
+
+        for (SKsize i = 0; i < size; ++i)
+            m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~skMPMCQueue()
+    {
+        delete[] m_buffer;
+    }
+
+    bool tryEnqueue(ConstReferenceType value)
+    {
+        if (!push(value))
+            return false;
+        wake(m_waitingConsumers, m_notEmpty, 1);
+        return true;
+    }
+
+    bool tryDequeue(ReferenceType value)
+    {
+        if (!pop(value))
+            return false;
+        wake(m_waitingProducers, m_notFull, 1);
+        return true;
+    }
+
+    // Dequeues up to max elements with a single claim on the dequeue counter.
+    // Returns the number of elements written to dst.
+    SKsize tryDequeueBulk(PointerType dst, SKsize max)
+    {
+        const SKsize nr = popBulk(dst, max);
+        if (nr > 0)
+            wake(m_waitingProducers, m_notFull, nr);
+        return nr;
+    }
+
+    // Blocks until there is room for the value.
+    void enqueue(ConstReferenceType value)
+    {
+        for (SKuint32 spin = 0; spin < SpinCount + YieldCount; ++spin)
+        {
+            if (tryEnqueue(value))
+                return;
+            backoff(spin);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            park(m_waitingProducers);
+            while (!push(value))
+                m_notFull.wait(lock);
+            --m_waitingProducers;
+        }
+        wake(m_waitingConsumers, m_notEmpty, 1);
+    }
+
+    // Blocks until a value is available.
+    void dequeue(ReferenceType value)
+    {
+        for (SKuint32 spin = 0; spin < SpinCount + YieldCount; ++spin)
+        {
+            if (tryDequeue(value))
+                return;
+            backoff(spin);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            park(m_waitingConsumers);
+            while (!pop(value))
+                m_notEmpty.wait(lock);
+            --m_waitingConsumers;
+        }
+        wake(m_waitingProducers, m_notFull, 1);
+    }
+
+    // Blocks until at least one value is available.
+    SKsize dequeueBulk(PointerType dst, SKsize max)
+    {
+        if (!dst || max == 0)
+            return 0;
+
+        SKsize nr;
+        for (SKuint32 spin = 0; spin < SpinCount + YieldCount; ++spin)
+        {
+            if ((nr = tryDequeueBulk(dst, max)) > 0)
+                return nr;
+            backoff(spin);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            park(m_waitingConsumers);
+            while ((nr = popBulk(dst, max)) == 0)
+                m_notEmpty.wait(lock);
+            --m_waitingConsumers;
+        }
+        wake(m_waitingProducers, m_notFull, nr);
+        return nr;
+    }
+
+    SKsize capacity(void) const
+    {
+        return m_mask + 1;
+    }
+
+    // The result is only a snapshot when other threads are active.
+    SKsize sizeApprox(void) const
+    {
+        const SKsize enq = m_enqueuePos.load(std::memory_order_relaxed);
+        const SKsize deq = m_dequeuePos.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+
+    bool empty(void) const
+    {
+        return sizeApprox() == 0;
+    }
+
+private:
+    bool push(ConstReferenceType value)
+    {
+        Cell*  cell;
+        SKsize pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_buffer[pos & m_mask];
+
+            const SKsize   seq  = cell->sequence.load(std::memory_order_acquire);
+            const SKintPtr diff = (SKintPtr)seq - (SKintPtr)pos;
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;  // full
+            else
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(ReferenceType value)
+    {
+        Cell*  cell;
+        SKsize pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_buffer[pos & m_mask];
+
+            const SKsize   seq  = cell->sequence.load(std::memory_order_acquire);
+            const SKintPtr diff = (SKintPtr)seq - (SKintPtr)(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;  // empty
+            else
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+        }
+
+        value = cell->data;
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    SKsize popBulk(PointerType dst, SKsize max)
+    {
+        if (!dst || max == 0)
+            return 0;
+
+        SKsize nr;
+        SKsize pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            nr = 0;
+            while (nr < max && nr <= m_mask)
+            {
+                const SKsize seq = m_buffer[(pos + nr) & m_mask].sequence.load(std::memory_order_acquire);
+                if (seq != pos + nr + 1)
+                    break;
+                ++nr;
+            }
+
+            if (nr == 0)
+            {
+                const SKsize   seq  = m_buffer[pos & m_mask].sequence.load(std::memory_order_acquire);
+                const SKintPtr diff = (SKintPtr)seq - (SKintPtr)(pos + 1);
+                if (diff < 0)
+                    return 0;  // empty
+
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+            else if (m_dequeuePos.compare_exchange_weak(pos, pos + nr, std::memory_order_relaxed))
+                break;
+        }
+
+        for (SKsize i = 0; i < nr; ++i)
+        {
+            Cell* cell = &m_buffer[(pos + i) & m_mask];
+            dst[i]     = cell->data;
+            cell->sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+        }
+        return nr;
+    }
+
+    static void backoff(SKuint32 spin)
+    {
+        if (spin >= SpinCount)
+            std::this_thread::yield();
+    }
+
+    // Registers a waiter, under m_lock, before it checks the queue one
+    // last time. The fence pairs with the one in wake: either the waiter
+    // sees the change or wake sees the waiter.
+    static void park(std::atomic<SKuint32>& waiters)
+    {
+        ++waiters;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // Called after a change the other side may be waiting for. Taking the
+    // lock, only when someone waits, ensures a waiter that has checked the
+    // queue is asleep before it is notified.
+    void wake(std::atomic<SKuint32>& waiters, std::condition_variable& cond, SKsize nr)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+        }
+        if (nr > 1)
+            cond.notify_all();
+        else
+            cond.notify_one();
+    }
+
+    skMPMCQueue(const skMPMCQueue&)            = delete;
+    skMPMCQueue& operator=(const skMPMCQueue&) = delete;
+};
+
+#endif  //_skMPMCQueue_h_
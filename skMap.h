@@ -26,9 +26,18 @@
 #ifndef _skMap_h_
 #define _skMap_h_
 
+#include <type_traits>
 #include "skArray.h"
 #include "skHash.h"
 
+// Marks Lookup as usable in place of Key in skHashTable lookups, which
+// saves building a Key only to find one. A Lookup must hash to the same
+// value as the Key it stands for.
+template <typename Key, typename Lookup>
+struct skIsHashLookup : std::false_type
+{
+};
+
 template <typename T, typename SizeType = SKsize>
 class skHashTableIncrementIterator : public skPointerIncrementIterator<T, SizeType>
 {
@@ -308,12 +317,33 @@ public:
         return get(key);
     }
 
+    template <typename Lookup>
+    typename std::enable_if<skIsHashLookup<Key, Lookup>::value, Value*>::type
+    get(const Lookup& key)
+    {
+        SKsize i = find(key);
+        if (i == npos)
+            return nullptr;
+        return &m_bPtr[i].second;
+    }
+
+    template <typename Lookup>
+    typename std::enable_if<skIsHashLookup<Key, Lookup>::value, SKsize>::type
+    find(const Lookup& key) const
+    {
+        return findHash(skHash(key));
+    }
+
     SKsize find(const Key& key) const
+    {
+        return findHash(skHash(key));
+    }
+
+    SKsize findHash(SKhash hk) const
     {
         if (empty())
             return npos;
 
-        SKhash       hk = skHash(key);
         const SKhash hr = hk & m_capacity - 1;
         SKsize       fh = m_iPtr[hr];
 
@@ -325,16 +355,13 @@ public:
 
     bool insert(const Key& key, const Value& val)
     {
-        if (!empty())
-        {
-            if (find(key) != npos)
-                return false;
-        }
+        const SKhash hk = skHash(key);
+        if (findHash(hk) != npos)
+            return false;
 
         if (m_size == m_capacity)
             reserve(m_size == 0 ? 32 : m_size * 2);
 
-        SKhash       hk = skHash(key);
         const SKhash hr = hk & m_capacity - 1;
 
         m_bPtr[m_size] = Pair(key, val, hk);
@@ -356,8 +383,12 @@ public:
         if (empty())
             return;
 
-        fIndex = find(key);
-        hash   = skHash(key) & m_capacity - 1;
+        hash   = skHash(key);
+        fIndex = findHash(hash);
+        if (fIndex == npos)
+            return;
+
+        hash &= m_capacity - 1;
 
         index  = m_iPtr[hash];
         pIndex = npos;
@@ -376,11 +407,13 @@ public:
         else
             m_iPtr[hash] = m_nPtr[fIndex];
 
+        // Every slot up to the capacity stays constructed, so the vacated
+        // one is reset rather than destroyed.
         SKsize lIndex = m_size - 1;
         if (lIndex == fIndex)
         {
             --m_size;
-            m_bPtr[m_size].~Pair();
+            m_bPtr[m_size] = Pair();
             return;
         }
 
@@ -407,7 +440,7 @@ public:
         m_iPtr[lHash]  = fIndex;
 
         --m_size;
-        m_bPtr[m_size].~Pair();
+        m_bPtr[m_size] = Pair();
     }
 
     SK_INLINE PointerType ptr(void)
@@ -27,6 +27,9 @@
 #define _skMinMax_h_
 
 #include "Config/skConfig.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 template <typename T>
 void skSwap(T& a, T& b)
@@ -71,6 +74,47 @@ SK_INLINE T skClamp(const T& v, const T& a, const T& b)
     return v < a ? a : (v > b ? b : v);
 }
 
+// Returns the index of the lowest set bit in v, which must not be zero.
+SK_INLINE SKuint32 skTrailingZeros(SKuint64 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (SKuint32)__builtin_ctzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return (SKuint32)idx;
+#else
+    SKuint32 n = 0;
+    while (!(v & 1))
+    {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// Returns the number of zero bits above the highest set bit in v, which
+// must not be zero.
+SK_INLINE SKuint32 skLeadingZeros(SKuint64 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (SKuint32)__builtin_clzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanReverse64(&idx, v);
+    return 63 - (SKuint32)idx;
+#else
+    SKuint32 n = 0;
+    while (!(v & 0x8000000000000000ULL))
+    {
+        v <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
 template <typename T>
 void skFill(T* dst, T* src, const SKsize nr)
 {
@@ -0,0 +1,261 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skParallelSort_h_
+#define _skParallelSort_h_
+
+#include <atomic>
+#include <thread>
+#include "Config/skConfig.h"
+#include "skArray.h"
+#include "skSort.h"
+
+// Parallel merge sort.
+//
+// The input is cut into one run per thread and each run is sorted with
+// skIntroSort. Runs are then merged pairwise, a round at a time, between
+// the data and a scratch buffer. Every merge is split along its merge path
+// into pieces proportional to its length, so each round, including the
+// last one, keeps all threads busy. Not stable.
+template <typename T, typename Compare>
+class skParallelSortImpl
+{
+public:
+    enum
+    {
+        // inputs smaller than this are sorted on the calling thread
+        SequentialThreshold = 1 << 16,
+    };
+
+    static void sort(T* data, SKsize n, T* scratch, Compare& cmp, SKuint32 threads)
+    {
+        if (threads == 0)
+            threads = skMax<SKuint32>(1, std::thread::hardware_concurrency());
+
+        if (threads < 2 || n < SequentialThreshold)
+        {
+            skIntroSort(data, data + n, cmp);
+            return;
+        }
+
+        skArray<SKsize> runs;
+        runs.reserve(threads + 1);
+        for (SKuint32 i = 0; i <= threads; ++i)
+            runs.push_back(n * i / threads);
+
+        SortRuns sorter = {data, runs.ptr(), &cmp};
+        parallelFor(threads, threads, sorter);
+
+        T*            src = data;
+        T*            dst = scratch;
+        skArray<Task> tasks;
+
+        while (runs.size() > 2)
+        {
+            tasks.resize(0);
+
+            skArray<SKsize> merged;
+            const SKuint32  count = runs.size() - 1;
+            for (SKuint32 r = 0; r < count; r += 2)
+            {
+                const SKsize a0 = runs[r], a1 = runs[r + 1];
+                const SKsize b1 = r + 2 <= count ? runs[r + 2] : a1;
+                split(src + a0, a1 - a0, src + a1, b1 - a1, dst + a0, n, threads, cmp, tasks);
+                merged.push_back(a0);
+            }
+            merged.push_back(n);
+            runs = merged;
+
+            MergeTasks merger = {tasks.ptr(), &cmp};
+            parallelFor(threads, tasks.size(), merger);
+            skSwap(src, dst);
+        }
+
+        if (src != data)
+        {
+            CopyBack copier = {src, data, n, threads};
+            parallelFor(threads, threads, copier);
+        }
+    }
+
+private:
+    struct Task
+    {
+        const T* a;
+        SKsize   na;
+        const T* b;
+        SKsize   nb;
+        T*       out;
+    };
+
+    struct SortRuns
+    {
+        T*            data;
+        const SKsize* runs;
+        Compare*      cmp;
+
+        void operator()(SKsize i) const
+        {
+            skIntroSort(data + runs[i], data + runs[i + 1], *cmp);
+        }
+    };
+
+    struct MergeTasks
+    {
+        const Task* tasks;
+        Compare*    cmp;
+
+        void operator()(SKsize i) const
+        {
+            const Task& task = tasks[i];
+
+            const T *a = task.a, *ae = a + task.na;
+            const T *b = task.b, *be = b + task.nb;
+            T*       out = task.out;
+
+            while (a != ae && b != be)
+                *out++ = (*cmp)(*b, *a) ? *b++ : *a++;
+            while (a != ae)
+                *out++ = *a++;
+            while (b != be)
+                *out++ = *b++;
+        }
+    };
+
+    struct CopyBack
+    {
+        const T* src;
+        T*       dst;
+        SKsize   n;
+        SKuint32 parts;
+
+        void operator()(SKsize i) const
+        {
+            const SKsize end = n * (i + 1) / parts;
+            for (SKsize j = n * i / parts; j < end; ++j)
+                dst[j] = src[j];
+        }
+    };
+
+    // The number of elements taken from a when the first k elements of
+    // the merge of a and b have been written.
+    static SKsize coRank(SKsize k, const T* a, SKsize na, const T* b, SKsize nb, Compare& cmp)
+    {
+        SKsize lo = k > nb ? k - nb : 0;
+        SKsize hi = k < na ? k : na;
+        while (lo < hi)
+        {
+            const SKsize i = (lo + hi) / 2;
+            const SKsize j = k - i;
+            if (j > 0 && !cmp(b[j - 1], a[i]))
+                lo = i + 1;
+            else
+                hi = i;
+        }
+        return lo;
+    }
+
+    static void split(const T*       a,
+                      SKsize         na,
+                      const T*       b,
+                      SKsize         nb,
+                      T*             out,
+                      SKsize         n,
+                      SKuint32       threads,
+                      Compare&       cmp,
+                      skArray<Task>& tasks)
+    {
+        const SKsize len    = na + nb;
+        const SKsize pieces = skMax<SKsize>(1, (len * threads + n - 1) / n);
+
+        SKsize k0 = 0, i0 = 0;
+        for (SKsize p = 1; p <= pieces; ++p)
+        {
+            const SKsize k1 = len * p / pieces;
+            const SKsize i1 = coRank(k1, a, na, b, nb, cmp);
+
+            const Task task = {a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), out + k0};
+            tasks.push_back(task);
+
+            k0 = k1;
+            i0 = i1;
+        }
+    }
+
+    // Calls fn(i) for i in [0, count) on up to threads threads,
+    // one of which is the caller.
+    template <typename Fn>
+    static void parallelFor(SKuint32 threads, SKsize count, const Fn& fn)
+    {
+        std::atomic<SKsize> next(0);
+
+        auto worker = [&]() {
+            for (SKsize i = next++; i < count; i = next++)
+                fn(i);
+        };
+
+        const SKuint32 helpers = (SKuint32)skMin<SKsize>(threads, count) - 1;
+
+        std::thread* pool = helpers > 0 ? new std::thread[helpers] : nullptr;
+        for (SKuint32 i = 0; i < helpers; ++i)
+            pool[i] = std::thread(worker);
+
+        worker();
+
+        for (SKuint32 i = 0; i < helpers; ++i)
+            pool[i].join();
+        delete[] pool;
+    }
+};
+
+// Sorts n elements of data with the given scratch buffer of n elements.
+// threads == 0 uses every hardware thread.
+template <typename T, typename Compare>
+void skParallelSort(T* data, SKsize n, T* scratch, Compare cmp, SKuint32 threads = 0)
+{
+    skParallelSortImpl<T, Compare>::sort(data, n, scratch, cmp, threads);
+}
+
+// Sorts arr, taking the scratch buffer from an instance of its allocator.
+template <typename T, typename Allocator, typename Compare>
+void skParallelSort(skArray<T, Allocator>& arr, Compare cmp, SKuint32 threads = 0)
+{
+    const SKsize n = arr.size();
+    if (n < 2)
+        return;
+
+    if (n < skParallelSortImpl<T, Compare>::SequentialThreshold || threads == 1)
+    {
+        skIntroSort(arr.ptr(), arr.ptr() + n, cmp);
+        return;
+    }
+
+    Allocator alloc;
+    T*        scratch = alloc.array_allocate((typename Allocator::SizeType)n);
+    skParallelSortImpl<T, Compare>::sort(arr.ptr(), n, scratch, cmp, threads);
+    alloc.array_deallocate(scratch, (typename Allocator::SizeType)n);
+}
+
+#endif  //_skParallelSort_h_
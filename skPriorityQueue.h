@@ -0,0 +1,237 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skPriorityQueue_h_
+#define _skPriorityQueue_h_
+
+#include "Config/skConfig.h"
+#include "skArray.h"
+#include "skArrayBase.h"
+#include "skSort.h"
+
+// Implicit d-ary heap stored in an skArrayBase.
+//
+// The element with the highest priority, where Compare(a, b) means
+// a has a lower priority than b, is kept at index zero. With the default
+// skLess this is the largest element; use skGreater for a min-heap.
+//
+// Arity selects the number of children per node. A 4-ary heap has a
+// shallower tree and keeps all children of a node in one cache line for
+// small T, which favors pop heavy workloads on large heaps.
+template <typename T,
+          typename Compare   = skLess<T>,
+          typename Allocator = skAllocator<T, SKuint32>,
+          const SKuint32 Arity = 2>
+class skPriorityQueue : public skArrayBase<T, Allocator>
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skPriorityQueue<T, Compare, Allocator, Arity> SelfType;
+    typedef skArrayBase<T, Allocator>                     BaseType;
+    typedef skArray<T, Allocator>                         ArrayType;
+    typedef typename Allocator::SizeType                  SizeType;
+
+    // Iterates the underlying storage in heap order, not in priority order.
+    typedef skPointerIncrementIterator<SelfType, SizeType>       Iterator;
+    typedef const skPointerIncrementIterator<SelfType, SizeType> ConstIterator;
+
+public:
+    skPriorityQueue() :
+        BaseType(),
+        m_compare()
+    {
+    }
+
+    explicit skPriorityQueue(const Compare& compare) :
+        BaseType(),
+        m_compare(compare)
+    {
+    }
+
+    explicit skPriorityQueue(const ArrayType& arr, const Compare& compare = Compare()) :
+        BaseType(),
+        m_compare(compare)
+    {
+        assign(arr);
+    }
+
+    skPriorityQueue(const skPriorityQueue& o) :
+        BaseType(o),
+        m_compare(o.m_compare)
+    {
+    }
+
+    ~skPriorityQueue()
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        this->destroy();
+    }
+
+    // Replaces the contents with a copy of arr and builds the heap in O(n).
+    void assign(const ArrayType& arr)
+    {
+        this->replicate(arr);
+        heapify();
+    }
+
+    // Restores the heap property over the whole array in O(n).
+    void heapify(void)
+    {
+        if (this->m_size < 2)
+            return;
+
+        SizeType i = (this->m_size - 2) / Arity + 1;
+        while (i-- > 0)
+            siftDown(i);
+    }
+
+    void push(ConstReferenceType v)
+    {
+        if (this->m_size + 1 > this->m_alloc.limit)
+            throw this->m_alloc.limit;
+
+        if (this->m_size + 1 > this->m_capacity)
+            this->reserve(this->m_size == 0 ? SKInitalCap : this->m_size * 2);
+
+        this->m_data[this->m_size] = v;
+        siftUp(this->m_size++);
+    }
+
+    void pop(void)
+    {
+        if (this->m_size == 0)
+            return;
+
+        --this->m_size;
+        if (this->m_size > 0)
+        {
+            skSwap(this->m_data[0], this->m_data[this->m_size]);
+            siftDown(0);
+        }
+
+        // Reset the vacated slot so it does not hold on to resources.
+        this->m_data[this->m_size] = T();
+    }
+
+    // Copies the top element to out, then removes it.
+    bool pop(ReferenceType out)
+    {
+        if (this->m_size == 0)
+            return false;
+
+        out = this->m_data[0];
+        pop();
+        return true;
+    }
+
+    SK_INLINE ReferenceType top(void)
+    {
+        SK_ASSERT(this->m_size > 0);
+        return this->m_data[0];
+    }
+
+    SK_INLINE ConstReferenceType top(void) const
+    {
+        SK_ASSERT(this->m_size > 0);
+        return this->m_data[0];
+    }
+
+    SK_INLINE Iterator iterator(void)
+    {
+        return this->m_data && this->m_size > 0 ? Iterator(this->m_data, this->m_size) : Iterator();
+    }
+
+    SK_INLINE ConstIterator iterator(void) const
+    {
+        return this->m_data && this->m_size > 0 ? ConstIterator(this->m_data, this->m_size) : ConstIterator();
+    }
+
+    skPriorityQueue& operator=(const skPriorityQueue& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->replicate(rhs);
+            m_compare = rhs.m_compare;
+        }
+        return *this;
+    }
+
+private:
+    Compare m_compare;
+
+    void siftUp(SizeType i)
+    {
+        PointerType data = this->m_data;
+        ValueType   v    = data[i];
+
+        while (i > 0)
+        {
+            const SizeType parent = (i - 1) / Arity;
+            if (!m_compare(data[parent], v))
+                break;
+
+            data[i] = data[parent];
+            i       = parent;
+        }
+        data[i] = v;
+    }
+
+    void siftDown(SizeType i)
+    {
+        PointerType    data = this->m_data;
+        const SizeType size = this->m_size;
+        ValueType      v    = data[i];
+
+        for (;;)
+        {
+            const SizeType first = i * Arity + 1;
+            if (first >= size)
+                break;
+
+            const SizeType last = skMin<SizeType>(first + Arity, size);
+
+            SizeType best = first;
+            for (SizeType c = first + 1; c < last; ++c)
+            {
+                if (m_compare(data[best], data[c]))
+                    best = c;
+            }
+
+            if (!m_compare(v, data[best]))
+                break;
+
+            data[i] = data[best];
+            i       = best;
+        }
+        data[i] = v;
+    }
+};
+
+#endif  //_skPriorityQueue_h_
@@ -26,6 +26,8 @@
 #ifndef _skQueue_h_
 #define _skQueue_h_
 
+#include <cstring>
+#include <type_traits>
 #include "Config/skConfig.h"
 #include "skArray.h"
 #include "skTraits.h"
@@ -37,37 +39,49 @@ public:
     SK_DECLARE_REF_TYPE(T)
 
 protected:
-    mutable PointerType m_beg;
-    mutable PointerType m_end;
+    mutable PointerType m_data;
+    mutable SKsize      m_index;
+    mutable SKsize      m_remaining;
+    SKsize              m_mask;
 
     void swap(skQueueIncrementIterator& rhs)
     {
-        skSwap(m_beg, rhs.m_beg);
-        skSwap(m_end, rhs.m_end);
+        skSwap(m_data, rhs.m_data);
+        skSwap(m_index, rhs.m_index);
+        skSwap(m_remaining, rhs.m_remaining);
+        skSwap(m_mask, rhs.m_mask);
     }
 
 public:
     skQueueIncrementIterator() :
-        m_beg(0),
-        m_end(0)
+        m_data(0),
+        m_index(0),
+        m_remaining(0),
+        m_mask(0)
     {
     }
 
-    skQueueIncrementIterator(PointerType begin, SKsize size, SKsize front) :
-        m_beg(begin + front),
-        m_end(begin + size)
+    skQueueIncrementIterator(PointerType begin, SKsize size, SKsize front, SKsize mask) :
+        m_data(begin),
+        m_index(front),
+        m_remaining(size),
+        m_mask(mask)
     {
     }
 
     explicit skQueueIncrementIterator(T& v) :
-        m_beg(v.ptr() + v.front()),
-        m_end(v.ptr() + v.size())
+        m_data(v.ptr()),
+        m_index(v.front()),
+        m_remaining(v.size()),
+        m_mask(v.capacity() - 1)
     {
     }
 
     skQueueIncrementIterator(const skQueueIncrementIterator& rhs) :
-        m_beg(rhs.m_beg),
-        m_end(rhs.m_end)
+        m_data(rhs.m_data),
+        m_index(rhs.m_index),
+        m_remaining(rhs.m_remaining),
+        m_mask(rhs.m_mask)
     {
     }
 
@@ -85,37 +99,42 @@ public:
 
     SK_INLINE bool hasMoreElements(void) const
     {
-        return m_beg < m_end;
+        return m_remaining > 0;
     }
 
     SK_INLINE ReferenceType getNext(void)
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg++;
+        ReferenceType ret = m_data[m_index];
+        next();
+        return ret;
     }
 
     SK_INLINE ConstReferenceType getNext(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg++;
+        ConstReferenceType ret = m_data[m_index];
+        next();
+        return ret;
     }
 
     SK_INLINE void next(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        ++m_beg;
+        m_index = (m_index + 1) & m_mask;
+        --m_remaining;
     }
 
     SK_INLINE ReferenceType peekNext(void)
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg;
+        return m_data[m_index];
     }
 
     SK_INLINE ConstReferenceType peekNext(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg;
+        return m_data[m_index];
     }
 };
 
@@ -126,37 +145,49 @@ public:
     SK_DECLARE_REF_TYPE(T)
 
 protected:
-    mutable PointerType m_beg;
-    mutable PointerType m_end;
+    mutable PointerType m_data;
+    mutable SKsize      m_index;
+    mutable SKsize      m_remaining;
+    SKsize              m_mask;
 
     void swap(skQueueDecrementIterator& rhs)
     {
-        skSwap(m_beg, rhs.m_beg);
-        skSwap(m_end, rhs.m_end);
+        skSwap(m_data, rhs.m_data);
+        skSwap(m_index, rhs.m_index);
+        skSwap(m_remaining, rhs.m_remaining);
+        skSwap(m_mask, rhs.m_mask);
     }
 
 public:
     skQueueDecrementIterator() :
-        m_beg(0),
-        m_end(0)
+        m_data(0),
+        m_index(0),
+        m_remaining(0),
+        m_mask(0)
     {
     }
 
-    skQueueDecrementIterator(PointerType begin, SKsize size, SKsize front) :
-        m_beg(begin + (size - 1)),
-        m_end(begin + front)
+    skQueueDecrementIterator(PointerType begin, SKsize size, SKsize front, SKsize mask) :
+        m_data(begin),
+        m_index((front + size - 1) & mask),
+        m_remaining(size),
+        m_mask(mask)
     {
     }
 
     explicit skQueueDecrementIterator(T& v) :
-        m_beg(v.ptr() + (v.size() - 1)),
-        m_end(v.ptr() + v.front())
+        m_data(v.ptr()),
+        m_index((v.front() + v.size() - 1) & (v.capacity() - 1)),
+        m_remaining(v.size()),
+        m_mask(v.capacity() - 1)
     {
     }
 
     skQueueDecrementIterator(const skQueueDecrementIterator& rhs) :
-        m_beg(rhs.m_beg),
-        m_end(rhs.m_end)
+        m_data(rhs.m_data),
+        m_index(rhs.m_index),
+        m_remaining(rhs.m_remaining),
+        m_mask(rhs.m_mask)
     {
     }
 
@@ -167,48 +198,55 @@ public:
     skQueueDecrementIterator& operator=(const skQueueDecrementIterator& rhs)
     {
         if (this != &rhs)
-            skPointerIterator(*this).swap(rhs);
+            skQueueDecrementIterator(rhs).swap(*this);
         return *this;
     }
 
     SK_INLINE bool hasMoreElements(void) const
     {
-        return m_beg && m_beg >= m_end;
+        return m_remaining > 0;
     }
 
     SK_INLINE ReferenceType getNext(void)
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg--;
+        ReferenceType ret = m_data[m_index];
+        next();
+        return ret;
     }
 
     SK_INLINE ConstReferenceType getNext(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg--;
+        ConstReferenceType ret = m_data[m_index];
+        next();
+        return ret;
     }
 
     SK_INLINE void next(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        --m_beg;
+        m_index = (m_index - 1) & m_mask;
+        --m_remaining;
     }
 
     SK_INLINE ReferenceType peekNext(void)
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg;
+        return m_data[m_index];
     }
 
     SK_INLINE ConstReferenceType peekNext(void) const
     {
         SK_ITER_DEBUG(hasMoreElements());
-        return *m_beg;
+        return m_data[m_index];
     }
 };
 
-
-
+// Ring buffer queue.
+//
+// The capacity is kept at a power of two so that wrapping
+// the front and back indices is a mask rather than a modulo.
 template <typename T, typename Allocator = skAllocator<T, SKuint32> >
 class skQueue : public skArrayBase<T, Allocator>
 {
@@ -234,12 +272,16 @@ public:
     {
     }
 
-
     skQueue(const skQueue& q) :
-        BaseType(q),
+        BaseType(),
         m_front(0),
         m_back(0)
     {
+        reserve(q.size());
+
+        ConstIterator it = q.iterator();
+        while (it.hasMoreElements())
+            enqueue(it.getNext());
     }
 
     ~skQueue()
@@ -254,29 +296,76 @@ public:
         m_back  = 0;
     }
 
-
-    void resize(SKsize nr)
+    // Makes room for at least nr elements. The capacity is
+    // rounded up to the next power of two and the contents
+    // are unwrapped so that the front starts at zero.
+    void reserve(SizeType nr)
     {
-        this->resize(nr);
+        if (nr <= this->m_capacity)
+            return;
+
+        SizeType capacity = SKInitalCap;
+        while (capacity < nr && capacity < this->m_alloc.limit)
+            capacity <<= 1;
+
+        if (capacity > this->m_alloc.limit)
+            throw this->m_alloc.limit;
+
+        PointerType data = this->m_alloc.array_allocate(capacity);
+        if (this->m_data)
+        {
+            readRange(data, this->m_size);
+            this->m_alloc.array_deallocate(this->m_data, this->m_capacity);
+        }
+
+        this->m_data     = data;
+        this->m_capacity = capacity;
+
         m_front = 0;
-        m_back  = nr;
+        m_back  = this->m_size & (capacity - 1);
+    }
+
+    void resize(SizeType nr)
+    {
+        reserve(nr);
+
+        // Note: elements between the old and the new size are left as is.
+        this->m_size = nr;
+        m_back       = (m_front + nr) & (this->m_capacity - 1);
     }
 
     void enqueue(ConstReferenceType value)
     {
-        if (this->m_size > this->m_alloc.limit)  // provide an upper limit
+        if (this->m_size >= this->m_alloc.limit)  // provide an upper limit
             return;
 
         if (this->m_size + 1 > this->m_capacity)
-        {
-            this->reserve(this->m_size == 0 ? 8 : this->m_size * 2);
-            m_back = this->m_size;
-        }
+            reserve(this->m_size == 0 ? SKInitalCap : this->m_size * 2);
 
         this->m_data[m_back] = value;
         ++this->m_size;
 
-        m_back = (m_back + 1) % this->m_capacity;
+        m_back = (m_back + 1) & (this->m_capacity - 1);
+    }
+
+    // Enqueues nr elements from src with at most two block copies.
+    void enqueueRange(ConstPointerType src, SizeType nr)
+    {
+        if (!src || nr == 0)
+            return;
+
+        if (this->m_size + nr > this->m_alloc.limit)
+            return;
+
+        if (this->m_size + nr > this->m_capacity)
+            reserve(skMax<SizeType>(this->m_size + nr, this->m_size * 2));
+
+        const SizeType first = skMin<SizeType>(nr, this->m_capacity - m_back);
+        copyRange(this->m_data + m_back, src, first);
+        copyRange(this->m_data, src + first, nr - first);
+
+        this->m_size += nr;
+        m_back = (m_back + nr) & (this->m_capacity - 1);
     }
 
     ReferenceType pop_front(void)
@@ -286,39 +375,53 @@ public:
 
     ReferenceType dequeue(void)
     {
-        if (m_front >= this->m_capacity)
+        if (this->m_size == 0)
             throw m_front;
 
-
         ReferenceType returnValue = this->m_data[m_front];
 
-        m_front = (m_front + 1) % this->m_capacity;
+        m_front = (m_front + 1) & (this->m_capacity - 1);
         --this->m_size;
         return returnValue;
     }
 
+    // Dequeues up to nr elements into dst with at most two block copies.
+    // Returns the number of elements that were written to dst.
+    SizeType dequeueRange(PointerType dst, SizeType nr)
+    {
+        if (!dst || this->m_size == 0)
+            return 0;
+
+        nr = skMin<SizeType>(nr, this->m_size);
+        readRange(dst, nr);
+
+        m_front = (m_front + nr) & (this->m_capacity - 1);
+        this->m_size -= nr;
+        return nr;
+    }
+
     SK_INLINE ReferenceType at(SKsize idx)
     {
-        return (*this)[(m_front + idx) % (this->m_capacity - 1)];
+        return (*this)[idx];
     }
 
     SK_INLINE ConstReferenceType at(SKsize idx) const
     {
-        return (*this)[(m_front + idx) % (this->m_capacity - 1)];
+        return (*this)[idx];
     }
 
     SK_INLINE ReferenceType operator[](SKsize idx)
     {
         SK_ASSERT(this->m_data);
         SK_ASSERT(idx != this->npos && idx < this->m_capacity);
-        return this->m_data[(m_front + idx) % (this->m_capacity - 1)];
+        return this->m_data[(m_front + idx) & (this->m_capacity - 1)];
     }
 
     SK_INLINE ConstReferenceType operator[](SKsize idx) const
     {
         SK_ASSERT(this->m_data);
         SK_ASSERT(idx != this->npos && idx < this->m_capacity);
-        return this->m_data[(m_front + idx) % (this->m_capacity - 1)];
+        return this->m_data[(m_front + idx) & (this->m_capacity - 1)];
     }
 
     SK_INLINE SKsize front(void) const
@@ -334,25 +437,55 @@ public:
     SK_INLINE Iterator iterator(void)
     {
         return this->m_data && this->m_size > 0 ? 
-            Iterator(this->m_data, this->m_size, m_front) : Iterator();
+            Iterator(this->m_data, this->m_size, m_front, this->m_capacity - 1) : Iterator();
     }
 
     SK_INLINE ConstIterator iterator(void) const
     {
         return this->m_data && this->m_size > 0 ? 
-            ConstIterator(this->m_data, this->m_size, m_front) : ConstIterator();
+            ConstIterator(this->m_data, this->m_size, m_front, this->m_capacity - 1) : ConstIterator();
     }
 
     SK_INLINE ReverseIterator reverseIterator(void)
     {
         return this->m_data && this->m_size > 0 ? 
-            ReverseIterator(this->m_data, this->m_size, m_front) : ReverseIterator();
+            ReverseIterator(this->m_data, this->m_size, m_front, this->m_capacity - 1) : ReverseIterator();
     }
 
     SK_INLINE ConstReverseIterator reverseIterator(void) const
     {
         return this->m_data && this->m_size > 0 ? 
-            ConstReverseIterator(this->m_data, this->m_size, m_front) : ConstReverseIterator();
+            ConstReverseIterator(this->m_data, this->m_size, m_front, this->m_capacity - 1) : ConstReverseIterator();
+    }
+
+private:
+    static void copyRange(PointerType dst, ConstPointerType src, SizeType nr)
+    {
+        if (nr == 0)
+            return;
+        copyRange(dst, src, nr, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+    }
+
+    static void copyRange(PointerType dst, ConstPointerType src, SizeType nr, std::true_type)
+    {
+        skMemcpy(dst, src, sizeof(T) * nr);
+    }
+
+    static void copyRange(PointerType dst, ConstPointerType src, SizeType nr, std::false_type)
+    {
+        for (SizeType i = 0; i < nr; ++i)
+            dst[i] = src[i];
+    }
+
+    // Copies the first nr elements, in queue order, into dst.
+    void readRange(PointerType dst, SizeType nr) const
+    {
+        if (nr == 0)
+            return;
+
+        const SizeType first = skMin<SizeType>(nr, this->m_capacity - m_front);
+        copyRange(dst, this->m_data + m_front, first);
+        copyRange(dst + first, this->m_data, nr - first);
     }
 };
 
@@ -0,0 +1,226 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skRadixSort_h_
+#define _skRadixSort_h_
+
+#include <cstring>
+#include <type_traits>
+#include "Config/skConfig.h"
+#include "skAllocator.h"
+#include "skSort.h"
+
+// Maps a key onto an unsigned integer with the same ordering.
+template <typename K,
+          bool IsFloat  = std::is_floating_point<K>::value,
+          bool IsSigned = std::is_signed<K>::value>
+struct skRadixTraits
+{
+    typedef typename std::make_unsigned<K>::type Bits;
+
+    static Bits encode(K v)
+    {
+        return (Bits)v;
+    }
+};
+
+template <typename K>
+struct skRadixTraits<K, false, true>
+{
+    typedef typename std::make_unsigned<K>::type Bits;
+
+    static Bits encode(K v)
+    {
+        return (Bits)v ^ ((Bits)1 << (sizeof(Bits) * 8 - 1));
+    }
+};
+
+// IEEE floats: negative values have every bit flipped so larger magnitudes
+// sort first, positive values only have the sign bit set.
+template <typename K>
+struct skRadixTraits<K, true, true>
+{
+    static_assert(sizeof(K) == 4 || sizeof(K) == 8,
+                  "skRadixSort only supports float and double keys");
+
+    typedef typename std::conditional<sizeof(K) == 4, SKuint32, SKuint64>::type Bits;
+
+    static Bits encode(K v)
+    {
+        Bits bits;
+        memcpy(&bits, &v, sizeof(Bits));
+
+        const Bits sign = (Bits)1 << (sizeof(Bits) * 8 - 1);
+        return bits & sign ? ~bits : bits | sign;
+    }
+};
+
+template <typename T>
+struct skRadixIdentity
+{
+    const T& operator()(const T& v) const
+    {
+        return v;
+    }
+};
+
+// Stable least significant digit radix sort.
+//
+// KeyFn returns an integer or floating point key for each element. One pass
+// over the input fills the histograms for every digit, then each digit
+// scatters between the data and scratch buffers. Digits on which every key
+// agrees are skipped, so small key ranges cost fewer passes.
+template <typename T, typename KeyFn, const int DigitBits>
+class skRadixSortImpl
+{
+public:
+    typedef typename std::decay<decltype(std::declval<KeyFn>()(std::declval<const T&>()))>::type KeyType;
+    typedef skRadixTraits<KeyType>                                                                 Traits;
+    typedef typename Traits::Bits                                                                  Bits;
+
+    enum
+    {
+        KeyBits = sizeof(Bits) * 8,
+        Radix   = 1 << DigitBits,
+        Mask    = Radix - 1,
+        Passes  = (KeyBits + DigitBits - 1) / DigitBits,
+
+        // below this a comparison sort on the encoded keys is quicker
+        SmallSize = 64,
+    };
+
+    static void sort(T* data, SKsize n, T* scratch, KeyFn& key)
+    {
+        if (n < 2)
+            return;
+
+        if (n < SmallSize)
+        {
+            skInsertionSort(data, data + n, KeyLess(key));
+            return;
+        }
+
+        SKsize* counts = new SKsize[(SKsize)Passes * Radix]();
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            const Bits bits = Traits::encode(key(data[i]));
+            for (int p = 0; p < Passes; ++p)
+                ++counts[p * Radix + ((bits >> (p * DigitBits)) & Mask)];
+        }
+
+        T* src = data;
+        T* dst = scratch;
+        for (int p = 0; p < Passes; ++p)
+        {
+            SKsize*   count = counts + p * Radix;
+            const int shift = p * DigitBits;
+
+            if (count[(Traits::encode(key(src[0])) >> shift) & Mask] == n)
+                continue;
+
+            SKsize sum = 0;
+            for (int d = 0; d < Radix; ++d)
+            {
+                const SKsize c = count[d];
+                count[d]       = sum;
+                sum += c;
+            }
+
+            for (SKsize i = 0; i < n; ++i)
+            {
+                const Bits digit = (Traits::encode(key(src[i])) >> shift) & Mask;
+                dst[count[digit]++] = src[i];
+            }
+            skSwap(src, dst);
+        }
+
+        if (src != data)
+        {
+            for (SKsize i = 0; i < n; ++i)
+                data[i] = src[i];
+        }
+
+        delete[] counts;
+    }
+
+private:
+    // Insertion sort is stable, matching the radix passes.
+    struct KeyLess
+    {
+        KeyFn& m_key;
+
+        explicit KeyLess(KeyFn& key) :
+            m_key(key)
+        {
+        }
+
+        bool operator()(const T& a, const T& b) const
+        {
+            return Traits::encode(m_key(a)) < Traits::encode(m_key(b));
+        }
+    };
+};
+
+// 11-bit digits give three passes over 32-bit keys and six over 64-bit
+// keys; narrower keys use 8-bit digits.
+template <typename T, typename KeyFn>
+struct skRadixDefaultDigits
+{
+    typedef typename skRadixSortImpl<T, KeyFn, 8>::Bits Bits;
+
+    enum
+    {
+        Value = sizeof(Bits) <= 2 ? 8 : 11
+    };
+};
+
+// Sorts n values using a caller supplied scratch buffer of n elements.
+template <typename T, typename KeyFn>
+void skRadixSort(T* data, SKsize n, T* scratch, KeyFn key)
+{
+    skRadixSortImpl<T, KeyFn, skRadixDefaultDigits<T, KeyFn>::Value>::sort(data, n, scratch, key);
+}
+
+template <typename T, typename KeyFn>
+void skRadixSort(T* data, SKsize n, KeyFn key)
+{
+    if (n < 2)
+        return;
+
+    skAllocator<T, SKsize> alloc;
+
+    T* scratch = alloc.array_allocate(n);
+    skRadixSort(data, n, scratch, key);
+    alloc.array_deallocate(scratch, n);
+}
+
+template <typename T>
+void skRadixSort(T* data, SKsize n)
+{
+    skRadixSort(data, n, skRadixIdentity<T>());
+}
+
+#endif  //_skRadixSort_h_
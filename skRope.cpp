@@ -0,0 +1,495 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/skRope.h"
+#include <cstddef>
+#include <cstring>
+#include "Utils/skMemoryUtils.h"
+#include "Utils/skStreams.h"
+#include "Utils/skString.h"
+
+const SKsize skRope::npos = SK_NPOS;
+
+// Leaves use length, capacity and data; branches use left and right.
+struct skRope::Node
+{
+    SKsize   length;
+    SKuint32 refs;
+    SKuint32 height;
+    Node*    left;
+    Node*    right;
+    SKsize   capacity;
+    char     data[1];
+};
+
+// The tree operations. Each takes ownership of the references passed
+// to it and returns a new reference, so a node shared with another rope
+// is read but never changed.
+struct skRope::Tree
+{
+    static SKuint32 height(const Node* node)
+    {
+        return node ? node->height : 0;
+    }
+
+    static SKsize length(const Node* node)
+    {
+        return node ? node->length : 0;
+    }
+
+    static Node* retain(Node* node)
+    {
+        if (node)
+            ++node->refs;
+        return node;
+    }
+
+    static void release(Node* node)
+    {
+        while (node && --node->refs == 0)
+        {
+            Node* right = node->right;
+            release(node->left);
+            skFree(node);
+
+            // The right spine is walked iteratively.
+            node = right;
+        }
+    }
+
+    static Node* leaf(const char* data, SKsize len, SKsize capacity)
+    {
+        SK_ASSERT(len <= capacity);
+
+        Node* node     = (Node*)skMalloc(offsetof(Node, data) + capacity);
+        node->length   = len;
+        node->refs     = 1;
+        node->height   = 0;
+        node->left     = nullptr;
+        node->right    = nullptr;
+        node->capacity = capacity;
+        if (len > 0)
+            memcpy(node->data, data, len);
+        return node;
+    }
+
+    static Node* branch(Node* left, Node* right)
+    {
+        Node* node     = (Node*)skMalloc(sizeof(Node));
+        node->length   = left->length + right->length;
+        node->refs     = 1;
+        node->height   = 1 + skMax(left->height, right->height);
+        node->left     = left;
+        node->right    = right;
+        node->capacity = 0;
+        return node;
+    }
+
+    // Builds a balanced tree over str, cut into full leaves.
+    static Node* build(const char* str, SKsize len)
+    {
+        if (len <= LeafSize)
+            return leaf(str, len, LeafSize);
+
+        const SKsize leaves = (len + LeafSize - 1) / LeafSize;
+        const SKsize half   = leaves / 2 * LeafSize;
+        return branch(build(str, half), build(str + half, len - half));
+    }
+
+    // Joins two subtrees whose heights differ by at most two, rotating
+    // once or twice when they differ by two.
+    static Node* balance(Node* left, Node* right)
+    {
+        const SKuint32 hl = height(left);
+        const SKuint32 hr = height(right);
+
+        if (hl > hr + 1)
+        {
+            Node* ll = retain(left->left);
+            Node* lr = retain(left->right);
+            release(left);
+
+            if (height(ll) >= height(lr))
+                return branch(ll, branch(lr, right));
+
+            Node* lrl = retain(lr->left);
+            Node* lrr = retain(lr->right);
+            release(lr);
+            return branch(branch(ll, lrl), branch(lrr, right));
+        }
+
+        if (hr > hl + 1)
+        {
+            Node* rl = retain(right->left);
+            Node* rr = retain(right->right);
+            release(right);
+
+            if (height(rr) >= height(rl))
+                return branch(branch(left, rl), rr);
+
+            Node* rll = retain(rl->left);
+            Node* rlr = retain(rl->right);
+            release(rl);
+            return branch(branch(left, rll), branch(rlr, rr));
+        }
+        return branch(left, right);
+    }
+
+    // Concatenates two trees in O(|height(left) - height(right)|).
+    // Adjacent leaves that fit in one are merged, so repeated edits do
+    // not leave a trail of tiny leaves behind.
+    static Node* join(Node* left, Node* right)
+    {
+        if (!left)
+            return right;
+        if (!right)
+            return left;
+
+        const SKuint32 hl = left->height;
+        const SKuint32 hr = right->height;
+
+        if (hl == 0 && hr == 0)
+        {
+            if (left->length + right->length > LeafSize)
+                return branch(left, right);
+
+            Node* node = leaf(left->data, left->length, LeafSize);
+            memcpy(node->data + node->length, right->data, right->length);
+            node->length += right->length;
+            release(left);
+            release(right);
+            return node;
+        }
+
+        // A lone leaf is carried down to the leaf on the other side.
+        if (hl > hr + 1 || (hr == 0 && hl > 0))
+        {
+            Node* ll = retain(left->left);
+            Node* lr = retain(left->right);
+            release(left);
+            return balance(ll, join(lr, right));
+        }
+
+        if (hr > hl + 1 || (hl == 0 && hr > 0))
+        {
+            Node* rl = retain(right->left);
+            Node* rr = retain(right->right);
+            release(right);
+            return balance(join(left, rl), rr);
+        }
+        return branch(left, right);
+    }
+
+    // Splits node into [0, pos) and [pos, length).
+    static void split(Node* node, SKsize pos, Node*& left, Node*& right)
+    {
+        if (!node || pos == 0)
+        {
+            left  = nullptr;
+            right = node;
+            return;
+        }
+
+        if (pos >= node->length)
+        {
+            left  = node;
+            right = nullptr;
+            return;
+        }
+
+        if (node->height == 0)
+        {
+            left  = leaf(node->data, pos, pos);
+            right = leaf(node->data + pos, node->length - pos, node->length - pos);
+            release(node);
+            return;
+        }
+
+        Node* nl = retain(node->left);
+        Node* nr = retain(node->right);
+        release(node);
+
+        if (pos < nl->length)
+        {
+            Node* a;
+            Node* b;
+            split(nl, pos, a, b);
+            left  = a;
+            right = join(b, nr);
+        }
+        else if (pos == nl->length)
+        {
+            left  = nl;
+            right = nr;
+        }
+        else
+        {
+            Node* a;
+            Node* b;
+            split(nr, pos - nl->length, a, b);
+            left  = join(nl, a);
+            right = b;
+        }
+    }
+
+    // Appends to the last leaf when every node on the way to it is
+    // owned by this rope alone and the leaf has room.
+    static bool appendInPlace(Node* node, const char* str, SKsize len)
+    {
+        if (!node || node->refs != 1)
+            return false;
+
+        if (node->height == 0)
+        {
+            if (node->capacity - node->length < len)
+                return false;
+
+            memcpy(node->data + node->length, str, len);
+            node->length += len;
+            return true;
+        }
+
+        if (!appendInPlace(node->right, str, len))
+            return false;
+
+        node->length += len;
+        return true;
+    }
+};
+
+skRope::Iterator::Iterator(const skRope& rope) :
+    m_stack(),
+    m_top(0)
+{
+    pushLeft(rope.m_root);
+}
+
+void skRope::Iterator::pushLeft(const Node* node)
+{
+    while (node)
+    {
+        SK_ASSERT(m_top < MaxDepth);
+        m_stack[m_top++] = node;
+        node             = node->left;
+    }
+}
+
+skStringView skRope::Iterator::getNext()
+{
+    SK_ASSERT(m_top > 0);
+
+    // The top of the stack is always a leaf.
+    const Node* node = m_stack[--m_top];
+
+    // Continue from the right child of the nearest branch whose left
+    // subtree was just finished.
+    if (m_top > 0)
+    {
+        const Node* parent = m_stack[--m_top];
+        pushLeft(parent->right);
+    }
+    return skStringView(node->data, node->length);
+}
+
+skRope::skRope() :
+    m_root(nullptr)
+{
+}
+
+skRope::skRope(const skStringView& str) :
+    m_root(nullptr)
+{
+    append(str);
+}
+
+skRope::skRope(const skRope& rhs) :
+    m_root(Tree::retain(rhs.m_root))
+{
+}
+
+skRope::skRope(Node* root) :
+    m_root(root)
+{
+}
+
+skRope::~skRope()
+{
+    Tree::release(m_root);
+}
+
+skRope& skRope::operator=(const skRope& rhs)
+{
+    if (this != &rhs)
+    {
+        Node* old = m_root;
+        m_root    = Tree::retain(rhs.m_root);
+        Tree::release(old);
+    }
+    return *this;
+}
+
+SKsize skRope::size() const
+{
+    return Tree::length(m_root);
+}
+
+SKuint32 skRope::depth() const
+{
+    return Tree::height(m_root);
+}
+
+void skRope::clear()
+{
+    Tree::release(m_root);
+    m_root = nullptr;
+}
+
+char skRope::at(SKsize pos) const
+{
+    SK_ASSERT(pos < size());
+
+    const Node* node = m_root;
+    while (node->height > 0)
+    {
+        if (pos < node->left->length)
+            node = node->left;
+        else
+        {
+            pos -= node->left->length;
+            node = node->right;
+        }
+    }
+    return node->data[pos];
+}
+
+void skRope::append(const skStringView& str)
+{
+    if (str.empty() || Tree::appendInPlace(m_root, str.ptr(), str.size()))
+        return;
+    m_root = Tree::join(m_root, Tree::build(str.ptr(), str.size()));
+}
+
+void skRope::append(const skRope& rhs)
+{
+    m_root = Tree::join(m_root, Tree::retain(rhs.m_root));
+}
+
+void skRope::insert(SKsize pos, const skStringView& str)
+{
+    if (pos >= size())
+    {
+        append(str);
+        return;
+    }
+
+    if (!str.empty())
+    {
+        Node* left;
+        Node* right;
+        Tree::split(m_root, pos, left, right);
+        m_root = Tree::join(Tree::join(left, Tree::build(str.ptr(), str.size())), right);
+    }
+}
+
+void skRope::insert(SKsize pos, const skRope& rhs)
+{
+    if (rhs.m_root)
+    {
+        // rhs may be this rope, so take the reference before splitting.
+        Node* middle = Tree::retain(rhs.m_root);
+
+        Node* left;
+        Node* right;
+        Tree::split(m_root, pos, left, right);
+        m_root = Tree::join(Tree::join(left, middle), right);
+    }
+}
+
+void skRope::erase(SKsize pos, SKsize nr)
+{
+    const SKsize len = size();
+    if (pos >= len || nr == 0)
+        return;
+    if (nr > len - pos)
+        nr = len - pos;
+
+    Node* left;
+    Node* rest;
+    Node* middle;
+    Node* right;
+    Tree::split(m_root, pos, left, rest);
+    Tree::split(rest, nr, middle, right);
+    Tree::release(middle);
+    m_root = Tree::join(left, right);
+}
+
+skRope skRope::substr(SKsize pos, SKsize nr) const
+{
+    const SKsize len = size();
+    if (pos >= len || nr == 0)
+        return skRope();
+    if (nr > len - pos)
+        nr = len - pos;
+
+    Node* left;
+    Node* rest;
+    Node* middle;
+    Node* right;
+    Tree::split(Tree::retain(m_root), pos, left, rest);
+    Tree::split(rest, nr, middle, right);
+    Tree::release(left);
+    Tree::release(right);
+    return skRope(middle);
+}
+
+void skRope::toString(skString& dest) const
+{
+    dest.clear();
+    dest.reserve(size());
+
+    Iterator it(*this);
+    while (it.hasMoreElements())
+        dest.append(it.getNext());
+}
+
+skString skRope::toString() const
+{
+    skString dest;
+    toString(dest);
+    return dest;
+}
+
+SKsize skRope::write(skStream& stream) const
+{
+    SKsize written = 0;
+
+    Iterator it(*this);
+    while (it.hasMoreElements())
+    {
+        const skStringView chunk = it.getNext();
+        written += stream.write(chunk.ptr(), chunk.size());
+    }
+    return written;
+}
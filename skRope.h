@@ -0,0 +1,145 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skRope_h_
+#define _skRope_h_
+
+#include "Utils/skStringView.h"
+
+class skString;
+class skStream;
+
+// A string stored as a balanced tree of chunks, for large text that is
+// edited in place or assembled from many pieces.
+//
+// Leaves hold up to LeafSize characters, and branches are kept AVL
+// balanced, so insert, erase, substr and indexing are O(log n) rather
+// than moving the whole buffer. Nodes are reference counted and never
+// changed while shared: copying a rope or taking a substr shares
+// structure with the original, and edits copy only the path they touch.
+// Appends extend the last leaf in place when nothing else shares it.
+//
+// Like the other containers, a rope and its copies must only be used
+// from one thread at a time.
+class skRope
+{
+private:
+    struct Node;
+    struct Tree;
+
+public:
+    static const SKsize npos;
+
+    enum
+    {
+        LeafSize = 1024,
+        MaxDepth = 96,
+    };
+
+    // Visits the chunks of a rope in order, as views into its leaves.
+    // The views are valid while the rope is not modified.
+    class Iterator
+    {
+    public:
+        explicit Iterator(const skRope& rope);
+
+        bool hasMoreElements() const
+        {
+            return m_top > 0;
+        }
+
+        skStringView getNext();
+
+    private:
+        friend class skRope;
+
+        const Node* m_stack[MaxDepth];
+        SKuint32    m_top;
+
+        void pushLeft(const Node* node);
+    };
+
+    skRope();
+    explicit skRope(const skStringView& str);
+    skRope(const skRope& rhs);
+    ~skRope();
+
+    skRope& operator=(const skRope& rhs);
+
+    SKsize size() const;
+
+    bool empty() const
+    {
+        return m_root == nullptr;
+    }
+
+    void clear();
+
+    // O(log n) character access.
+    char at(SKsize pos) const;
+
+    char operator[](SKsize pos) const
+    {
+        return at(pos);
+    }
+
+    void append(const skStringView& str);
+
+    // Shares rhs's nodes; O(log n) regardless of either size.
+    void append(const skRope& rhs);
+
+    void insert(SKsize pos, const skStringView& str);
+
+    void insert(SKsize pos, const skRope& rhs);
+
+    // Removes nr characters at pos; npos removes through the end.
+    void erase(SKsize pos, SKsize nr = npos);
+
+    // Shares the nodes of this rope; no characters are copied beyond the
+    // two leaves at the ends of the range.
+    skRope substr(SKsize pos, SKsize nr = npos) const;
+
+    Iterator iterator() const
+    {
+        return Iterator(*this);
+    }
+
+    void toString(skString& dest) const;
+
+    skString toString() const;
+
+    // Writes the chunks in order; returns the number of bytes written.
+    SKsize write(skStream& stream) const;
+
+    // The height of the tree, zero for a single leaf.
+    SKuint32 depth() const;
+
+private:
+    Node* m_root;
+
+    explicit skRope(Node* root);
+};
+
+#endif  //_skRope_h_
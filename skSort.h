@@ -26,61 +26,555 @@
 #ifndef _skSort_h_
 #define _skSort_h_
 
+#include <type_traits>
 #include "Config/skConfig.h"
 #include "skMinMax.h"
 
-template <typename T, typename C, typename SizeType = SKsize, SizeType npos = (SizeType)-1>
-struct skSort
+template <typename T>
+struct skLess
+{
+    bool operator()(const T& a, const T& b) const
+    {
+        return a < b;
+    }
+};
+
+template <typename T>
+struct skGreater
+{
+    bool operator()(const T& a, const T& b) const
+    {
+        return b < a;
+    }
+};
+
+// Adapts the int (*)(T, T) comparison used by the container sort methods.
+// A non-zero result means a belongs in front of b.
+template <typename T>
+struct skFunctionCompare
 {
     typedef int (*Function)(T a, T b);
-    typedef typename C::Iterator      Iterator;
-    typedef typename C::ReferenceType ReferenceType;
 
-    skSort(Function fnc = nullptr) :
-        m_sort(fnc)
+    Function m_function;
+
+    explicit skFunctionCompare(Function fnc) :
+        m_function(fnc)
     {
     }
 
-    Function m_sort;
+    bool operator()(const T& a, const T& b) const
+    {
+        return m_function(a, b) != 0;
+    }
+};
 
-    void sort(C& container)
+// Introsort with the pattern-defeating refinements from pdqsort:
+//
+// - input that is already in order, or in reverse, is finished in O(n)
+// - median of three pivots, or a pseudo median of nine on large ranges
+// - insertion sort below InsertionCutoff elements
+// - heapsort once the recursion depth passes 2 log2(n), so the worst case
+//   stays O(n log n)
+// - runs of elements equal to the previous pivot are split off in one
+//   pass, which keeps inputs with many duplicates linear per level
+// - a branch-free partition for arithmetic and pointer types
+//
+// Only the smaller side of each partition is recursed into, bounding the
+// stack depth by log2(n).
+template <typename T, typename Compare>
+class skIntroSortImpl
+{
+public:
+    enum
+    {
+        InsertionCutoff = 24,
+        NintherCutoff   = 128,
+    };
+
+    typedef typename std::integral_constant<bool,
+                                            std::is_arithmetic<T>::value ||
+                                                std::is_pointer<T>::value>
+        IsScalar;
+
+    static void sort(T* first, T* last, Compare& cmp)
+    {
+        const SKsize n = (SKsize)(last - first);
+        if (n < 2)
+            return;
+
+        if (presorted(first, last, cmp))
+            return;
+
+        int depth = 0;
+        for (SKsize i = n; i > 1; i >>= 1)
+            depth += 2;
+
+        loop(first, last, cmp, depth, true);
+    }
+
+    static void insertionSort(T* first, T* last, Compare& cmp)
+    {
+        if (last - first < 2)
+            return;
+
+        for (T* cur = first + 1; cur != last; ++cur)
+        {
+            if (cmp(*cur, cur[-1]))
+            {
+                T  tmp(*cur);
+                T* hole = cur;
+                do
+                {
+                    *hole = hole[-1];
+                    --hole;
+                } while (hole != first && cmp(tmp, hole[-1]));
+                *hole = tmp;
+            }
+        }
+    }
+
+    static void heapSort(T* first, T* last, Compare& cmp)
+    {
+        const SKsize n = (SKsize)(last - first);
+        if (n < 2)
+            return;
+
+        for (SKsize i = n / 2; i > 0; --i)
+            siftDown(first, i - 1, n, cmp);
+
+        for (SKsize end = n - 1; end > 0; --end)
+        {
+            skSwap(first[0], first[end]);
+            siftDown(first, 0, end, cmp);
+        }
+    }
+
+    // Quickselect with the same pivots and partitions as sort. Once the
+    // partitions have touched more than SelectBudget * n elements it
+    // switches to median of medians pivots, so the worst case stays O(n).
+    static void select(T* first, T* nth, T* last, Compare& cmp)
     {
-        SizeType size = container.size();
-        if (!m_sort || size < 2)
+        if (nth < first || nth >= last)
             return;
 
-        bool swapped = false;
+        SKsize budget   = SelectBudget * (SKsize)(last - first);
+        bool   leftmost = true;
+
+        while (last - first > InsertionCutoff)
+        {
+            const SKsize n = (SKsize)(last - first);
+            if (budget > n)
+            {
+                budget -= n;
+                choosePivot(first, last, cmp);
+            }
+            else
+                medianOfMedians(first, last, cmp);
+
+            if (!leftmost && !cmp(first[-1], *first))
+            {
+                T* equal = partitionEqual(first, last, cmp);
+                if (nth <= equal)
+                    return;
+                first = equal + 1;
+                continue;
+            }
+
+            T* pivot = partition(first, last, cmp, IsScalar());
+            if (pivot == nth)
+                return;
+
+            if (nth < pivot)
+                last = pivot;
+            else
+            {
+                first    = pivot + 1;
+                leftmost = false;
+            }
+        }
+        insertionSort(first, last, cmp);
+    }
+
+private:
+    enum
+    {
+        SelectBudget = 4,
+    };
+
+    // Leaves a pivot in *first that has at least 3/10 of the range on
+    // either side of it.
+    static void medianOfMedians(T* first, T* last, Compare& cmp)
+    {
+        T* medians = first;
+        for (T* group = first; last - group >= 5; group += 5)
+        {
+            insertionSort(group, group + 5, cmp);
+            skSwap(*medians++, group[2]);
+        }
+
+        T* mid = first + (medians - first) / 2;
+        select(first, mid, medians, cmp);
+        skSwap(*first, *mid);
+    }
+
+    // Handles input that is already ascending or strictly descending in
+    // one pass; any other input gives up at its first change of direction.
+    static bool presorted(T* first, T* last, Compare& cmp)
+    {
+        T* cur = first + 1;
+        if (!cmp(*cur, *first))
+        {
+            while (++cur != last && !cmp(*cur, cur[-1]))
+                ;
+            return cur == last;
+        }
+
+        while (++cur != last && cmp(*cur, cur[-1]))
+            ;
+        if (cur != last)
+            return false;
+
+        for (--last; first < last; ++first, --last)
+            skSwap(*first, *last);
+        return true;
+    }
+
+    static void loop(T* first, T* last, Compare& cmp, int depth, bool leftmost)
+    {
+        while (last - first > InsertionCutoff)
+        {
+            if (depth-- == 0)
+            {
+                heapSort(first, last, cmp);
+                return;
+            }
+
+            choosePivot(first, last, cmp);
+
+            // The element in front of a right hand range is an earlier pivot,
+            // so nothing here is less than it. If this pivot compares equal
+            // to it, everything equal can be set aside in one pass.
+            if (!leftmost && !cmp(first[-1], *first))
+            {
+                first = partitionEqual(first, last, cmp) + 1;
+                continue;
+            }
+
+            T* pivot = partition(first, last, cmp, IsScalar());
+
+            if (pivot - first < last - pivot)
+            {
+                loop(first, pivot, cmp, depth, leftmost);
+                first    = pivot + 1;
+                leftmost = false;
+            }
+            else
+            {
+                loop(pivot + 1, last, cmp, depth, false);
+                last = pivot;
+            }
+        }
+        insertionSort(first, last, cmp);
+    }
+
+    static void sort3(T* a, T* b, T* c, Compare& cmp)
+    {
+        if (cmp(*b, *a))
+            skSwap(*a, *b);
+        if (cmp(*c, *b))
+            skSwap(*b, *c);
+        if (cmp(*b, *a))
+            skSwap(*a, *b);
+    }
+
+    // Leaves the chosen pivot in *first.
+    static void choosePivot(T* first, T* last, Compare& cmp)
+    {
+        const SKsize n   = (SKsize)(last - first);
+        T*           mid = first + n / 2;
+
+        if (n > NintherCutoff)
+        {
+            const SKsize s = n / 8;
+            sort3(first, mid, last - 1, cmp);
+            sort3(first + s, mid - s, last - 1 - s, cmp);
+            sort3(first + 2 * s, mid + s, last - 1 - 2 * s, cmp);
+            sort3(mid - s, mid, mid + s, cmp);
+        }
+        else
+            sort3(first, mid, last - 1, cmp);
+
+        skSwap(*first, *mid);
+    }
+
+    // Moves everything not greater than the pivot in *first to the left.
+    // Returns the final position of the pivot.
+    static T* partitionEqual(T* first, T* last, Compare& cmp)
+    {
+        T* lo = first;
+        for (T* cur = first + 1; cur != last; ++cur)
+        {
+            if (!cmp(*first, *cur))
+            {
+                ++lo;
+                if (lo != cur)
+                    skSwap(*lo, *cur);
+            }
+        }
+        skSwap(*first, *lo);
+        return lo;
+    }
+
+    // Partitions [first + 1, last) around the pivot in *first into
+    // [less than, not less than] and returns the pivot's final position.
+    static T* partition(T* first, T* last, Compare& cmp, std::false_type)
+    {
+        const T& pivot = *first;
+
+        T* i = first + 1;
+        T* j = last - 1;
+        for (;;)
+        {
+            while (i <= j && cmp(*i, pivot))
+                ++i;
+            while (i <= j && !cmp(*j, pivot))
+                --j;
+            if (i >= j)
+                break;
+
+            skSwap(*i, *j);
+            ++i;
+            --j;
+        }
+
+        --i;
+        skSwap(*first, *i);
+        return i;
+    }
+
+    // Lomuto partition with an unconditional swap, so the only data
+    // dependent work is the increment of lo.
+    static T* partition(T* first, T* last, Compare& cmp, std::true_type)
+    {
+        const T pivot = *first;
+
+        T* lo = first + 1;
+        for (T* cur = first + 1; cur != last; ++cur)
+        {
+            const T    value = *cur;
+            const bool less  = cmp(value, pivot);
+
+            *cur = *lo;
+            *lo  = value;
+            lo += less;
+        }
+
+        --lo;
+        *first = *lo;
+        *lo    = pivot;
+        return lo;
+    }
 
-        SizeType i;
-        do
+    static void siftDown(T* base, SKsize hole, SKsize n, Compare& cmp)
+    {
+        T tmp(base[hole]);
+        for (;;)
         {
-            if (size - 1 == npos)
+            SKsize child = 2 * hole + 1;
+            if (child >= n)
+                break;
+            if (child + 1 < n && cmp(base[child], base[child + 1]))
+                ++child;
+            if (!cmp(tmp, base[child]))
                 break;
 
-            Iterator it = container.iterator();
+            base[hole] = base[child];
+            hole       = child;
+        }
+        base[hole] = tmp;
+    }
+};
+
+// Sorts [first, last) so that cmp(b, a) is false for every a before b.
+// Not stable.
+template <typename T, typename Compare>
+void skIntroSort(T* first, T* last, Compare cmp)
+{
+    skIntroSortImpl<T, Compare>::sort(first, last, cmp);
+}
+
+template <typename T>
+void skIntroSort(T* first, T* last)
+{
+    skIntroSort(first, last, skLess<T>());
+}
+
+template <typename T, typename Compare>
+void skHeapSort(T* first, T* last, Compare cmp)
+{
+    skIntroSortImpl<T, Compare>::heapSort(first, last, cmp);
+}
+
+template <typename T, typename Compare>
+void skInsertionSort(T* first, T* last, Compare cmp)
+{
+    skIntroSortImpl<T, Compare>::insertionSort(first, last, cmp);
+}
+
+// Bottom up merge sort. Runs of RunLength elements are insertion sorted
+// in place, then merged in passes that alternate between the input and a
+// scratch buffer of the same length. Equal elements keep their order.
+template <typename T, typename Compare>
+class skMergeSortImpl
+{
+public:
+    enum
+    {
+        RunLength = 32,
+    };
+
+    static void sort(T* first, T* last, T* scratch, Compare& cmp)
+    {
+        const SKsize n = (SKsize)(last - first);
+        if (n < 2)
+            return;
+
+        T* cur = first + 1;
+        while (cur != last && !cmp(*cur, cur[-1]))
+            ++cur;
+        if (cur == last)
+            return;
+
+        for (SKsize i = 0; i < n; i += RunLength)
+            skIntroSortImpl<T, Compare>::insertionSort(first + i, first + skMin<SKsize>(i + RunLength, n), cmp);
 
-            for (i = 0; i < size - 1; ++i)
+        T* src = first;
+        T* dst = scratch;
+        for (SKsize width = RunLength; width < n; width *= 2)
+        {
+            for (SKsize lo = 0; lo < n; lo += 2 * width)
             {
-                ReferenceType a = it.getNext();
-                ReferenceType b = it.peekNext();
+                const SKsize mid = skMin<SKsize>(lo + width, n);
+                const SKsize hi  = skMin<SKsize>(mid + width, n);
+                merge(src + lo, src + mid, src + hi, dst + lo, cmp);
+            }
+            skSwap(src, dst);
+        }
 
-                if (!m_sort(a, b))
-                {
-                    swapped = true;
-                    skSwap<T>(a, b);
-                }
+        if (src != first)
+            copy(src, src + n, first);
+    }
+
+private:
+    static void copy(const T* first, const T* last, T* dst)
+    {
+        while (first != last)
+            *dst++ = *first++;
+    }
+
+    // Merges [a, mid) and [mid, last) into dst. Ties are taken from the
+    // left so that equal elements stay in order.
+    static void merge(const T* a, const T* mid, const T* last, T* dst, Compare& cmp)
+    {
+        const T* b = mid;
+        if (a != mid && b != last && cmp(*b, mid[-1]))
+        {
+            while (a != mid && b != last)
+            {
+                if (cmp(*b, *a))
+                    *dst++ = *b++;
+                else
+                    *dst++ = *a++;
             }
-            size -= 1;
-        } while (swapped && size != npos);
+        }
+        copy(a, mid, dst);
+        copy(b, last, dst + (mid - a));
     }
 };
 
+// Stable sort of [first, last) in O(n log n). scratch must hold
+// last - first elements.
+template <typename T, typename Compare>
+void skStableSort(T* first, T* last, T* scratch, Compare cmp)
+{
+    skMergeSortImpl<T, Compare>::sort(first, last, scratch, cmp);
+}
+
+// Places the element that belongs at nth after a full sort there, with
+// nothing ordered after it in front of it and nothing ordered in front of
+// it after it. O(n) in the worst case.
+template <typename T, typename Compare>
+void skNthElement(T* first, T* nth, T* last, Compare cmp)
+{
+    skIntroSortImpl<T, Compare>::select(first, nth, last, cmp);
+}
+
+// Sorts the middle - first smallest elements into [first, middle). The
+// order of the rest is unspecified. O(n + k log k) for k = middle - first.
+template <typename T, typename Compare>
+void skPartialSort(T* first, T* middle, T* last, Compare cmp)
+{
+    if (middle <= first)
+        return;
+
+    if (middle >= last)
+        skIntroSortImpl<T, Compare>::sort(first, last, cmp);
+    else
+    {
+        skIntroSortImpl<T, Compare>::select(first, middle - 1, last, cmp);
+        skIntroSortImpl<T, Compare>::sort(first, middle - 1, cmp);
+    }
+}
+
+// Sorts containers that can only be walked with an iterator, such as
+// skList. The values are gathered into a scratch buffer, sorted there
+// and written back in order.
+template <typename T, typename C, typename SizeType = SKsize, SizeType npos = (SizeType)-1>
+struct skSort
+{
+    typedef int (*Function)(T a, T b);
+    typedef typename C::Iterator Iterator;
+
+    skSort(Function fnc = nullptr) :
+        m_sort(fnc)
+    {
+    }
+
+    Function m_sort;
+
+    void sort(C& container)
+    {
+        if (m_sort)
+            sort(container, skFunctionCompare<T>(m_sort));
+    }
+
+    template <typename Compare>
+    static void sort(C& container, Compare cmp)
+    {
+        const SizeType size = container.size();
+        if (size < 2 || size == npos)
+            return;
+
+        T*       scratch = new T[size];
+        Iterator it      = container.iterator();
+        for (SizeType i = 0; i < size; ++i)
+            scratch[i] = it.getNext();
+
+        skIntroSort(scratch, scratch + size, cmp);
+
+        it = container.iterator();
+        for (SizeType i = 0; i < size; ++i)
+            it.getNext() = scratch[i];
+        delete[] scratch;
+    }
+};
+
+// Sorts contiguous containers in place with skIntroSort.
 template <typename T, typename C, typename SizeType = SKsize, SizeType npos = (SizeType)-1>
 class skQSort
 {
 public:
     typedef int (*Function)(T a, T b);
-    typedef typename C::ReferenceType ReferenceType;
 
 private:
     Function m_sort;
@@ -93,45 +587,54 @@ public:
 
     void sort(C& container)
     {
-        SizeType size = container.size();
-        if (!m_sort || size < 2)
+        if (m_sort)
+            sort(container, skFunctionCompare<T>(m_sort));
+    }
+
+    template <typename Compare>
+    static void sort(C& container, Compare cmp)
+    {
+        const SizeType size = container.size();
+        if (size < 2 || size == npos)
             return;
 
-        _sort(container, 0, size - 1);
+        T* base = container.ptr();
+        skIntroSort(base, base + size, cmp);
     }
 
-private:
-    void _sort(C& container, SizeType first, SizeType last)
+    template <typename Compare>
+    static void stableSort(C& container, Compare cmp)
     {
-        SizeType pivot;
+        const SizeType size = container.size();
+        if (size < 2 || size == npos)
+            return;
 
-        if (first < last && last != npos)
-        {
-            pivot = _partition(container, first, last);
-            _sort(container, first, pivot - 1);
-            _sort(container, pivot + 1, last);
-        }
+        T* base    = container.ptr();
+        T* scratch = new T[size];
+        skStableSort(base, base + size, scratch, cmp);
+        delete[] scratch;
     }
 
-    SizeType _partition(C& container, SizeType first, SizeType last)
+    template <typename Compare>
+    static void partialSort(C& container, SizeType k, Compare cmp)
     {
-        SizeType lo;
+        const SizeType size = container.size();
+        if (size < 2 || size == npos)
+            return;
 
-        skSwap(container[first], container[(first + last) / 2]);
+        T* base = container.ptr();
+        skPartialSort(base, base + skMin(k, size), base + size, cmp);
+    }
 
-        ReferenceType pivot = container[first];
-        lo                  = first;
-        for (SizeType i = first + 1; i <= last; ++i)
-        {
-            if (m_sort(container[i], pivot) != 0)
-            {
-                ++lo;
-                if (lo != i)
-                    skSwap(container[lo], container[i]);
-            }
-        }
-        skSwap(container[first], container[lo]);
-        return lo;
+    template <typename Compare>
+    static void nthElement(C& container, SizeType k, Compare cmp)
+    {
+        const SizeType size = container.size();
+        if (k >= size || size == npos)
+            return;
+
+        T* base = container.ptr();
+        skNthElement(base, base + k, base + size, cmp);
     }
 };
 
@@ -0,0 +1,255 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSortNetwork_h_
+#define _skSortNetwork_h_
+
+#include "Config/skConfig.h"
+#include "skSort.h"
+
+// The largest element count that is sorted with a network.
+const SKsize skSortNetworkLimit = 32;
+
+// Orders a and b. Arithmetic and pointer types select with conditional
+// moves, which compile to min / max or cmov instead of a branch.
+template <typename T, typename Compare, bool Scalar = skIntroSortImpl<T, Compare>::IsScalar::value>
+struct skCompareExchange
+{
+    static SK_INLINE void apply(T& a, T& b, Compare& cmp)
+    {
+        const T    x    = a;
+        const T    y    = b;
+        const bool swap = cmp(y, x);
+
+        a = swap ? y : x;
+        b = swap ? x : y;
+    }
+};
+
+template <typename T, typename Compare>
+struct skCompareExchange<T, Compare, false>
+{
+    static SK_INLINE void apply(T& a, T& b, Compare& cmp)
+    {
+        if (cmp(b, a))
+            skSwap(a, b);
+    }
+};
+
+// Merges the sorted ranges [I, I + X) and [J, J + Y) with the comparators
+// of the Bose-Nelson construction.
+template <SKsize I, SKsize X, SKsize J, SKsize Y,
+          int Kind = (X == 0 || Y == 0) ? 0 : (X == 1 && Y == 1) ? 1
+                                          : (X == 1 && Y == 2)   ? 2
+                                          : (X == 2 && Y == 1)   ? 3
+                                                                 : 4>
+struct skBoseNelsonMerge
+{
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T*, Compare&)
+    {
+    }
+};
+
+template <SKsize I, SKsize X, SKsize J, SKsize Y>
+struct skBoseNelsonMerge<I, X, J, Y, 1>
+{
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T* d, Compare& cmp)
+    {
+        skCompareExchange<T, Compare>::apply(d[I], d[J], cmp);
+    }
+};
+
+template <SKsize I, SKsize X, SKsize J, SKsize Y>
+struct skBoseNelsonMerge<I, X, J, Y, 2>
+{
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T* d, Compare& cmp)
+    {
+        skCompareExchange<T, Compare>::apply(d[I], d[J + 1], cmp);
+        skCompareExchange<T, Compare>::apply(d[I], d[J], cmp);
+    }
+};
+
+template <SKsize I, SKsize X, SKsize J, SKsize Y>
+struct skBoseNelsonMerge<I, X, J, Y, 3>
+{
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T* d, Compare& cmp)
+    {
+        skCompareExchange<T, Compare>::apply(d[I], d[J], cmp);
+        skCompareExchange<T, Compare>::apply(d[I + 1], d[J], cmp);
+    }
+};
+
+template <SKsize I, SKsize X, SKsize J, SKsize Y>
+struct skBoseNelsonMerge<I, X, J, Y, 4>
+{
+    enum
+    {
+        A = X / 2,
+        B = (X & 1) ? Y / 2 : (Y + 1) / 2,
+    };
+
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T* d, Compare& cmp)
+    {
+        skBoseNelsonMerge<I, A, J, B>::apply(d, cmp);
+        skBoseNelsonMerge<I + A, X - A, J + B, Y - B>::apply(d, cmp);
+        skBoseNelsonMerge<I + A, X - A, J, B>::apply(d, cmp);
+    }
+};
+
+// Sorts [I, I + N) by sorting both halves and merging them.
+template <SKsize I, SKsize N, bool Leaf = (N < 2)>
+struct skBoseNelsonSort
+{
+    enum
+    {
+        A = N / 2,
+    };
+
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T* d, Compare& cmp)
+    {
+        skBoseNelsonSort<I, A>::apply(d, cmp);
+        skBoseNelsonSort<I + A, N - A>::apply(d, cmp);
+        skBoseNelsonMerge<I, A, I + A, N - A>::apply(d, cmp);
+    }
+};
+
+template <SKsize I, SKsize N>
+struct skBoseNelsonSort<I, N, true>
+{
+    template <typename T, typename Compare>
+    static SK_INLINE void apply(T*, Compare&)
+    {
+    }
+};
+
+// Picks the network for n elements, for any n up to N.
+template <SKsize N, bool Leaf = (N < 2)>
+struct skSortNetworkDispatch
+{
+    template <typename T, typename Compare>
+    static void apply(T* d, SKsize n, Compare& cmp)
+    {
+        if (n == N)
+            skBoseNelsonSort<0, N>::apply(d, cmp);
+        else
+            skSortNetworkDispatch<N - 1>::apply(d, n, cmp);
+    }
+};
+
+template <SKsize N>
+struct skSortNetworkDispatch<N, true>
+{
+    template <typename T, typename Compare>
+    static void apply(T*, SKsize, Compare&)
+    {
+    }
+};
+
+// Sorts n elements, where n is at most L and L is at most
+// skSortNetworkLimit. Only the networks for sizes up to L are generated.
+template <SKsize L, typename T, typename Compare>
+void skSortNetwork(T* data, SKsize n, Compare cmp)
+{
+    static_assert(L <= skSortNetworkLimit, "no sorting network above skSortNetworkLimit");
+    SK_ASSERT(n <= L);
+    skSortNetworkDispatch<L>::apply(data, n, cmp);
+}
+
+// The sort for fixed capacity containers. Containers that hold at most
+// skSortNetworkLimit elements are sorted with a network, larger ones with
+// skIntroSort. Everything else is shared with skQSort.
+template <typename T, typename C, typename SizeType, SKsize L>
+class skNetworkSort
+{
+public:
+    typedef skQSort<T, C, SizeType>     BaseType;
+    typedef typename BaseType::Function Function;
+
+    typedef std::integral_constant<bool, L <= skSortNetworkLimit> UseNetwork;
+
+private:
+    Function m_sort;
+
+public:
+    skNetworkSort(Function fnc = nullptr) :
+        m_sort(fnc)
+    {
+    }
+
+    void sort(C& container)
+    {
+        if (m_sort)
+            sort(container, skFunctionCompare<T>(m_sort));
+    }
+
+    template <typename Compare>
+    static void sort(C& container, Compare cmp)
+    {
+        const SizeType size = container.size();
+        if (size < 2 || size > L)
+            return;
+
+        sort(container.ptr(), (SKsize)size, cmp, UseNetwork());
+    }
+
+    template <typename Compare>
+    static void stableSort(C& container, Compare cmp)
+    {
+        BaseType::stableSort(container, cmp);
+    }
+
+    template <typename Compare>
+    static void partialSort(C& container, SizeType k, Compare cmp)
+    {
+        BaseType::partialSort(container, k, cmp);
+    }
+
+    template <typename Compare>
+    static void nthElement(C& container, SizeType k, Compare cmp)
+    {
+        BaseType::nthElement(container, k, cmp);
+    }
+
+private:
+    template <typename Compare>
+    static void sort(T* base, SKsize size, Compare& cmp, std::true_type)
+    {
+        skSortNetworkDispatch<L>::apply(base, size, cmp);
+    }
+
+    template <typename Compare>
+    static void sort(T* base, SKsize size, Compare& cmp, std::false_type)
+    {
+        skIntroSort(base, base + size, cmp);
+    }
+};
+
+#endif  //_skSortNetwork_h_
@@ -26,6 +26,7 @@
 #include "skStreams.h"
 #include <cstdarg>
 #include <cstdio>
+#include "skFormat.h"
 #include "skPlatformHeaders.h"
 
 skStream::skStream() :
@@ -39,37 +40,17 @@ skStream::~skStream()
 
 SKsize skStream::writef(const char* format, ...)
 {
-    char*        buf = nullptr;
-    std::va_list l1;
-    int          s1, s2;
-    SKsize       bw = 0;
-
+    SKsize bw = 0;
     if (format != nullptr)
     {
+        std::va_list l1;
         va_start(l1, format);
-        s1 = std::vsnprintf(buf, 0, format, l1);
+
+        skStreamFormatWriter out(*this);
+        skFormatPrintf(out, format, l1);
         va_end(l1);
 
-        if (s1 > 0)
-        {
-            buf = (char*)::malloc(s1 + 1);
-            if (buf)
-            {
-                va_start(l1, format);
-                s2 = std::vsnprintf(buf, s1 + 1, format, l1);
-                va_end(l1);
-                if (s2 > 0)
-                {
-                    buf[s2] = 0;
-                    bw      = write(buf, s2);
-                }
-                else
-                    printf("vsnprintf returned an error\n");
-                free(buf);
-            }
-            else
-                printf("Alloc failed: skStream::writef\n");
-        }
+        bw = out.written();
     }
     return bw;
 }
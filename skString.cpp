@@ -27,76 +27,94 @@
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include "skFileStream.h"
+#include "skFormat.h"
 #include "skPlatformHeaders.h"
 #include "skStringConverter.h"
+#include "skStringTokenizer.h"
 
 const SKsize   skString::npos = -1;
+const SKsize   skString::InlineCapacity;
 const skString skString::Blank;
 
-skString::skString() :
-    m_data(nullptr),
-    m_size(0),
-    m_capacity(0)
+skString::skString()
 {
+    init();
 }
 
-skString::skString(const ValueType* str, SKsize len) :
-    m_data(nullptr),
-    m_size(0),
-    m_capacity(0)
+skString::skString(const ValueType* str, SKsize len)
 {
+    init();
     alloc(str, len);
 }
 
-skString::skString(const skString& str) :
-    m_data(nullptr),
-    m_size(0),
-    m_capacity(0)
+skString::skString(const skString& str)
 {
+    init();
     alloc(str.c_str(), str.size());
 }
 
-skString::skString(const char ch, SKsize nr) :
-    m_data(nullptr),
-    m_size(0),
-    m_capacity(0)
+skString::skString(const char ch, SKsize nr)
 {
+    init();
     alloc(ch, nr);
 }
 
+skString::skString(const skStringView& str)
+{
+    init();
+    if (!str.empty())
+        alloc(str.ptr(), str.size());
+}
+
 skString::~skString()
 {
     clear();
 }
 
+void skString::init()
+{
+    m_heap.data     = nullptr;
+    m_heap.size     = 0;
+    m_heap.capacity = 0;
+}
+
 void skString::clear(void)
 {
-    if (m_data)
-    {
-        delete[] m_data;
-        m_data = nullptr;
-    }
-    m_size     = 0;
-    m_capacity = 0;
+    if (!isInline())
+        delete[] m_heap.data;
+    init();
 }
 
 void skString::reserve(SKsize nr)
 {
-    if (m_capacity < nr)
+    if (capacity() >= nr)
+        return;
+
+    if (nr <= InlineCapacity)
     {
-        ValueType* ptr = new ValueType[nr + 2];
-        //skMemset(ptr, 0, nr + 2);
+        // Only the empty string has less room than the inline buffer.
+        SK_ASSERT(!m_heap.data);
+        m_inline[0]       = 0;
+        m_inline[TagByte] = (char)InlineFlag;
+        return;
+    }
 
-        if (m_data)
-        {
-            skMemcpy(ptr, m_data, m_size);
-            delete[] m_data;
-        }
+    const SKsize      len = size();
+    const PointerType old = ptr();
+    ValueType*        buf = new ValueType[nr + 2];
 
-        m_data     = ptr;
-        m_capacity = nr + 1;
-    }
+    if (old)
+        skMemcpy(buf, old, len);
+    buf[len] = 0;
+
+    if (!isInline())
+        delete[] old;
+
+    m_heap.data = buf;
+    m_heap.size = len;
+    setHeapCapacity(nr + 1);
 }
 
 void skString::assign(const skString& rhs)
@@ -107,48 +125,92 @@ void skString::assign(const skString& rhs)
         return;
     }
 
-    if (m_size < rhs.size())
-        resize(rhs.size());
-
-    SK_ASSERT(m_data);
-    if (!m_data)
-        return;
-    skMemcpy(m_data, rhs.m_data, m_size);
-    m_data[m_size] = 0;
+    resize(rhs.size());
+    skMemcpy(ptr(), rhs.c_str(), rhs.size());
 }
 
 void skString::resize(SKsize nr)
 {
-    if (nr < m_size)
-        m_data[nr] = 0;
-    else if (nr > m_size)
+    const SKsize len = size();
+    if (nr < len)
+        ptr()[nr] = 0;
+    else if (nr > len)
+    {
         reserve(nr);
-    m_size = nr;
+        ptr()[nr] = 0;
+    }
+    else
+        return;
+    setSize(nr);
 }
 
 bool skString::equals(const skString& rhs) const
 {
-    return !skChar::equals(m_data, rhs.m_data);
+    return size() == rhs.size() && skChar::compare(c_str(), rhs.c_str(), size()) == 0;
 }
 
 bool skString::equals(const char* rhs) const
 {
-    return !skChar::equalsn(m_data, rhs, m_size);
+    return !skChar::equalsn(c_str(), rhs, size());
+}
+
+bool skString::equals(const skStringView& rhs) const
+{
+    return compare(rhs) == 0;
+}
+
+int skString::compare(const skStringView& rhs) const
+{
+    return skStringView(c_str(), size()).compare(rhs);
+}
+
+int skString::compareNoCase(const skStringView& rhs) const
+{
+    return skStringView(c_str(), size()).compareNoCase(rhs);
+}
+
+bool skString::equalsNoCase(const skStringView& rhs) const
+{
+    return skStringView(c_str(), size()).equalsNoCase(rhs);
+}
+
+int skString::compare(const skString& rhs) const
+{
+    const SKsize lhsLen = size();
+    const SKsize rhsLen = rhs.size();
+
+    const int result = skChar::compare(c_str(), rhs.c_str(), skMin(lhsLen, rhsLen));
+    if (result != 0)
+        return result;
+
+    if (lhsLen == rhsLen)
+        return 0;
+    return lhsLen < rhsLen ? -1 : 1;
 }
 
 bool skString::endsWith(const char* str) const
 {
     const SKsize len = skChar::length(str);
-    if (len > 0 && len < m_size)
-        return skChar::equalsn(m_data + (m_size-len), str, len) == 0;
+    if (len > 0 && len < size())
+        return skChar::equalsn(c_str() + (size() - len), str, len) == 0;
     return false;
 }
 
+bool skString::endsWith(const skStringView& str) const
+{
+    return skStringView(c_str(), size()).endsWith(str);
+}
+
+bool skString::startsWith(const skStringView& str) const
+{
+    return skStringView(c_str(), size()).startsWith(str);
+}
+
 bool skString::startsWith(const char* str) const
 {
     const SKsize len = skChar::length(str);
-    if (len > 0 && len < m_size)
-        return skChar::equalsn(m_data, str, len) == 0;
+    if (len > 0 && len < size())
+        return skChar::equalsn(c_str(), str, len) == 0;
     return false;
 }
 
@@ -164,25 +226,24 @@ void skString::alloc(const char* str, SKsize len)
     {
         reserve(len);
 
-        if (m_data)
-        {
-            skChar::copyn(m_data, str, len);
-            m_data[len] = 0;
-            m_size      = len;
-        }
+        PointerType data = ptr();
+        skMemcpy(data, str, len);
+        data[len] = 0;
+        setSize(len);
     }
 }
 
 void skString::alloc(const char p, SKsize len)
 {
-    m_size = len;
-    reserve(m_size);
-
-    if (m_data)
+    if (len > 0)
     {
-        while (len != npos)
-            m_data[len--] = p;
-        m_data[m_size] = 0;
+        reserve(len);
+
+        PointerType data = ptr();
+        for (SKsize i = 0; i < len; ++i)
+            data[i] = p;
+        data[len] = 0;
+        setSize(len);
     }
 }
 
@@ -191,8 +252,7 @@ void skString::alloc(SKsize len, const void* p)
     if (len != npos && p != nullptr)
     {
         resize(len);
-        skMemcpy(m_data, p, m_size);
-        m_data[m_size] = 0;
+        skMemcpy(ptr(), p, len);
     }
 }
 
@@ -205,9 +265,10 @@ skString& skString::operator=(const skString& rhs)
 
 void skString::swap(skString& rhs) noexcept
 {
-    skSwap(m_data, rhs.m_data);
-    skSwap(m_size, rhs.m_size);
-    skSwap(m_capacity, rhs.m_capacity);
+    char tmp[StorageSize];
+    skMemcpy(tmp, m_inline, StorageSize);
+    skMemcpy(m_inline, rhs.m_inline, StorageSize);
+    skMemcpy(rhs.m_inline, tmp, StorageSize);
 }
 
 skString skString::substr(SKsize pos, SKsize nr) const
@@ -219,15 +280,16 @@ skString skString::substr(SKsize pos, SKsize nr) const
 
 void skString::substr(skString& dest, SKsize pos, SKsize nr) const
 {
-    if (nr != npos && pos != npos && pos < m_size)
+    const SKsize len = size();
+    if (nr != npos && pos != npos && pos < len)
     {
         if (nr == 0)
-            nr = m_size;
+            nr = len;
 
-        if (nr + pos > m_size)
-            nr = m_size - pos;
+        if (nr + pos > len)
+            nr = len - pos;
 
-        skString oth(m_data + pos, nr);
+        skString oth(c_str() + pos, nr);
         dest.swap(oth);
     }
 }
@@ -240,64 +302,48 @@ void skString::split(skArray<skString>& dst, char op) const
 
 void skString::split(skArray<skString>& dst, const char* op) const
 {
-    if (m_size == 0 || !op || !*op)
+    const SKsize total = size();
+    if (total == 0 || !op || !*op)
         return;
 
-    dst.reserve(32);
-    skString     sub;
-    const SKsize len = strlen(op);
+    const skStringView source(c_str(), total);
+    const skStringView separator(op);
 
-    SKsize j = 0;
-    for (SKsize i = 0; i < m_size && i != npos;)
+    SKsize start = 0;
+    while (start < total)
     {
-        i = find(op, j);
+        SKsize end = source.find(separator, start);
+        if (end == npos)
+            end = total;
 
-        if (i == 0)
-            j += len;
-        else
-        {
-            if (i != npos)
-            {
-                substr(sub, j, i);
-                if (!sub.empty())
-                    dst.push_back(sub);
-                j += i + len;
-            }
-            else
-            {
-                if (j < m_size && j != npos)
-                {
-                    substr(sub, j, m_size);
-                    if (!sub.empty())
-                        dst.push_back(sub);
-                }
-                break;
-            }
-        }
+        if (end > start)
+            dst.push_back(skString(source.substr(start, end - start)));
+        start = end + separator.size();
     }
 }
 
+void skString::splitViews(skArray<skStringView>& dst, const char* delims, bool keepEmpty) const
+{
+    skStringTokenizer::split(dst, view(), skDelimiterSet(delims), keepEmpty);
+}
+
+void skString::splitViews(skArray<skStringView>& dst, char delim, bool keepEmpty) const
+{
+    skStringTokenizer::split(dst, view(), skDelimiterSet(delim), keepEmpty);
+}
+
 skString skString::format(const char* fmt, ...)
 {
     skString dst;
     if (fmt)
     {
         va_list lst;
-
         va_start(lst, fmt);
-        const int size = std::vsnprintf(nullptr, 0, fmt, lst);
-        va_end(lst);
 
-        if (size > 0)
-        {
-            dst.resize((SKsize)size);
-
-            va_start(lst, fmt);
-            std::vsnprintf(dst.ptr(), (size_t)size + 1, fmt, lst);
-            va_end(lst);
-        }
+        skStringFormatWriter out(dst);
+        skFormatPrintf(out, fmt, lst);
+        va_end(lst);
     }
-
     return dst;
 }
 
@@ -305,20 +351,14 @@ void skString::format(skString& dst, const char* fmt, ...)
 {
     if (fmt)
     {
-        va_list lst;
+        dst.resize(0);
 
+        va_list lst;
         va_start(lst, fmt);
-        const int size = std::vsnprintf(nullptr, 0, fmt, lst);
-        va_end(lst);
-
-        if (size > 0)
-        {
-            dst.resize((SKsize)size);
 
-            va_start(lst, fmt);
-            std::vsnprintf(dst.ptr(), (size_t)size + 1, fmt, lst);
-            va_end(lst);
-        }
+        skStringFormatWriter out(dst);
+        skFormatPrintf(out, fmt, lst);
+        va_end(lst);
     }
 }
 
@@ -348,39 +388,33 @@ void skString::fromFile(skString& dest, const char* path)
 
 SKsize skString::find(char ch) const
 {
-    if (m_data != nullptr)
-    {
-        char* ptr = strchr(m_data, (int)ch);
-        if (ptr)
-        {
-            const SKsize diff = ptr - m_data;
-            if (diff > 0)
-                return (SKsize)diff;
-        }
-    }
-    return npos;
+    return skChar::find(c_str(), size(), ch);
 }
 
 SKsize skString::find(const char* ch, SKsize offs) const
 {
-    SKsize rv = npos;
-    if (m_data != nullptr && offs < m_size)
-    {
-        char* sp  = m_data + offs;
-        char* ptr = strstr(sp, ch);
-        if (ptr)
-            rv = ptr - sp;
-    }
-    return rv;
+    if (ch != nullptr && offs < size())
+        return skChar::find(c_str() + offs, size() - offs, ch, skChar::length(ch));
+    return npos;
+}
+
+SKsize skString::find(const skStringView& str, SKsize offs) const
+{
+    const SKsize pos = skStringView(c_str(), size()).find(str, offs);
+    return pos != npos ? pos - offs : npos;
 }
 
 skString& skString::append(char ch)
 {
-    if (m_size + 1 > m_capacity)
-        reserve(m_size + 1);
+    const SKsize len = size();
+    if (len + 1 > capacity())
+        reserve(len + 1);
+
+    PointerType data = ptr();
 
-    m_data[m_size]   = ch;
-    m_data[++m_size] = 0;
+    data[len]     = ch;
+    data[len + 1] = 0;
+    setSize(len + 1);
 
     return *this;
 }
@@ -392,13 +426,25 @@ skString& skString::append(const char* rhs, SKsize rhsLen)
         if (!rhsLen)
             rhsLen = skChar::length(rhs);
 
-        reserve(m_size + rhsLen);
-
-        char* src = m_data + m_size;
-        skMemcpy(src, rhs, rhsLen);
+        const SKsize len = size();
+        if (len + rhsLen > capacity())
+        {
+            // rhs may point into this string, which reserve can move.
+            const char* data = c_str();
+            if (data && rhs >= data && rhs <= data + len)
+            {
+                const SKsize offs = (SKsize)(rhs - data);
+                reserve(len + rhsLen);
+                rhs = c_str() + offs;
+            }
+            else
+                reserve(len + rhsLen);
+        }
 
-        m_size += rhsLen;
-        m_data[m_size] = 0;
+        PointerType data = ptr();
+        skMemcpy(data + len, rhs, rhsLen);
+        data[len + rhsLen] = 0;
+        setSize(len + rhsLen);
     }
 
     return *this;
@@ -406,10 +452,10 @@ skString& skString::append(const char* rhs, SKsize rhsLen)
 
 SKsize skString::copy(char* arr, SKsize nr, SKsize offs) const
 {
-    if (!arr || !m_data || nr + offs > m_size)
+    if (!arr || !c_str() || nr + offs > size())
         return 0;
 
-    char* src = m_data + offs;
+    const char* src = c_str() + offs;
 
     SKsize i;
 
@@ -421,32 +467,34 @@ SKsize skString::copy(char* arr, SKsize nr, SKsize offs) const
 
 skString& skString::erase(SKsize pos, SKsize nr)
 {
-    if (!m_data)
+    PointerType data = ptr();
+    if (!data)
         return *this;
 
-    if (nr == 0 && pos < m_size)
+    const SKsize len = size();
+    if (nr == 0 && pos < len)
     {
-        m_size         = pos;
-        m_data[m_size] = 0;
+        data[pos] = 0;
+        setSize(pos);
         return *this;
     }
 
-    if (nr >= m_size && pos == 0)
+    if (nr >= len && pos == 0)
     {
-        m_size         = 0;
-        m_data[m_size] = 0;
+        data[0] = 0;
+        setSize(0);
         return *this;
     }
 
     const SKsize left = pos;
-    if (left > m_size)
+    if (left > len)
         return *this;
 
     SKsize right = left + nr;
-    if (right > m_size)
-        right = m_size;
+    if (right > len)
+        right = len;
 
-    swap(substr(0, left).append(substr(right, m_size)));
+    swap(substr(0, left).append(substr(right, len)));
     return *this;
 }
 
@@ -454,20 +502,19 @@ void skString::toHex(void)
 {
     static const char* HexTable = "0123456789ABCDEF";
 
-    if (m_size == 0)
+    const SKsize oldSize = size();
+    if (oldSize == 0)
         return;
 
-    const SKsize oldSize = m_size;
-
-    resize(m_size * 2);
+    resize(oldSize * 2);
 
-    const char* cp = m_data;
-    char*       dp = m_data;
+    const char* cp = ptr();
+    char*       dp = ptr();
 
     if (cp == nullptr)
         return;
 
-    SKsize j = m_size;
+    SKsize j = size();
     for (SKsize i = oldSize - 1; i != npos; --i)
     {
         const int iVal = (int)(unsigned char)cp[i];
@@ -476,20 +523,21 @@ void skString::toHex(void)
         dp[--j]        = HexTable[rv];
         dp[--j]        = HexTable[dv];
     }
-    dp[m_size] = 0;
+    dp[size()] = 0;
 }
 
 void skString::fromHex(void)
 {
     skString result;
-    result.resize(m_size / 2);
+    const SKsize len = size();
+    result.resize(len / 2);
 
-    const char* cp = m_data;
+    const char* cp = c_str();
     char*       dp = result.ptr();
 
     int    rv;
     SKsize j = 0;
-    for (SKsize i = 0; i < m_size; i += 2)
+    for (SKsize i = 0; i < len; i += 2)
     {
         const char c0 = cp[i + 0];
         const char c1 = cp[i + 1];
@@ -517,11 +565,13 @@ static const SKuint16 BinaryTable[9] = {256, 128, 64, 32, 16, 8, 4, 2, 1};
 void skString::toBinary(void)
 {
     skString s;
-    s.reserve(9 * m_size + 2);
+    const char*  data = c_str();
+    const SKsize len  = size();
+    s.reserve(9 * len + 2);
 
-    for (SKsize i = 0; i < m_size; ++i)
+    for (SKsize i = 0; i < len; ++i)
     {
-        SKuint16 c = (SKuint8)m_data[i];
+        SKuint16 c = (SKuint8)data[i];
 
         if (c < BinaryTable[0])
         {
@@ -30,6 +30,7 @@
 #include "Utils/skArray.h"
 #include "Utils/skChar.h"
 #include "Utils/skMap.h"
+#include "Utils/skStringView.h"
 
 using skStringConverter = skChar;
 
@@ -49,9 +50,66 @@ public:
     [[deprecated("Avoid at exit deconstruction calls.")]] static const skString Blank;
 
 protected:
-    PointerType m_data;
-    SKsize      m_size;
-    SKsize      m_capacity;
+    // Strings of up to InlineCapacity characters are stored in the object
+    // itself. The last byte of the storage tells the two apart: inline
+    // strings keep their size there with InlineFlag set, while on the
+    // heap it is the top byte of the capacity, which is always clear.
+    struct Heap
+    {
+        PointerType data;
+        SKsize      size;
+        SKsize      capacity;
+    };
+
+    enum
+    {
+        StorageSize = sizeof(Heap),
+        TagByte     = StorageSize - 1,
+        InlineFlag  = 0x80,
+    };
+
+    union
+    {
+        Heap m_heap;
+        char m_inline[StorageSize];
+    };
+
+    bool isInline() const
+    {
+        return ((SKuint8)m_inline[TagByte] & InlineFlag) != 0;
+    }
+
+#if SK_ENDIAN == SK_ENDIAN_BIG
+    SKsize heapCapacity() const
+    {
+        return m_heap.capacity >> 8;
+    }
+
+    void setHeapCapacity(SKsize cap)
+    {
+        m_heap.capacity = cap << 8;
+    }
+#else
+    SKsize heapCapacity() const
+    {
+        return m_heap.capacity;
+    }
+
+    void setHeapCapacity(SKsize cap)
+    {
+        m_heap.capacity = cap;
+    }
+#endif
+
+    void setSize(SKsize nr)
+    {
+        if (isInline())
+            m_inline[TagByte] = (char)(InlineFlag | nr);
+        else
+            m_heap.size = nr;
+    }
+
+    void init();
 
     void alloc(const char* str, SKsize len);
 
@@ -60,32 +118,56 @@ protected:
     void alloc(SKsize len, const void* p);
 
 public:
+    // The longest string that is stored without a heap allocation.
+    static const SKsize InlineCapacity = StorageSize - 2;
+
     skString();
 
     skString(const ValueType* str, SKsize len = 0);
     skString(const skString& str);
     skString(char ch, SKsize nr);
+    explicit skString(const skStringView& str);
 
     ~skString();
 
+    operator skStringView() const
+    {
+        return skStringView(c_str(), size());
+    }
+
     bool operator==(const skString& rhs) const
     {
-        return !skChar::equals(m_data, rhs.m_data);
+        return equals(rhs);
     }
 
     bool operator!=(const skString& rhs) const
     {
-        return skChar::equals(m_data, rhs.m_data) != 0;
+        return !equals(rhs);
+    }
+
+    bool operator<(const skString& rhs) const
+    {
+        return compare(rhs) < 0;
+    }
+
+    bool operator==(const skStringView& rhs) const
+    {
+        return equals(rhs);
+    }
+
+    bool operator!=(const skStringView& rhs) const
+    {
+        return !equals(rhs);
     }
 
     bool operator==(const ValueType* rhs) const
     {
-        return !skChar::equals(m_data, rhs);
+        return !skChar::equals(c_str(), rhs);
     }
 
     bool operator!=(const ValueType* rhs) const
     {
-        return skChar::equals(m_data, rhs) != 0;
+        return skChar::equals(c_str(), rhs) != 0;
     }
 
     skString operator+(const char ch) const
@@ -118,10 +200,15 @@ public:
         return this->append(rhs);
     }
 
+    skString& operator+=(const skStringView& rhs)
+    {
+        return this->append(rhs);
+    }
+
     char operator[](const SKsize idx) const
     {
-        if (idx < m_size)
-            return m_data ? m_data[idx] : '\0';
+        if (idx < size())
+            return ptr()[idx];
         return 0;
     }
 
@@ -131,6 +218,9 @@ public:
 
     SKsize find(const char* ch, SKsize offs = 0) const;
 
+    // Like find(const char*), the result is relative to offs.
+    SKsize find(const skStringView& str, SKsize offs = 0) const;
+
     skString& erase(SKsize pos, SKsize nr = 0);
 
     skString& append(char ch);
@@ -139,6 +229,13 @@ public:
 
     skString substr(SKsize pos, SKsize nr) const;
 
+    // The same range as substr, without copying it. The view is only
+    // valid until this string is modified.
+    skStringView view(SKsize pos = 0, SKsize nr = npos) const
+    {
+        return skStringView(c_str(), size()).substr(pos, nr);
+    }
+
     void substr(skString& dest, SKsize pos, SKsize nr = 0) const;
 
     void swap(skString& rhs) noexcept;
@@ -149,6 +246,13 @@ public:
 
     void split(skArray<skString>& dst, char op) const;
 
+    // Appends a view of each piece between any of the characters in
+    // delims to dst. The views are only valid until this string is
+    // modified. Empty pieces are skipped unless keepEmpty is set.
+    void splitViews(skArray<skStringView>& dst, const char* delims, bool keepEmpty = false) const;
+
+    void splitViews(skArray<skStringView>& dst, char delim, bool keepEmpty = false) const;
+
     void toBinary();
 
     void fromBinary();
@@ -169,10 +273,26 @@ public:
 
     bool equals(const char* rhs) const;
 
+    bool equals(const skStringView& rhs) const;
+
+    // Byte-wise ordering; returns <0, 0 or >0.
+    int compare(const skString& rhs) const;
+
+    int compare(const skStringView& rhs) const;
+
+    // Like compare, with ASCII letters folded to lower case.
+    int compareNoCase(const skStringView& rhs) const;
+
+    bool equalsNoCase(const skStringView& rhs) const;
+
     bool endsWith(const char* str) const;
 
     bool startsWith(const char* str) const;
 
+    bool endsWith(const skStringView& str) const;
+
+    bool startsWith(const skStringView& str) const;
+
     static skString format(const char* fmt, ...);
 
     static void format(skString& dst, const char* fmt, ...);
@@ -198,105 +318,125 @@ public:
         return append(rhs.c_str(), rhs.size());
     }
 
+    skString& append(const skStringView& rhs)
+    {
+        if (!rhs.empty())
+            append(rhs.ptr(), rhs.size());
+        return *this;
+    }
+
     ConstPointerType c_str() const
     {
-        return m_data;
+        return ptr();
+    }
+
+    PointerType ptr()
+    {
+        return isInline() ? m_inline : m_heap.data;
     }
 
-    PointerType ptr() const
+    ConstPointerType ptr() const
     {
-        return m_data;
+        return isInline() ? m_inline : m_heap.data;
+    }
+
+    // The skHash of the contents, computed on every call. Keys that are
+    // looked up repeatedly can use skHashedString, which keeps it.
+    SKhash hash() const
+    {
+        return skHash(c_str(), size());
     }
 
     SKsize size() const
     {
-        return m_size;
+        return isInline() ? (SKuint8)m_inline[TagByte] & ~InlineFlag : m_heap.size;
     }
 
     SKsize capacity() const
     {
-        return m_capacity;
+        return isInline() ? InlineCapacity : heapCapacity();
     }
 
     bool empty() const
     {
-        return m_size == 0 || !m_data || m_data[0] == 0;
+        const ConstPointerType data = ptr();
+        return size() == 0 || !data || data[0] == 0;
     }
 
     char at(const SKsize idx) const
     {
         SK_ASSERT(idx != npos);
-        return m_data && idx < m_size ? m_data[idx] : '\0';
+        return idx < size() ? ptr()[idx] : '\0';
     }
 
     Iterator iterator()
     {
-        return m_data && m_size > 0 ? Iterator(m_data, m_size) : Iterator();
+        return size() > 0 ? Iterator(ptr(), size()) : Iterator();
     }
 
     ConstIterator iterator() const
     {
-        return m_data && m_size > 0 ? ConstIterator(m_data, m_size) : ConstIterator();
+        return size() > 0 ? ConstIterator(const_cast<PointerType>(ptr()), size()) : ConstIterator();
     }
 
     ReverseIterator reverseIterator()
     {
-        return m_data && m_size > 0 ? ReverseIterator(m_data, m_size) : ReverseIterator();
+        return size() > 0 ? ReverseIterator(ptr(), size()) : ReverseIterator();
     }
 
     ConstReverseIterator reverseIterator() const
     {
-        return m_data && m_size > 0 ? ConstReverseIterator(m_data, m_size) : ConstReverseIterator();
+        return size() > 0 ? ConstReverseIterator(const_cast<PointerType>(ptr()), size()) : ConstReverseIterator();
     }
 
     bool toBoolean() const
     {
-        return skChar::toBool(m_data);
+        return skChar::toBool(c_str());
     }
 
     [[deprecated]] SKint32 toInteger() const
     {
-        return skChar::toInt32(m_data);
+        return skChar::toInt32(c_str());
     }
 
     SKint16 toInt16(SKint16 def = -1) const
     {
-        return skChar::toInt16(m_data, def);
+        return skChar::toInt16(*this, def);
     }
 
     SKint32 toInt32(SKint32 def = -1) const
     {
-        return skChar::toInt32(m_data, def);
+        return skChar::toInt32(*this, def);
     }
 
     SKint64 toInt64(SKint64 def = -1) const
     {
-        return skChar::toInt64(m_data, def);
+        return skChar::toInt64(*this, def);
     }
 
     SKuint16 toUint16(SKuint16 def = SK_NPOS16) const
     {
-        return skChar::toUint16(m_data, def);
+        return skChar::toUint16(*this, def);
     }
 
     SKuint32 toUint32(SKuint32 def = SK_NPOS32) const
     {
-        return skChar::toUint32(m_data, def);
+        return skChar::toUint32(*this, def);
     }
 
     SKuint64 toUint64(SKuint64 def = (SKuint64)-1) const
     {
-        return skChar::toUint64(m_data, def);
+        return skChar::toUint64(*this, def);
     }
 
     float toFloat(float def = 0.f) const
     {
-        return skChar::toFloat(m_data, def);
+        return skChar::toFloat(*this, def);
     }
 
     double toDouble(double def = 0.0) const
     {
-        return skChar::toDouble(m_data, def);
+        return skChar::toDouble(*this, def);
     }
 };
 
@@ -304,9 +444,111 @@ typedef skArray<skString> skStringArray;
 
 inline SKhash skHash(const skString& key)
 {
-    return skHash(key.c_str());
+    return key.hash();
+}
+
+template <>
+struct skIsHashLookup<skString, skStringView> : std::true_type
+{
+};
+
+// A read-only string key that computes its hash once and keeps it, for
+// keys that are inserted into or looked up in hash tables repeatedly.
+// skString does not cache its hash, which keeps it three pointers wide.
+class skHashedString
+{
+private:
+    skString       m_string;
+    mutable SKhash m_hash;
+
+public:
+    skHashedString() :
+        m_hash(SK_NPOS)
+    {
+    }
+
+    skHashedString(const char* str, SKsize len = 0) :
+        m_string(str, len),
+        m_hash(SK_NPOS)
+    {
+    }
+
+    skHashedString(const skString& str) :
+        m_string(str),
+        m_hash(SK_NPOS)
+    {
+    }
+
+    explicit skHashedString(const skStringView& str) :
+        m_string(str),
+        m_hash(SK_NPOS)
+    {
+    }
+
+    operator skStringView() const
+    {
+        return m_string;
+    }
+
+    const skString& str() const
+    {
+        return m_string;
+    }
+
+    const char* c_str() const
+    {
+        return m_string.c_str();
+    }
+
+    SKsize size() const
+    {
+        return m_string.size();
+    }
+
+    bool empty() const
+    {
+        return m_string.empty();
+    }
+
+    // The same value as skString::hash, computed on first use.
+    SKhash hash() const
+    {
+        if (m_hash == SK_NPOS)
+            m_hash = m_string.hash();
+        return m_hash;
+    }
+
+    bool operator==(const skHashedString& rhs) const
+    {
+        return m_string == rhs.m_string;
+    }
+
+    bool operator!=(const skHashedString& rhs) const
+    {
+        return m_string != rhs.m_string;
+    }
+
+    bool operator==(const skStringView& rhs) const
+    {
+        return m_string == rhs;
+    }
+
+    bool operator!=(const skStringView& rhs) const
+    {
+        return m_string != rhs;
+    }
+};
+
+inline SKhash skHash(const skHashedString& key)
+{
+    return key.hash();
 }
 
+template <>
+struct skIsHashLookup<skHashedString, skStringView> : std::true_type
+{
+};
+
 extern int skSprintf(char* dst, int maxSize, const char* fmt, ...);
 
 #endif  //_skString_h_
@@ -83,6 +83,13 @@ SKsize skStringBuilder::writeToBuffer(const void* source, SKsize len)
     return SK_NPOS;
 }
 
+template <typename T>
+void skStringBuilder::writeInteger(T v)
+{
+    char digits[skChar::MaxIntegerChars];
+    writeToBuffer(digits, skChar::toChars(digits, v));
+}
+
 void skStringBuilder::write(const skStringBuilder& oth)
 {
     if (oth.size() > 0)
@@ -95,6 +102,12 @@ void skStringBuilder::write(const skString& str)
         writeToBuffer(str.c_str(), str.size());
 }
 
+void skStringBuilder::write(const skStringView& str)
+{
+    if (!str.empty())
+        writeToBuffer(str.ptr(), str.size());
+}
+
 void skStringBuilder::write(SKbyte ch)
 {
     writeToBuffer(&ch, 1);
@@ -114,56 +127,42 @@ void skStringBuilder::write(const SKbyte* ptr, SKsize len)
 
 void skStringBuilder::write(SKint16 i16)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, i16);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKint64)i16);
 }
 
 void skStringBuilder::write(SKint32 i32)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, i32);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKint64)i32);
 }
 
 void skStringBuilder::write(SKint64 i64)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, i64);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKint64)i64);
 }
 
 void skStringBuilder::write(SKuint16 u16)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, u16);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKuint64)u16);
 }
 
 void skStringBuilder::write(SKuint32 u32)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, u32);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKuint64)u32);
 }
 
 void skStringBuilder::write(SKuint64 u64)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, u64);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    writeInteger((SKuint64)u64);
 }
 
 void skStringBuilder::write(double d)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, d);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    char digits[skChar::MaxFloatChars];
+    writeToBuffer(digits, skChar::toChars(digits, d));
 }
 
 void skStringBuilder::write(float f)
 {
-    m_dest.resize(0);
-    skChar::toString(m_dest, f);
-    writeToBuffer(m_dest.c_str(), m_dest.size());
+    char digits[skChar::MaxFloatChars];
+    writeToBuffer(digits, skChar::toChars(digits, f));
 }
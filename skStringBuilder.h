@@ -37,12 +37,11 @@ enum skStringBuilderStrategy
 class skStringBuilder
 {
 private:
-    SKbyte*  m_buffer;
-    SKsize   m_size;
-    SKsize   m_capacity;
-    SKsize   m_nByteBlock;
-    SKuint8  m_strategy;
-    skString m_dest;
+    SKbyte* m_buffer;
+    SKsize  m_size;
+    SKsize  m_capacity;
+    SKsize  m_nByteBlock;
+    SKuint8 m_strategy;
 
     void reserve(SKsize len);
 
@@ -50,6 +49,9 @@ private:
 
     SKsize writeToBuffer(const void* source, SKsize len);
 
+    template <typename T>
+    void writeInteger(T v);
+
 public:
     skStringBuilder() :
         m_buffer(nullptr),
@@ -121,6 +123,8 @@ public:
 
     void write(const skString& str);
 
+    void write(const skStringView& str);
+
     void write(SKbyte ch);
 
     void write(const SKbyte* ptr);
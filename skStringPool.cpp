@@ -0,0 +1,216 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/skStringPool.h"
+#include <cstddef>
+#include <cstring>
+#include "Utils/skMemoryUtils.h"
+
+skStringPool::skStringPool() :
+    m_nextId(1)
+{
+    for (Shard& shard : m_shards)
+    {
+        shard.table     = nullptr;
+        shard.capacity  = 0;
+        shard.count     = 0;
+        shard.blocks    = nullptr;
+        shard.cursor    = nullptr;
+        shard.remaining = 0;
+        shard.allocated = 0;
+    }
+}
+
+skStringPool::~skStringPool()
+{
+    for (Shard& shard : m_shards)
+    {
+        Block* block = shard.blocks;
+        while (block)
+        {
+            Block* next = block->next;
+            skFree(block);
+            block = next;
+        }
+        delete[] shard.table;
+    }
+}
+
+// Spreads FNV's weak low bits over the word, so both the shard index
+// and the table slot can be taken directly from the result.
+SKhash skStringPool::mix(SKhash hash)
+{
+    SKuint64 x = (SKuint64)hash;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return (SKhash)x;
+}
+
+skStringPool::Shard& skStringPool::shardOf(SKhash hash)
+{
+    return m_shards[(mix(hash) >> 24) & (ShardCount - 1)];
+}
+
+const skStringPool::Shard& skStringPool::shardOf(SKhash hash) const
+{
+    return m_shards[(mix(hash) >> 24) & (ShardCount - 1)];
+}
+
+const skStringPool::Entry* skStringPool::lookup(const Shard& shard, const skStringView& str, SKhash hash)
+{
+    if (shard.count == 0)
+        return nullptr;
+
+    const SKuint32 mask = shard.capacity - 1;
+    for (SKuint32 i = (SKuint32)mix(hash) & mask;; i = (i + 1) & mask)
+    {
+        const Entry* entry = shard.table[i];
+        if (!entry)
+            return nullptr;
+
+        if (entry->hash == hash && entry->size == str.size() &&
+            (str.size() == 0 || memcmp(entry->data, str.ptr(), str.size()) == 0))
+            return entry;
+    }
+}
+
+skStringPool::Entry* skStringPool::allocate(Shard& shard, SKsize len)
+{
+    const SKsize align = sizeof(SKhash);
+    const SKsize need  = (offsetof(Entry, data) + len + 1 + align - 1) & ~(align - 1);
+
+    if (need > BlockSize / 4)
+    {
+        // Long strings get a block of their own, so they do not waste
+        // the rest of the current one.
+        Block* block = (Block*)skMalloc(sizeof(Block) + need);
+        block->next  = shard.blocks;
+        block->size  = sizeof(Block) + need;
+        shard.blocks = block;
+
+        shard.allocated += block->size;
+        return (Entry*)(block + 1);
+    }
+
+    if (need > shard.remaining)
+    {
+        Block* block = (Block*)skMalloc(BlockSize);
+        block->next  = shard.blocks;
+        block->size  = BlockSize;
+        shard.blocks = block;
+
+        shard.cursor    = (char*)(block + 1);
+        shard.remaining = BlockSize - sizeof(Block);
+        shard.allocated += BlockSize;
+    }
+
+    Entry* entry = (Entry*)shard.cursor;
+    shard.cursor += need;
+    shard.remaining -= need;
+    return entry;
+}
+
+void skStringPool::insert(Shard& shard, Entry* entry)
+{
+    const SKuint32 mask = shard.capacity - 1;
+
+    SKuint32 i = (SKuint32)mix(entry->hash) & mask;
+    while (shard.table[i])
+        i = (i + 1) & mask;
+
+    shard.table[i] = entry;
+    ++shard.count;
+}
+
+void skStringPool::grow(Shard& shard)
+{
+    Entry**        old      = shard.table;
+    const SKuint32 capacity = shard.capacity;
+
+    shard.capacity = capacity ? capacity * 2 : (SKuint32)InitialSize;
+    shard.table    = new Entry*[shard.capacity]();
+    shard.count    = 0;
+
+    for (SKuint32 i = 0; i < capacity; ++i)
+    {
+        if (old[i])
+            insert(shard, old[i]);
+    }
+    delete[] old;
+}
+
+skAtom skStringPool::intern(const skStringView& str)
+{
+    const SKhash hash  = skHash(str);
+    Shard&       shard = shardOf(hash);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    const Entry* found = lookup(shard, str, hash);
+    if (found)
+        return skAtom(found);
+
+    SK_ASSERT(str.size() < SK_NPOS32);
+
+    Entry* entry = allocate(shard, str.size());
+    entry->hash  = hash;
+    entry->id    = m_nextId.fetch_add(1, std::memory_order_relaxed);
+    entry->size  = (SKuint32)str.size();
+    if (str.size() > 0)
+        memcpy(entry->data, str.ptr(), str.size());
+    entry->data[str.size()] = 0;
+
+    // Keep the load at or under one half, so probes stay short.
+    if ((shard.count + 1) * 2 > shard.capacity)
+        grow(shard);
+    insert(shard, entry);
+    return skAtom(entry);
+}
+
+skAtom skStringPool::find(const skStringView& str) const
+{
+    const SKhash hash  = skHash(str);
+    const Shard& shard = shardOf(hash);
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return skAtom(lookup(shard, str, hash));
+}
+
+SKsize skStringPool::size() const
+{
+    return m_nextId.load(std::memory_order_relaxed) - 1;
+}
+
+SKsize skStringPool::memoryUsed() const
+{
+    SKsize total = 0;
+    for (const Shard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        total += shard.allocated + shard.capacity * sizeof(Entry*);
+    }
+    return total;
+}
@@ -0,0 +1,202 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skStringPool_h_
+#define _skStringPool_h_
+
+#include <atomic>
+#include <mutex>
+#include "Utils/skStringView.h"
+
+class skStringPool;
+
+// A handle to a string interned in an skStringPool.
+//
+// A pool stores each distinct string once, so two atoms from the same
+// pool are equal exactly when they point at the same entry, and
+// comparing them never looks at the characters. The default atom is
+// null and reads as an empty string.
+class skAtom
+{
+public:
+    skAtom() :
+        m_entry(nullptr)
+    {
+    }
+
+    bool isNull() const
+    {
+        return m_entry == nullptr;
+    }
+
+    const char* c_str() const
+    {
+        return m_entry ? m_entry->data : "";
+    }
+
+    SKsize size() const
+    {
+        return m_entry ? m_entry->size : 0;
+    }
+
+    skStringView view() const
+    {
+        return skStringView(c_str(), size());
+    }
+
+    operator skStringView() const
+    {
+        return view();
+    }
+
+    // Dense per pool identifier, starting at one. The null atom is zero.
+    SKuint32 id() const
+    {
+        return m_entry ? m_entry->id : 0;
+    }
+
+    // The string's hash, computed once when it was interned.
+    // Equals skHash(view()).
+    SKhash hash() const
+    {
+        return m_entry ? m_entry->hash : skHash(skStringView());
+    }
+
+    bool operator==(const skAtom& rhs) const
+    {
+        return m_entry == rhs.m_entry;
+    }
+
+    bool operator!=(const skAtom& rhs) const
+    {
+        return m_entry != rhs.m_entry;
+    }
+
+    // Orders by id, which is the interning order, not by the characters.
+    bool operator<(const skAtom& rhs) const
+    {
+        return id() < rhs.id();
+    }
+
+private:
+    friend class skStringPool;
+
+    struct Entry
+    {
+        SKhash   hash;
+        SKuint32 id;
+        SKuint32 size;
+        char     data[1];
+    };
+
+    explicit skAtom(const Entry* entry) :
+        m_entry(entry)
+    {
+    }
+
+    const Entry* m_entry;
+};
+
+// Identity hash for skHashTable keys. Ids are unique within a pool, so
+// keys never collide, and the string is never rehashed.
+inline SKhash skHash(const skAtom& atom)
+{
+    return (SKhash)atom.id();
+}
+
+// Interns strings into an arena and hands out skAtom handles.
+//
+// The pool is split into shards selected by the string hash, each with
+// its own lock, open addressed table and arena, so threads interning
+// different strings rarely wait on each other. Entries are never moved
+// or freed before the pool is destroyed, which keeps every atom valid
+// for the lifetime of the pool.
+class skStringPool
+{
+public:
+    skStringPool();
+    ~skStringPool();
+
+    // Returns the atom for str, adding it on first use.
+    // Safe to call from multiple threads.
+    skAtom intern(const skStringView& str);
+
+    // Returns the atom for str, or the null atom if it was never interned.
+    skAtom find(const skStringView& str) const;
+
+    // The number of distinct strings interned.
+    SKsize size() const;
+
+    // Bytes held by the arenas and tables.
+    SKsize memoryUsed() const;
+
+private:
+    typedef skAtom::Entry Entry;
+
+    enum
+    {
+        ShardBits   = 4,
+        ShardCount  = 1 << ShardBits,
+        BlockSize   = 16384,
+        InitialSize = 64,
+    };
+
+    struct Block
+    {
+        Block* next;
+        SKsize size;
+    };
+
+    struct alignas(SK_CACHE_LINE) Shard
+    {
+        mutable std::mutex lock;
+
+        Entry**  table;
+        SKuint32 capacity;
+        SKuint32 count;
+
+        Block* blocks;
+        char*  cursor;
+        SKsize remaining;
+        SKsize allocated;
+    };
+
+    Shard                 m_shards[ShardCount];
+    std::atomic<SKuint32> m_nextId;
+
+    static SKhash       mix(SKhash hash);
+    static const Entry* lookup(const Shard& shard, const skStringView& str, SKhash hash);
+    static Entry*       allocate(Shard& shard, SKsize len);
+    static void         insert(Shard& shard, Entry* entry);
+    static void         grow(Shard& shard);
+
+    Shard&       shardOf(SKhash hash);
+    const Shard& shardOf(SKhash hash) const;
+
+    skStringPool(const skStringPool&)            = delete;
+    skStringPool& operator=(const skStringPool&) = delete;
+};
+
+#endif  //_skStringPool_h_
@@ -0,0 +1,206 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/skStringTokenizer.h"
+#include "Utils/skMinMax.h"
+#ifdef SK_SSE2
+#include <emmintrin.h>
+#endif
+
+skDelimiterSet::skDelimiterSet() :
+    m_table(),
+    m_chars(),
+    m_count(0)
+{
+}
+
+skDelimiterSet::skDelimiterSet(char ch) :
+    m_table(),
+    m_chars(),
+    m_count(0)
+{
+    insert(ch);
+}
+
+skDelimiterSet::skDelimiterSet(const char* chars) :
+    m_table(),
+    m_chars(),
+    m_count(0)
+{
+    if (chars)
+    {
+        while (*chars)
+            insert(*chars++);
+    }
+}
+
+void skDelimiterSet::insert(char ch)
+{
+    if (contains(ch))
+        return;
+
+    const SKuint8 c = (SKuint8)ch;
+    m_table[c >> 5] |= 1u << (c & 31);
+
+    if (m_count < VectorLimit)
+        m_chars[m_count] = ch;
+    ++m_count;
+}
+
+SKuint64 skDelimiterSet::scan(const char* str, SKsize len) const
+{
+#ifdef SK_SSE2
+    if (len >= BlockSize && m_count > 0 && m_count <= VectorLimit)
+    {
+        SKuint64 mask = 0;
+        for (int part = 0; part < 4; ++part)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(str + part * 16));
+
+            __m128i hits = _mm_cmpeq_epi8(block, _mm_set1_epi8(m_chars[0]));
+            for (SKuint32 k = 1; k < m_count; ++k)
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_set1_epi8(m_chars[k])));
+
+            mask |= (SKuint64)(SKuint32)_mm_movemask_epi8(hits) << (part * 16);
+        }
+        return mask;
+    }
+#endif
+
+    if (len > BlockSize)
+        len = BlockSize;
+
+    SKuint64 mask = 0;
+    for (SKsize i = 0; i < len; ++i)
+    {
+        if (contains(str[i]))
+            mask |= (SKuint64)1 << i;
+    }
+    return mask;
+}
+
+SKsize skDelimiterSet::find(const char* str, SKsize len) const
+{
+    for (SKsize i = 0; i < len; i += BlockSize)
+    {
+        const SKuint64 mask = scan(str + i, len - i);
+        if (mask)
+            return i + skTrailingZeros(mask);
+    }
+    return len;
+}
+
+skStringTokenizer::skStringTokenizer(const skStringView& input, const skDelimiterSet& delimiters, bool keepEmpty) :
+    m_delimiters(delimiters),
+    m_data(input.ptr()),
+    m_size(input.size()),
+    m_start(0),
+    m_block(0),
+    m_mask(0),
+    m_hasToken(false),
+    m_keepEmpty(keepEmpty)
+{
+    reset();
+}
+
+skStringTokenizer::skStringTokenizer(const skStringView& input, const char* delimiters, bool keepEmpty) :
+    m_delimiters(delimiters),
+    m_data(input.ptr()),
+    m_size(input.size()),
+    m_start(0),
+    m_block(0),
+    m_mask(0),
+    m_hasToken(false),
+    m_keepEmpty(keepEmpty)
+{
+    reset();
+}
+
+skStringTokenizer::skStringTokenizer(const skStringView& input, char delimiter, bool keepEmpty) :
+    m_delimiters(delimiter),
+    m_data(input.ptr()),
+    m_size(input.size()),
+    m_start(0),
+    m_block(0),
+    m_mask(0),
+    m_hasToken(false),
+    m_keepEmpty(keepEmpty)
+{
+    reset();
+}
+
+void skStringTokenizer::reset()
+{
+    m_start = 0;
+    m_block = 0;
+    m_mask  = m_size > 0 ? m_delimiters.scan(m_data, m_size) : 0;
+    advance();
+}
+
+SKsize skStringTokenizer::nextDelimiter()
+{
+    while (m_mask == 0)
+    {
+        if (m_block + (SKsize)skDelimiterSet::BlockSize >= m_size)
+            return m_size;
+
+        m_block += (SKsize)skDelimiterSet::BlockSize;
+        m_mask = m_delimiters.scan(m_data + m_block, m_size - m_block);
+    }
+
+    const SKsize pos = m_block + skTrailingZeros(m_mask);
+    m_mask &= m_mask - 1;
+    return pos;
+}
+
+void skStringTokenizer::advance()
+{
+    while (m_start <= m_size)
+    {
+        const SKsize start = m_start;
+        const SKsize end   = nextDelimiter();
+
+        m_start = end + 1;
+        if (end > start || (m_keepEmpty && m_size > 0))
+        {
+            m_token    = skStringView(m_data + start, end - start);
+            m_hasToken = true;
+            return;
+        }
+    }
+
+    m_token    = skStringView();
+    m_hasToken = false;
+}
+
+void skStringTokenizer::split(skArray<skStringView>& dest,
+                              const skStringView&    input,
+                              const skDelimiterSet&  delimiters,
+                              bool                   keepEmpty)
+{
+    skStringTokenizer tokens(input, delimiters, keepEmpty);
+    while (tokens.hasMoreElements())
+        dest.push_back(tokens.getNext());
+}
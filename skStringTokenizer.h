@@ -0,0 +1,139 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skStringTokenizer_h_
+#define _skStringTokenizer_h_
+
+#include "Utils/skArray.h"
+#include "Utils/skStringView.h"
+
+// A set of single character delimiters. Sets of up to VectorLimit
+// characters are matched 16 bytes at a time where SSE2 is available,
+// larger sets one byte at a time through a lookup table.
+class skDelimiterSet
+{
+public:
+    enum
+    {
+        VectorLimit = 8,
+        BlockSize   = 64,
+    };
+
+private:
+    SKuint32 m_table[8];
+    char     m_chars[VectorLimit];
+    SKuint32 m_count;
+
+    void insert(char ch);
+
+public:
+    skDelimiterSet();
+
+    explicit skDelimiterSet(char ch);
+
+    // Every character of the NUL terminated chars is a delimiter.
+    explicit skDelimiterSet(const char* chars);
+
+    bool contains(char ch) const
+    {
+        const SKuint8 c = (SKuint8)ch;
+        return (m_table[c >> 5] >> (c & 31) & 1) != 0;
+    }
+
+    SKuint32 size() const
+    {
+        return m_count;
+    }
+
+    // Returns a mask with bit i set when str[i] is a delimiter, for the
+    // first min(len, BlockSize) characters of str.
+    SKuint64 scan(const char* str, SKsize len) const;
+
+    // Returns the offset of the first delimiter in str, or len if there
+    // is none.
+    SKsize find(const char* str, SKsize len) const;
+};
+
+// Splits a view into tokens on demand, without copying them. Delimiter
+// positions are found a block at a time, so short tokens cost little
+// more than reading the bit that ends them. Runs of delimiters produce
+// no empty tokens unless keepEmpty is set, in which case n delimiters
+// always give n + 1 tokens.
+//
+// skStringTokenizer tokens("a,b,,c", ",");
+// while (tokens.hasMoreElements())
+//     use(tokens.getNext());
+class skStringTokenizer
+{
+private:
+    skDelimiterSet m_delimiters;
+    const char*    m_data;
+    SKsize         m_size;
+    SKsize         m_start;
+    SKsize         m_block;
+    SKuint64       m_mask;
+    skStringView   m_token;
+    bool           m_hasToken;
+    bool           m_keepEmpty;
+
+    SKsize nextDelimiter();
+
+    void advance();
+
+public:
+    skStringTokenizer(const skStringView& input, const skDelimiterSet& delimiters, bool keepEmpty = false);
+
+    skStringTokenizer(const skStringView& input, const char* delimiters, bool keepEmpty = false);
+
+    skStringTokenizer(const skStringView& input, char delimiter, bool keepEmpty = false);
+
+    bool hasMoreElements() const
+    {
+        return m_hasToken;
+    }
+
+    skStringView peekNext() const
+    {
+        return m_token;
+    }
+
+    skStringView getNext()
+    {
+        const skStringView token = m_token;
+        advance();
+        return token;
+    }
+
+    // Starts over from the beginning of the input.
+    void reset();
+
+    // Appends every token of input to dest.
+    static void split(skArray<skStringView>& dest,
+                      const skStringView&    input,
+                      const skDelimiterSet&  delimiters,
+                      bool                   keepEmpty = false);
+};
+
+#endif  //_skStringTokenizer_h_
@@ -0,0 +1,91 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Utils/skStringView.h"
+#include <cstring>
+
+const SKsize skStringView::npos = SK_NPOS;
+
+SKsize skStringView::find(char ch, SKsize offs) const
+{
+    if (offs < m_size)
+    {
+        const SKsize pos = skChar::find(m_data + offs, m_size - offs, ch);
+        if (pos != npos)
+            return offs + pos;
+    }
+    return npos;
+}
+
+SKsize skStringView::find(const skStringView& str, SKsize offs) const
+{
+    if (offs > m_size || str.m_size > m_size - offs)
+        return npos;
+
+    const SKsize pos = skChar::find(m_data + offs, m_size - offs, str.m_data, str.m_size);
+    return pos != npos ? offs + pos : npos;
+}
+
+SKsize skStringView::rfind(char ch) const
+{
+    for (SKsize i = m_size; i > 0; --i)
+    {
+        if (m_data[i - 1] == ch)
+            return i - 1;
+    }
+    return npos;
+}
+
+bool skStringView::startsWith(const skStringView& str) const
+{
+    return str.m_size <= m_size && skChar::compare(m_data, str.m_data, str.m_size) == 0;
+}
+
+bool skStringView::endsWith(const skStringView& str) const
+{
+    return str.m_size <= m_size && skChar::compare(m_data + (m_size - str.m_size), str.m_data, str.m_size) == 0;
+}
+
+int skStringView::compare(const skStringView& rhs) const
+{
+    const int result = skChar::compare(m_data, rhs.m_data, skMin(m_size, rhs.m_size));
+    if (result != 0)
+        return result;
+
+    if (m_size == rhs.m_size)
+        return 0;
+    return m_size < rhs.m_size ? -1 : 1;
+}
+
+int skStringView::compareNoCase(const skStringView& rhs) const
+{
+    const int result = skChar::compareNoCase(m_data, rhs.m_data, skMin(m_size, rhs.m_size));
+    if (result != 0)
+        return result;
+
+    if (m_size == rhs.m_size)
+        return 0;
+    return m_size < rhs.m_size ? -1 : 1;
+}
@@ -0,0 +1,226 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skStringView_h_
+#define _skStringView_h_
+
+#include "Utils/skChar.h"
+#include "Utils/skHash.h"
+#include "Utils/skMinMax.h"
+#include "Utils/skTraits.h"
+
+// A read only reference to a range of characters that does not own them
+// and is not necessarily NUL terminated. The referenced memory has to
+// outlive the view.
+class skStringView
+{
+public:
+    SK_DECLARE_TYPE(char)
+
+    static const SKsize npos;
+
+private:
+    ConstPointerType m_data;
+    SKsize           m_size;
+
+public:
+    skStringView() :
+        m_data(nullptr),
+        m_size(0)
+    {
+    }
+
+    skStringView(ConstPointerType str) :
+        m_data(str),
+        m_size(skChar::length(str))
+    {
+    }
+
+    skStringView(ConstPointerType str, SKsize len) :
+        m_data(str),
+        m_size(str ? len : 0)
+    {
+    }
+
+    ConstPointerType ptr() const
+    {
+        return m_data;
+    }
+
+    SKsize size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    char operator[](const SKsize idx) const
+    {
+        return idx < m_size ? m_data[idx] : '\0';
+    }
+
+    char at(const SKsize idx) const
+    {
+        SK_ASSERT(idx != npos);
+        return idx < m_size ? m_data[idx] : '\0';
+    }
+
+    char front() const
+    {
+        return at(0);
+    }
+
+    char back() const
+    {
+        return m_size > 0 ? m_data[m_size - 1] : '\0';
+    }
+
+    // Returns at most nr characters starting at pos. A nr of npos
+    // extends to the end of the view.
+    skStringView substr(SKsize pos, SKsize nr = npos) const
+    {
+        if (pos >= m_size)
+            return skStringView();
+        if (nr > m_size - pos)
+            nr = m_size - pos;
+        return skStringView(m_data + pos, nr);
+    }
+
+    void removePrefix(SKsize nr)
+    {
+        if (nr > m_size)
+            nr = m_size;
+        m_data += nr;
+        m_size -= nr;
+    }
+
+    void removeSuffix(SKsize nr)
+    {
+        m_size -= nr > m_size ? m_size : nr;
+    }
+
+    SKsize find(char ch, SKsize offs = 0) const;
+
+    SKsize find(const skStringView& str, SKsize offs = 0) const;
+
+    SKsize rfind(char ch) const;
+
+    bool startsWith(const skStringView& str) const;
+
+    bool endsWith(const skStringView& str) const;
+
+    // Byte-wise ordering; returns <0, 0 or >0.
+    int compare(const skStringView& rhs) const;
+
+    bool equals(const skStringView& rhs) const
+    {
+        return m_size == rhs.m_size && skChar::compare(m_data, rhs.m_data, m_size) == 0;
+    }
+
+    // Like compare, with ASCII letters folded to lower case.
+    int compareNoCase(const skStringView& rhs) const;
+
+    bool equalsNoCase(const skStringView& rhs) const
+    {
+        return m_size == rhs.m_size && skChar::compareNoCase(m_data, rhs.m_data, m_size) == 0;
+    }
+
+    bool operator==(const skStringView& rhs) const
+    {
+        return equals(rhs);
+    }
+
+    bool operator!=(const skStringView& rhs) const
+    {
+        return !equals(rhs);
+    }
+
+    bool operator<(const skStringView& rhs) const
+    {
+        return compare(rhs) < 0;
+    }
+
+    SKhash hash() const
+    {
+        return skHash(m_data, m_size);
+    }
+
+    bool toBoolean() const
+    {
+        return skChar::toBool(*this);
+    }
+
+    SKint16 toInt16(SKint16 def = -1) const
+    {
+        return skChar::toInt16(*this, def);
+    }
+
+    SKint32 toInt32(SKint32 def = -1) const
+    {
+        return skChar::toInt32(*this, def);
+    }
+
+    SKint64 toInt64(SKint64 def = -1) const
+    {
+        return skChar::toInt64(*this, def);
+    }
+
+    SKuint16 toUint16(SKuint16 def = SK_NPOS16) const
+    {
+        return skChar::toUint16(*this, def);
+    }
+
+    SKuint32 toUint32(SKuint32 def = SK_NPOS32) const
+    {
+        return skChar::toUint32(*this, def);
+    }
+
+    SKuint64 toUint64(SKuint64 def = (SKuint64)-1) const
+    {
+        return skChar::toUint64(*this, def);
+    }
+
+    float toFloat(float def = 0.f) const
+    {
+        return skChar::toFloat(*this, def);
+    }
+
+    double toDouble(double def = 0.0) const
+    {
+        return skChar::toDouble(*this, def);
+    }
+};
+
+// Hashes to the same value as an skString or const char* with the same
+// characters.
+inline SKhash skHash(const skStringView& key)
+{
+    return key.hash();
+}
+
+#endif  //_skStringView_h_
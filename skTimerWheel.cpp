@@ -0,0 +1,273 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skTimerWheel.h"
+
+const skTimerWheel::Handle skTimerWheel::InvalidHandle = (skTimerWheel::Handle)-1;
+
+skTimerWheel::skTimerWheel(SKuint32 resolution) :
+    m_free(nullptr),
+    m_size(0),
+    m_now(0),
+    m_resolution(resolution > 0 ? resolution : 1)
+{
+    for (SKuint32 l = 0; l < Levels; ++l)
+    {
+        for (SKuint32 s = 0; s < Slots; ++s)
+            initList(&m_wheels[l][s]);
+    }
+}
+
+skTimerWheel::~skTimerWheel()
+{
+    for (SKuint32 i = 0; i < m_blocks.size(); ++i)
+        delete[] m_blocks[i];
+}
+
+void skTimerWheel::clear()
+{
+    for (SKuint32 l = 0; l < Levels; ++l)
+    {
+        for (SKuint32 s = 0; s < Slots; ++s)
+        {
+            Link* head = &m_wheels[l][s];
+            while (head->next != head)
+            {
+                Node* node = static_cast<Node*>(head->next);
+                unlink(node);
+                release(node);
+            }
+        }
+    }
+    m_size = 0;
+}
+
+skTimerWheel::Handle skTimerWheel::schedule(SKuint64 delay, const Callback& callback, void* userData)
+{
+    const SKuint64 range = ((SKuint64)1 << (Bits * Levels)) - 1;
+
+    Node* node     = acquire();
+    node->expires  = m_now + skMin<SKuint64>(delay, range);
+    node->callback = callback;
+    node->userData = userData;
+    node->active   = true;
+
+    place(node);
+    ++m_size;
+    return (Handle)node->generation << 32 | node->index;
+}
+
+bool skTimerWheel::cancel(Handle handle)
+{
+    Node* node = lookup(handle);
+    if (!node)
+        return false;
+
+    unlink(node);
+    release(node);
+    --m_size;
+    return true;
+}
+
+bool skTimerWheel::isActive(Handle handle) const
+{
+    return lookup(handle) != nullptr;
+}
+
+SKsize skTimerWheel::advance(SKuint64 ticks)
+{
+    SKsize fired = 0;
+    while (ticks-- > 0)
+        fired += step();
+    return fired;
+}
+
+SKsize skTimerWheel::update()
+{
+    const SKuint64 target = (SKuint64)m_timer.getMilliseconds() / m_resolution;
+    return target > m_now ? advance(target - m_now) : 0;
+}
+
+skTimerWheel::Node* skTimerWheel::acquire()
+{
+    if (!m_free)
+    {
+        const SKuint32 base  = m_blocks.size() << BlockBits;
+        Node*          block = new Node[BlockSize];
+        m_blocks.push_back(block);
+
+        for (SKuint32 i = BlockSize; i > 0; --i)
+        {
+            Node* node       = &block[i - 1];
+            node->index      = base + i - 1;
+            node->generation = 0;
+            node->active     = false;
+            node->next       = m_free;
+            m_free           = node;
+        }
+    }
+
+    Node* node = m_free;
+    m_free     = static_cast<Node*>(node->next);
+    return node;
+}
+
+void skTimerWheel::release(Node* node)
+{
+    node->active   = false;
+    node->callback = Callback();
+    node->userData = nullptr;
+    ++node->generation;
+
+    node->next = m_free;
+    node->prev = nullptr;
+    m_free     = node;
+}
+
+skTimerWheel::Node* skTimerWheel::lookup(Handle handle) const
+{
+    if (handle == InvalidHandle)
+        return nullptr;
+
+    const SKuint32 index = (SKuint32)(handle & 0xFFFFFFFF);
+    const SKuint32 block = index >> BlockBits;
+    if (block >= m_blocks.size())
+        return nullptr;
+
+    Node* node = &m_blocks[block][index & (BlockSize - 1)];
+    if (!node->active || node->generation != (SKuint32)(handle >> 32))
+        return nullptr;
+    return node;
+}
+
+void skTimerWheel::place(Node* node)
+{
+    // Placement is relative to the next tick that will be processed.
+    const SKuint64 base    = m_now + 1;
+    const SKuint64 expires = node->expires > base ? node->expires : base;
+    const SKuint64 delta   = expires - base;
+
+    Link* slot;
+    if (delta < ((SKuint64)1 << Bits))
+        slot = &m_wheels[0][expires & Mask];
+    else if (delta < ((SKuint64)1 << 2 * Bits))
+        slot = &m_wheels[1][(expires >> Bits) & Mask];
+    else if (delta < ((SKuint64)1 << 3 * Bits))
+        slot = &m_wheels[2][(expires >> 2 * Bits) & Mask];
+    else
+        slot = &m_wheels[3][(expires >> 3 * Bits) & Mask];
+
+    pushBack(slot, node);
+}
+
+void skTimerWheel::cascade(SKuint32 level, SKuint64 tick)
+{
+    Link  list;
+    Link* head = &m_wheels[level][(tick >> level * Bits) & Mask];
+
+    if (head->next == head)
+        return;
+
+    // Detach the slot first, since re-placing may target the same slot.
+    list.next       = head->next;
+    list.prev       = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    initList(head);
+
+    while (list.next != &list)
+    {
+        Node* node = static_cast<Node*>(list.next);
+        unlink(node);
+        place(node);
+    }
+}
+
+SKsize skTimerWheel::step()
+{
+    const SKuint64 tick  = m_now + 1;
+    const SKuint32 index = (SKuint32)(tick & Mask);
+    if (index == 0)
+    {
+        for (SKuint32 level = 1; level < Levels; ++level)
+        {
+            cascade(level, tick);
+            if (((tick >> level * Bits) & Mask) != 0)
+                break;
+        }
+    }
+
+    Link  list;
+    Link* head = &m_wheels[0][index];
+    m_now      = tick;
+
+    if (head->next == head)
+        return 0;
+
+    list.next       = head->next;
+    list.prev       = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    initList(head);
+
+    // Callbacks may schedule or cancel timers, including ones in this list.
+    SKsize fired = 0;
+    while (list.next != &list)
+    {
+        Node* node = static_cast<Node*>(list.next);
+        unlink(node);
+
+        Callback callback = node->callback;
+        void*    userData = node->userData;
+        release(node);
+        --m_size;
+
+        callback(userData);
+        ++fired;
+    }
+    return fired;
+}
+
+void skTimerWheel::initList(Link* head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+void skTimerWheel::unlink(Link* link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next       = link;
+    link->prev       = link;
+}
+
+void skTimerWheel::pushBack(Link* head, Link* link)
+{
+    link->prev       = head->prev;
+    link->next       = head;
+    head->prev->next = link;
+    head->prev       = link;
+}
@@ -0,0 +1,146 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skTimerWheel_h_
+#define _skTimerWheel_h_
+
+#include "skArray.h"
+#include "skDelegate.h"
+#include "skTimer.h"
+
+// Hierarchical timing wheel.
+//
+// Timers are kept in four wheels of 256 slots each. The first wheel
+// holds timers that expire within 256 ticks; each following wheel
+// covers 256 times the range of the previous one. When the first wheel
+// wraps, the matching slot of the next wheel is redistributed (cascaded)
+// into the lower wheels. Scheduling and canceling are O(1), and a timer
+// is cascaded at most three times before it expires.
+//
+// Timer nodes come from an internal pool, so scheduling does not
+// allocate once the pool has grown to the number of live timers.
+class skTimerWheel
+{
+public:
+    typedef skSimpleDelegate<void, void*> Callback;
+    typedef SKuint64                      Handle;
+
+    static const Handle InvalidHandle;
+
+    // The resolution is the number of milliseconds in one tick.
+    explicit skTimerWheel(SKuint32 resolution = 1);
+    ~skTimerWheel();
+
+    // Schedules callback(userData) to run once delay ticks have elapsed.
+    // A delay of zero runs on the next tick.
+    // Delays beyond the range of the wheels are clamped.
+    Handle schedule(SKuint64 delay, const Callback& callback, void* userData = nullptr);
+
+    // Returns false if the timer already expired or was canceled.
+    bool cancel(Handle handle);
+
+    bool isActive(Handle handle) const;
+
+    // Advances the wheel by the number of ticks, firing expired timers.
+    // Returns the number of callbacks that were invoked.
+    SKsize advance(SKuint64 ticks);
+
+    // Advances the wheel to the elapsed time of the internal skTimer.
+    SKsize update();
+
+    void clear();
+
+    SKsize size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    // The number of ticks processed so far.
+    SKuint64 now() const
+    {
+        return m_now;
+    }
+
+    SKuint32 resolution() const
+    {
+        return m_resolution;
+    }
+
+private:
+    enum
+    {
+        Bits      = 8,
+        Slots     = 1 << Bits,
+        Mask      = Slots - 1,
+        Levels    = 4,
+        BlockBits = 12,
+        BlockSize = 1 << BlockBits,
+    };
+
+    struct Link
+    {
+        Link* next;
+        Link* prev;
+    };
+
+    struct Node : Link
+    {
+        SKuint64 expires;
+        Callback callback;
+        void*    userData;
+        SKuint32 index;
+        SKuint32 generation;
+        bool     active;
+    };
+
+    Link            m_wheels[Levels][Slots];
+    skArray<Node*>  m_blocks;
+    Node*           m_free;
+    SKsize          m_size;
+    SKuint64        m_now;
+    SKuint32        m_resolution;
+    skTimer         m_timer;
+
+    Node* acquire();
+    void  release(Node* node);
+    Node* lookup(Handle handle) const;
+    void  place(Node* node);
+    void  cascade(SKuint32 level, SKuint64 tick);
+    SKsize step();
+
+    static void initList(Link* head);
+    static void unlink(Link* link);
+    static void pushBack(Link* head, Link* link);
+
+    skTimerWheel(const skTimerWheel&)            = delete;
+    skTimerWheel& operator=(const skTimerWheel&) = delete;
+};
+
+#endif  //_skTimerWheel_h_
@@ -67,17 +67,66 @@ public:                                                                 \
     {                                                                   \
         SortType srt(cmp);                                              \
         srt.sort((*this));                                              \
+    }                                                                   \
+    template <typename Compare>                                         \
+    void sort(Compare cmp)                                              \
+    {                                                                   \
+        SortType::sort((*this), cmp);                                   \
     }
 
 
-#define SK_IMPLEMENT_QSORT(T, SELF, Size)                                \
-public:                                                                  \
-    typedef skQSort<T, SELF, Size> SortType;                             \
-    void                           sort(typename SortType::Function cmp) \
-    {                                                                    \
-        SortType srt(cmp);                                               \
-        srt.sort((*this));                                               \
+// The sort, stableSort, partialSort and nthElement members shared by
+// containers with contiguous storage. Expects SortType to be declared.
+#define SK_IMPLEMENT_CONTIGUOUS_SORT(T, Size)                                \
+    void sort(typename SortType::Function cmp)                               \
+    {                                                                        \
+        SortType srt(cmp);                                                   \
+        srt.sort((*this));                                                   \
+    }                                                                        \
+    template <typename Compare>                                              \
+    void sort(Compare cmp)                                                   \
+    {                                                                        \
+        SortType::sort((*this), cmp);                                        \
+    }                                                                        \
+    void stableSort(typename SortType::Function cmp)                         \
+    {                                                                        \
+        if (cmp)                                                             \
+            SortType::stableSort((*this), skFunctionCompare<T>(cmp));        \
+    }                                                                        \
+    template <typename Compare = skLess<T> >                                 \
+    void stableSort(Compare cmp = Compare())                                 \
+    {                                                                        \
+        SortType::stableSort((*this), cmp);                                  \
+    }                                                                        \
+    void partialSort(Size k, typename SortType::Function cmp)                \
+    {                                                                        \
+        if (cmp)                                                             \
+            SortType::partialSort((*this), k, skFunctionCompare<T>(cmp));    \
+    }                                                                        \
+    template <typename Compare = skLess<T> >                                 \
+    void partialSort(Size k, Compare cmp = Compare())                        \
+    {                                                                        \
+        SortType::partialSort((*this), k, cmp);                              \
+    }                                                                        \
+    void nthElement(Size k, typename SortType::Function cmp)                 \
+    {                                                                        \
+        if (cmp)                                                             \
+            SortType::nthElement((*this), k, skFunctionCompare<T>(cmp));     \
+    }                                                                        \
+    template <typename Compare = skLess<T> >                                 \
+    void nthElement(Size k, Compare cmp = Compare())                         \
+    {                                                                        \
+        SortType::nthElement((*this), k, cmp);                               \
     }
 
+#define SK_IMPLEMENT_QSORT(T, SELF, Size)                                    \
+public:                                                                      \
+    typedef skQSort<T, SELF, Size> SortType;                                 \
+    SK_IMPLEMENT_CONTIGUOUS_SORT(T, Size)
+
+#define SK_IMPLEMENT_NETWORK_SORT(T, SELF, Size, L)                          \
+public:                                                                      \
+    typedef skNetworkSort<T, SELF, Size, L> SortType;                        \
+    SK_IMPLEMENT_CONTIGUOUS_SORT(T, Size)
 
 #endif  //_skTraits_h_
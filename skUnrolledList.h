@@ -0,0 +1,584 @@
+/*
+-------------------------------------------------------------------------------
+
+    Copyright (c) Charles Carley.
+
+    Contributor(s): none yet.
+
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skUnrolledList_h_
+#define _skUnrolledList_h_
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "skAllocator.h"
+
+template <typename T>
+class skUnrolledListIterator
+{
+public:
+    typedef typename T::NodePointerType    NodePointerType;
+    typedef typename T::ReferenceType      ReferenceType;
+    typedef typename T::ConstReferenceType ConstReferenceType;
+
+private:
+    friend T;
+
+    mutable NodePointerType m_node;
+    mutable SKuint32        m_index;
+
+public:
+    skUnrolledListIterator() :
+        m_node(nullptr),
+        m_index(0)
+    {
+    }
+
+    skUnrolledListIterator(NodePointerType node, SKuint32 index) :
+        m_node(node),
+        m_index(index)
+    {
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_node != nullptr;
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        if (++m_index >= m_node->m_count)
+        {
+            m_node  = m_node->m_next;
+            m_index = 0;
+        }
+    }
+
+    ReferenceType getNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ReferenceType ret = m_node->at(m_index);
+        next();
+        return ret;
+    }
+
+    ConstReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ConstReferenceType ret = m_node->at(m_index);
+        next();
+        return ret;
+    }
+
+    ReferenceType peekNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_node->at(m_index);
+    }
+
+    ConstReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_node->at(m_index);
+    }
+};
+
+template <typename T>
+class skUnrolledListReverseIterator
+{
+public:
+    typedef typename T::NodePointerType    NodePointerType;
+    typedef typename T::ReferenceType      ReferenceType;
+    typedef typename T::ConstReferenceType ConstReferenceType;
+
+private:
+    mutable NodePointerType m_node;
+    mutable SKuint32        m_index;
+
+public:
+    skUnrolledListReverseIterator() :
+        m_node(nullptr),
+        m_index(0)
+    {
+    }
+
+    skUnrolledListReverseIterator(NodePointerType node, SKuint32 index) :
+        m_node(node),
+        m_index(index)
+    {
+    }
+
+    bool hasMoreElements(void) const
+    {
+        return m_node != nullptr;
+    }
+
+    void next(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        if (m_index == 0)
+        {
+            m_node  = m_node->m_prev;
+            m_index = m_node ? m_node->m_count - 1 : 0;
+        }
+        else
+            --m_index;
+    }
+
+    ReferenceType getNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ReferenceType ret = m_node->at(m_index);
+        next();
+        return ret;
+    }
+
+    ConstReferenceType getNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        ConstReferenceType ret = m_node->at(m_index);
+        next();
+        return ret;
+    }
+
+    ReferenceType peekNext(void)
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_node->at(m_index);
+    }
+
+    ConstReferenceType peekNext(void) const
+    {
+        SK_ITER_DEBUG(hasMoreElements());
+        return m_node->at(m_index);
+    }
+};
+
+// Doubly linked list that stores up to K elements per node.
+//
+// Traversal touches one allocation per K elements instead of one per
+// element, and insert or erase at an iterator shifts at most K elements.
+// Nodes are split when an insert lands in a full node and are merged with
+// their successor once the pair fits in half a node.
+template <typename T, const SKuint32 K = 16>
+class skUnrolledList
+{
+public:
+    SK_DECLARE_TYPE(T)
+
+    typedef skUnrolledList<T, K> SelfType;
+
+    class Node
+    {
+    public:
+        Node() :
+            m_next(nullptr),
+            m_prev(nullptr),
+            m_count(0)
+        {
+        }
+
+        ReferenceType at(SKuint32 i)
+        {
+            return reinterpret_cast<PointerType>(m_data)[i];
+        }
+
+        PointerType data(void)
+        {
+            return reinterpret_cast<PointerType>(m_data);
+        }
+
+        Node* getNext(void)
+        {
+            return m_next;
+        }
+
+        Node* getPrev(void)
+        {
+            return m_prev;
+        }
+
+        SKuint32 getCount(void) const
+        {
+            return m_count;
+        }
+
+    private:
+        friend class skUnrolledList;
+        friend class skUnrolledListIterator<SelfType>;
+        friend class skUnrolledListReverseIterator<SelfType>;
+
+        Node*    m_next;
+        Node*    m_prev;
+        SKuint32 m_count;
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_data[K];
+    };
+
+    typedef Node*                                   NodePointerType;
+    typedef skUnrolledListIterator<SelfType>        Iterator;
+    typedef const skUnrolledListIterator<SelfType>  ConstIterator;
+    typedef skUnrolledListReverseIterator<SelfType> ReverseIterator;
+    typedef const ReverseIterator                   ConstReverseIterator;
+
+    static_assert(K >= 2, "skUnrolledList needs at least two elements per node");
+
+private:
+    Node*    m_first;
+    Node*    m_last;
+    SKuint32 m_size;
+    SKuint32 m_nodes;
+
+public:
+    skUnrolledList() :
+        m_first(nullptr),
+        m_last(nullptr),
+        m_size(0),
+        m_nodes(0)
+    {
+    }
+
+    skUnrolledList(const SelfType& rhs) :
+        m_first(nullptr),
+        m_last(nullptr),
+        m_size(0),
+        m_nodes(0)
+    {
+        replicate(rhs);
+    }
+
+    ~skUnrolledList()
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        Node* node = m_first;
+        while (node)
+        {
+            Node* next = node->m_next;
+
+            PointerType data = node->data();
+            for (SKuint32 i = 0; i < node->m_count; ++i)
+                data[i].~T();
+
+            delete node;
+            node = next;
+        }
+
+        m_first = m_last = nullptr;
+        m_size = m_nodes = 0;
+    }
+
+    void push_back(ConstReferenceType v)
+    {
+        if (!m_last || m_last->m_count >= K)
+            linkAfter(m_last, new Node());
+
+        new (m_last->data() + m_last->m_count) T(v);
+        ++m_last->m_count;
+        ++m_size;
+    }
+
+    void push_front(ConstReferenceType v)
+    {
+        if (!m_first || m_first->m_count >= K)
+            linkAfter(nullptr, new Node());
+
+        insertAt(m_first, 0, v);
+    }
+
+    void pop_back(void)
+    {
+        SK_ASSERT(m_last);
+        if (m_last)
+            eraseAt(m_last, m_last->m_count - 1);
+    }
+
+    void pop_front(void)
+    {
+        SK_ASSERT(m_first);
+        if (m_first)
+            eraseAt(m_first, 0);
+    }
+
+    // Inserts v in front of the element at pos, or at the back if pos has
+    // no more elements. Returns an iterator to the new element.
+    Iterator insert(const Iterator& pos, ConstReferenceType v)
+    {
+        Node*    node  = pos.m_node;
+        SKuint32 index = pos.m_index;
+
+        if (!node)
+        {
+            push_back(v);
+            return Iterator(m_last, m_last->m_count - 1);
+        }
+
+        if (node->m_count >= K)
+        {
+            split(node);
+            if (index > node->m_count)
+            {
+                index -= node->m_count;
+                node = node->m_next;
+            }
+        }
+
+        insertAt(node, index, v);
+        return Iterator(node, index);
+    }
+
+    // Removes the element at pos. Returns an iterator to the element that
+    // followed it.
+    Iterator erase(const Iterator& pos)
+    {
+        SK_ASSERT(pos.hasMoreElements());
+        if (!pos.m_node)
+            return Iterator();
+        return eraseAt(pos.m_node, pos.m_index);
+    }
+
+    void erase(ConstReferenceType v)
+    {
+        Iterator it = find(v);
+        if (it.hasMoreElements())
+            erase(it);
+    }
+
+    Iterator find(ConstReferenceType v)
+    {
+        for (Node* node = m_first; node; node = node->m_next)
+        {
+            PointerType data = node->data();
+            for (SKuint32 i = 0; i < node->m_count; ++i)
+            {
+                if (data[i] == v)
+                    return Iterator(node, i);
+            }
+        }
+        return Iterator();
+    }
+
+    // O(size / K)
+    ReferenceType at(SKuint32 index)
+    {
+        SK_ASSERT(index < m_size);
+
+        Node* node = m_first;
+        while (index >= node->m_count)
+        {
+            index -= node->m_count;
+            node = node->m_next;
+        }
+        return node->at(index);
+    }
+
+    ConstReferenceType at(SKuint32 index) const
+    {
+        return const_cast<SelfType*>(this)->at(index);
+    }
+
+    ReferenceType operator[](SKuint32 index)
+    {
+        return at(index);
+    }
+
+    ConstReferenceType operator[](SKuint32 index) const
+    {
+        return at(index);
+    }
+
+    ReferenceType front(void)
+    {
+        SK_ASSERT(m_first);
+        return m_first->at(0);
+    }
+
+    ReferenceType back(void)
+    {
+        SK_ASSERT(m_last);
+        return m_last->at(m_last->m_count - 1);
+    }
+
+    bool empty(void) const
+    {
+        return m_size == 0;
+    }
+
+    SKuint32 size(void) const
+    {
+        return m_size;
+    }
+
+    // The number of allocated nodes.
+    SKuint32 nodeCount(void) const
+    {
+        return m_nodes;
+    }
+
+    Iterator iterator(void)
+    {
+        return m_first ? Iterator(m_first, 0) : Iterator();
+    }
+
+    ReverseIterator reverseIterator(void)
+    {
+        return m_last ? ReverseIterator(m_last, m_last->m_count - 1) : ReverseIterator();
+    }
+
+    ConstIterator iterator(void) const
+    {
+        return m_first ? ConstIterator(m_first, 0) : ConstIterator();
+    }
+
+    ConstReverseIterator reverseIterator(void) const
+    {
+        return m_last ? ConstReverseIterator(m_last, m_last->m_count - 1) : ConstReverseIterator();
+    }
+
+    SelfType& operator=(const SelfType& rhs)
+    {
+        if (this != &rhs)
+            replicate(rhs);
+        return *this;
+    }
+
+private:
+    void replicate(const SelfType& rhs)
+    {
+        clear();
+        ConstIterator it = rhs.iterator();
+        while (it.hasMoreElements())
+            push_back(it.getNext());
+    }
+
+    // Links node after prev, or at the front when prev is null.
+    void linkAfter(Node* prev, Node* node)
+    {
+        node->m_prev = prev;
+        node->m_next = prev ? prev->m_next : m_first;
+
+        if (node->m_next)
+            node->m_next->m_prev = node;
+        else
+            m_last = node;
+
+        if (prev)
+            prev->m_next = node;
+        else
+            m_first = node;
+        ++m_nodes;
+    }
+
+    void unlink(Node* node)
+    {
+        if (node->m_prev)
+            node->m_prev->m_next = node->m_next;
+        else
+            m_first = node->m_next;
+
+        if (node->m_next)
+            node->m_next->m_prev = node->m_prev;
+        else
+            m_last = node->m_prev;
+
+        delete node;
+        --m_nodes;
+    }
+
+    // Moves the upper half of a full node into a new successor.
+    void split(Node* node)
+    {
+        Node* upper = new Node();
+        linkAfter(node, upper);
+
+        const SKuint32 half = node->m_count / 2;
+
+        PointerType src = node->data();
+        PointerType dst = upper->data();
+        for (SKuint32 i = half; i < node->m_count; ++i)
+        {
+            new (dst + upper->m_count++) T(std::move(src[i]));
+            src[i].~T();
+        }
+        node->m_count = half;
+    }
+
+    void insertAt(Node* node, SKuint32 index, ConstReferenceType v)
+    {
+        SK_ASSERT(node->m_count < K && index <= node->m_count);
+
+        PointerType data = node->data();
+        if (index == node->m_count)
+            new (data + index) T(v);
+        else
+        {
+            new (data + node->m_count) T(std::move(data[node->m_count - 1]));
+            for (SKuint32 i = node->m_count - 1; i > index; --i)
+                data[i] = std::move(data[i - 1]);
+            data[index] = v;
+        }
+
+        ++node->m_count;
+        ++m_size;
+    }
+
+    Iterator eraseAt(Node* node, SKuint32 index)
+    {
+        SK_ASSERT(index < node->m_count);
+
+        PointerType data = node->data();
+        for (SKuint32 i = index + 1; i < node->m_count; ++i)
+            data[i - 1] = std::move(data[i]);
+
+        data[--node->m_count].~T();
+        --m_size;
+
+        if (node->m_count == 0)
+        {
+            Node* next = node->m_next;
+            unlink(node);
+            return Iterator(next, 0);
+        }
+
+        Node* next = node->m_next;
+        if (next && node->m_count + next->m_count <= K / 2)
+        {
+            PointerType src = next->data();
+            for (SKuint32 i = 0; i < next->m_count; ++i)
+            {
+                new (data + node->m_count++) T(std::move(src[i]));
+                src[i].~T();
+            }
+            next->m_count = 0;
+            unlink(next);
+        }
+
+        if (index < node->m_count)
+            return Iterator(node, index);
+        return Iterator(node->m_next, 0);
+    }
+};
+
+#endif  //_skUnrolledList_h_